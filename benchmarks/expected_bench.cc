@@ -0,0 +1,530 @@
+// error handling on request path, small_vectors expected monadic chains, expected<void, E>, deep propagation and large
+// values against std::expected, exceptions and std::error_code, happy path and error path timings and code size of
+// every variant, usage: expected_bench [count]
+#define SMALL_VECTORS_ENABLE_CUSTOM_EXCPECTED 1
+#include <small_vectors/utils/expected.h>
+#include <small_vectors/small_vector.h>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <span>
+#include <system_error>
+#if __has_include(<expected>)
+#include <expected>
+#endif
+
+#if defined(__cpp_lib_expected) && __cpp_lib_expected >= 202211L
+#define EXPECTED_BENCH_STD 1
+#endif
+
+// every variant is kept out of line in own ELF section so its code size can be read from linker provided bounds
+#if defined(__ELF__) && (defined(__GNUC__) || defined(__clang__))
+#define EXPECTED_BENCH_CODE_SIZE 1
+#define EXPECTED_BENCH_CODE(group) [[gnu::noinline, gnu::section("expected_bench_" #group)]]
+#define EXPECTED_BENCH_SECTION(group)                                                                                  \
+  extern "C" char __start_expected_bench_##group[];                                                                   \
+  extern "C" char __stop_expected_bench_##group[];
+#elif defined(_MSC_VER)
+#define EXPECTED_BENCH_CODE(group) __declspec(noinline)
+#define EXPECTED_BENCH_SECTION(group)
+#else
+#define EXPECTED_BENCH_CODE(group) [[gnu::noinline]]
+#define EXPECTED_BENCH_SECTION(group)
+#endif
+
+namespace
+  {
+enum struct request_error : uint8_t
+  {
+    empty = 1,
+    malformed,
+    out_of_range
+  };
+
+inline constexpr uint32_t value_limit{1u << 30u};
+inline constexpr uint32_t malformed_mask{0xffu};
+inline constexpr unsigned propagation_depth{16u};
+
+/// returned by value through every stage of large value scenario
+using payload = std::array<uint64_t, 16>;
+
+inline auto fill_payload(uint32_t value) noexcept -> payload
+  {
+  payload result;
+  for(std::size_t ix{}; ix != result.size(); ++ix)
+    result[ix] = value + ix;
+  return result;
+  }
+
+inline auto mix_payload(payload const & value) noexcept -> payload
+  {
+  payload result;
+  for(std::size_t ix{}; ix != value.size(); ++ix)
+    result[ix] = value[ix] * 3u + 1u;
+  return result;
+  }
+
+using inputs_t = std::span<uint32_t const>;
+  }  // namespace
+
+// stages are out of line so results cross real call boundary and calling convention of result type matters,
+// decode fails for 0, validate for values past limit and check for values with all low bits set
+#define EXPECTED_BENCH_MONADIC_GROUP(group, expected_ns)                                                               \
+  EXPECTED_BENCH_SECTION(group)                                                                                        \
+  namespace group                                                                                                      \
+    {                                                                                                                  \
+  template<typename value_type>                                                                                        \
+  using result = expected_ns::expected<value_type, request_error>;                                                   \
+  using unexpected = expected_ns::unexpected<request_error>;                                                          \
+                                                                                                                       \
+  EXPECTED_BENCH_CODE(group) auto decode(uint32_t raw) noexcept -> result<uint32_t>                                    \
+    {                                                                                                                  \
+    if(raw == 0u) [[unlikely]]                                                                                         \
+      return unexpected{request_error::empty};                                                                         \
+    return raw - 1u;                                                                                                   \
+    }                                                                                                                  \
+                                                                                                                       \
+  EXPECTED_BENCH_CODE(group) auto validate(uint32_t value) noexcept -> result<uint32_t>                                \
+    {                                                                                                                  \
+    if(value >= value_limit) [[unlikely]]                                                                              \
+      return unexpected{request_error::out_of_range};                                                                  \
+    return value;                                                                                                      \
+    }                                                                                                                  \
+                                                                                                                       \
+  EXPECTED_BENCH_CODE(group) auto check(uint32_t value) noexcept -> result<void>                                       \
+    {                                                                                                                  \
+    if((value & malformed_mask) == malformed_mask) [[unlikely]]                                                        \
+      return unexpected{request_error::malformed};                                                                     \
+    return {};                                                                                                         \
+    }                                                                                                                  \
+                                                                                                                       \
+  EXPECTED_BENCH_CODE(group) auto chain(uint32_t raw) noexcept -> result<uint32_t>                                     \
+    {                                                                                                                  \
+    return decode(raw).and_then(validate).and_then(                                                                    \
+      [](uint32_t value) noexcept { return check(value).transform([value] noexcept { return value * 3u + 1u; }); }     \
+    );                                                                                                                 \
+    }                                                                                                                  \
+                                                                                                                       \
+  EXPECTED_BENCH_CODE(group) auto run_chain(inputs_t inputs) noexcept -> uint64_t                                      \
+    {                                                                                                                  \
+    uint64_t sum{};                                                                                                    \
+    for(uint32_t raw: inputs)                                                                                          \
+      sum += chain(raw).value_or(1u);                                                                                  \
+    return sum;                                                                                                        \
+    }                                                                                                                  \
+                                                                                                                       \
+  EXPECTED_BENCH_CODE(group) auto run_void(inputs_t inputs) noexcept -> uint64_t                                       \
+    {                                                                                                                  \
+    uint64_t failures{};                                                                                               \
+    for(uint32_t raw: inputs)                                                                                          \
+      {                                                                                                                \
+      uint32_t const value{raw - 1u};                                                                                  \
+      auto const status{check(value ^ 1u).and_then([value] noexcept { return check(value ^ 2u); }).and_then(           \
+        [value] noexcept { return check(value); }                                                                      \
+      )};                                                                                                              \
+      failures += status.has_value() ? 0u : 1u;                                                                        \
+      }                                                                                                                \
+    return failures;                                                                                                   \
+    }                                                                                                                  \
+                                                                                                                       \
+  EXPECTED_BENCH_CODE(group) auto propagate(uint32_t raw, unsigned depth) noexcept -> result<uint32_t>                 \
+    {                                                                                                                  \
+    if(depth == 0u)                                                                                                    \
+      return chain(raw);                                                                                               \
+    auto const inner{propagate(raw, depth - 1u)};                                                                      \
+    if(!inner) [[unlikely]]                                                                                            \
+      return unexpected{inner.error()};                                                                                \
+    return *inner + depth;                                                                                             \
+    }                                                                                                                  \
+                                                                                                                       \
+  EXPECTED_BENCH_CODE(group) auto run_deep(inputs_t inputs) noexcept -> uint64_t                                       \
+    {                                                                                                                  \
+    uint64_t sum{};                                                                                                    \
+    for(uint32_t raw: inputs)                                                                                          \
+      sum += propagate(raw, propagation_depth).value_or(1u);                                                           \
+    return sum;                                                                                                        \
+    }                                                                                                                  \
+                                                                                                                       \
+  EXPECTED_BENCH_CODE(group) auto build(uint32_t raw) noexcept -> result<payload>                                      \
+    {                                                                                                                  \
+    return chain(raw).transform(fill_payload);                                                                         \
+    }                                                                                                                  \
+                                                                                                                       \
+  EXPECTED_BENCH_CODE(group) auto run_large(inputs_t inputs) noexcept -> uint64_t                                      \
+    {                                                                                                                  \
+    uint64_t sum{};                                                                                                    \
+    for(uint32_t raw: inputs)                                                                                          \
+      {                                                                                                                \
+      auto const value{build(raw).transform(mix_payload)};                                                             \
+      sum += value ? (*value)[7] : 1u;                                                                                 \
+      }                                                                                                                \
+    return sum;                                                                                                        \
+    }                                                                                                                  \
+    }
+
+EXPECTED_BENCH_MONADIC_GROUP(small_vectors_expected, cxx23)
+#if defined(EXPECTED_BENCH_STD)
+EXPECTED_BENCH_MONADIC_GROUP(std_expected, std)
+#endif
+
+EXPECTED_BENCH_SECTION(exceptions)
+
+namespace exceptions
+  {
+struct request_failure : std::exception
+  {
+  request_error code;
+
+  explicit request_failure(request_error c) noexcept : code{c} {}
+
+  [[nodiscard]]
+  auto what() const noexcept -> char const * override
+    {
+    return "request failure";
+    }
+  };
+
+EXPECTED_BENCH_CODE(exceptions) auto decode(uint32_t raw) -> uint32_t
+  {
+  if(raw == 0u) [[unlikely]]
+    throw request_failure{request_error::empty};
+  return raw - 1u;
+  }
+
+EXPECTED_BENCH_CODE(exceptions) auto validate(uint32_t value) -> uint32_t
+  {
+  if(value >= value_limit) [[unlikely]]
+    throw request_failure{request_error::out_of_range};
+  return value;
+  }
+
+EXPECTED_BENCH_CODE(exceptions) void check(uint32_t value)
+  {
+  if((value & malformed_mask) == malformed_mask) [[unlikely]]
+    throw request_failure{request_error::malformed};
+  }
+
+EXPECTED_BENCH_CODE(exceptions) auto chain(uint32_t raw) -> uint32_t
+  {
+  uint32_t const value{validate(decode(raw))};
+  check(value);
+  return value * 3u + 1u;
+  }
+
+EXPECTED_BENCH_CODE(exceptions) auto run_chain(inputs_t inputs) -> uint64_t
+  {
+  uint64_t sum{};
+  for(uint32_t raw: inputs)
+    try
+      {
+      sum += chain(raw);
+      }
+    catch(request_failure const &)
+      {
+      sum += 1u;
+      }
+  return sum;
+  }
+
+EXPECTED_BENCH_CODE(exceptions) auto run_void(inputs_t inputs) -> uint64_t
+  {
+  uint64_t failures{};
+  for(uint32_t raw: inputs)
+    try
+      {
+      uint32_t const value{raw - 1u};
+      check(value ^ 1u);
+      check(value ^ 2u);
+      check(value);
+      }
+    catch(request_failure const &)
+      {
+      ++failures;
+      }
+  return failures;
+  }
+
+EXPECTED_BENCH_CODE(exceptions) auto propagate(uint32_t raw, unsigned depth) -> uint32_t
+  {
+  if(depth == 0u)
+    return chain(raw);
+  return propagate(raw, depth - 1u) + depth;
+  }
+
+EXPECTED_BENCH_CODE(exceptions) auto run_deep(inputs_t inputs) -> uint64_t
+  {
+  uint64_t sum{};
+  for(uint32_t raw: inputs)
+    try
+      {
+      sum += propagate(raw, propagation_depth);
+      }
+    catch(request_failure const &)
+      {
+      sum += 1u;
+      }
+  return sum;
+  }
+
+EXPECTED_BENCH_CODE(exceptions) auto build(uint32_t raw) -> payload { return fill_payload(chain(raw)); }
+
+EXPECTED_BENCH_CODE(exceptions) auto run_large(inputs_t inputs) -> uint64_t
+  {
+  uint64_t sum{};
+  for(uint32_t raw: inputs)
+    try
+      {
+      sum += mix_payload(build(raw))[7];
+      }
+    catch(request_failure const &)
+      {
+      sum += 1u;
+      }
+  return sum;
+  }
+  }  // namespace exceptions
+
+EXPECTED_BENCH_SECTION(error_code)
+
+namespace error_code
+  {
+[[nodiscard]]
+inline auto make_error(request_error error) noexcept -> std::error_code
+  {
+  switch(error)
+    {
+    case request_error::empty:
+      return std::make_error_code(std::errc::invalid_argument);
+    case request_error::malformed:
+      return std::make_error_code(std::errc::bad_message);
+    case request_error::out_of_range:
+      break;
+    }
+  return std::make_error_code(std::errc::result_out_of_range);
+  }
+
+EXPECTED_BENCH_CODE(error_code) auto decode(uint32_t raw, std::error_code & ec) noexcept -> uint32_t
+  {
+  if(raw == 0u) [[unlikely]]
+    {
+    ec = make_error(request_error::empty);
+    return 0u;
+    }
+  return raw - 1u;
+  }
+
+EXPECTED_BENCH_CODE(error_code) auto validate(uint32_t value, std::error_code & ec) noexcept -> uint32_t
+  {
+  if(value >= value_limit) [[unlikely]]
+    ec = make_error(request_error::out_of_range);
+  return value;
+  }
+
+EXPECTED_BENCH_CODE(error_code) void check(uint32_t value, std::error_code & ec) noexcept
+  {
+  if((value & malformed_mask) == malformed_mask) [[unlikely]]
+    ec = make_error(request_error::malformed);
+  }
+
+EXPECTED_BENCH_CODE(error_code) auto chain(uint32_t raw, std::error_code & ec) noexcept -> uint32_t
+  {
+  uint32_t value{decode(raw, ec)};
+  if(ec)
+    return 0u;
+  value = validate(value, ec);
+  if(ec)
+    return 0u;
+  check(value, ec);
+  if(ec)
+    return 0u;
+  return value * 3u + 1u;
+  }
+
+EXPECTED_BENCH_CODE(error_code) auto run_chain(inputs_t inputs) noexcept -> uint64_t
+  {
+  uint64_t sum{};
+  for(uint32_t raw: inputs)
+    {
+    std::error_code ec;
+    uint32_t const value{chain(raw, ec)};
+    sum += ec ? 1u : value;
+    }
+  return sum;
+  }
+
+EXPECTED_BENCH_CODE(error_code) auto run_void(inputs_t inputs) noexcept -> uint64_t
+  {
+  uint64_t failures{};
+  for(uint32_t raw: inputs)
+    {
+    uint32_t const value{raw - 1u};
+    std::error_code ec;
+    check(value ^ 1u, ec);
+    if(!ec)
+      check(value ^ 2u, ec);
+    if(!ec)
+      check(value, ec);
+    failures += ec ? 1u : 0u;
+    }
+  return failures;
+  }
+
+EXPECTED_BENCH_CODE(error_code) auto propagate(uint32_t raw, unsigned depth, std::error_code & ec) noexcept -> uint32_t
+  {
+  if(depth == 0u)
+    return chain(raw, ec);
+  uint32_t const inner{propagate(raw, depth - 1u, ec)};
+  if(ec) [[unlikely]]
+    return 0u;
+  return inner + depth;
+  }
+
+EXPECTED_BENCH_CODE(error_code) auto run_deep(inputs_t inputs) noexcept -> uint64_t
+  {
+  uint64_t sum{};
+  for(uint32_t raw: inputs)
+    {
+    std::error_code ec;
+    uint32_t const value{propagate(raw, propagation_depth, ec)};
+    sum += ec ? 1u : value;
+    }
+  return sum;
+  }
+
+EXPECTED_BENCH_CODE(error_code) auto build(uint32_t raw, std::error_code & ec) noexcept -> payload
+  {
+  uint32_t const value{chain(raw, ec)};
+  if(ec)
+    return {};
+  return fill_payload(value);
+  }
+
+EXPECTED_BENCH_CODE(error_code) auto run_large(inputs_t inputs) noexcept -> uint64_t
+  {
+  uint64_t sum{};
+  for(uint32_t raw: inputs)
+    {
+    std::error_code ec;
+    payload const value{build(raw, ec)};
+    sum += ec ? 1u : mix_payload(value)[7];
+    }
+  return sum;
+  }
+  }  // namespace error_code
+
+namespace
+  {
+using input_vector = small_vectors::vector<uint32_t>;
+
+struct xorshift
+  {
+  uint64_t state{0x9e37'79b9'7f4a'7c15ull};
+
+  auto operator()() noexcept -> uint32_t
+    {
+    state ^= state << 13u;
+    state ^= state >> 7u;
+    state ^= state << 17u;
+    return static_cast<uint32_t>(state >> 16u);
+    }
+  };
+
+///\brief raw inputs passing every stage or failing at last one so error travels whole chain
+auto make_inputs(uint32_t count, bool failing) -> input_vector
+  {
+  xorshift random;
+  input_vector inputs(count);
+  for(uint32_t & raw: inputs)
+    {
+    uint32_t value{random() % value_limit};
+    if(failing)
+      value |= malformed_mask;
+    else if((value & malformed_mask) == malformed_mask)
+      value ^= 1u;
+    raw = value + 1u;
+    }
+  return inputs;
+  }
+
+struct variant_t
+  {
+  char const * name;
+  uint64_t (*run_chain)(inputs_t);
+  uint64_t (*run_void)(inputs_t);
+  uint64_t (*run_deep)(inputs_t);
+  uint64_t (*run_large)(inputs_t);
+  std::ptrdiff_t code_size;
+  };
+
+auto time_ns(uint64_t (*run)(inputs_t), input_vector const & inputs, uint64_t & checksum) -> double
+  {
+  auto const start{std::chrono::steady_clock::now()};
+  checksum += run(inputs);
+  auto const elapsed{std::chrono::steady_clock::now() - start};
+  return std::chrono::duration<double, std::nano>(elapsed).count() / double(inputs.size());
+  }
+  }  // namespace
+
+int main(int argc, char ** argv)
+  {
+  uint32_t const count{argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 200'000u};
+  input_vector const happy{make_inputs(count, false)};
+  input_vector const failing{make_inputs(count, true)};
+
+#if defined(EXPECTED_BENCH_CODE_SIZE)
+#define EXPECTED_BENCH_CODE_SIZE_OF(group) (__stop_expected_bench_##group - __start_expected_bench_##group)
+#else
+#define EXPECTED_BENCH_CODE_SIZE_OF(group) std::ptrdiff_t{-1}
+#endif
+  variant_t const variants[]{
+    {"small_vectors", small_vectors_expected::run_chain, small_vectors_expected::run_void,
+     small_vectors_expected::run_deep, small_vectors_expected::run_large,
+     EXPECTED_BENCH_CODE_SIZE_OF(small_vectors_expected)},
+#if defined(EXPECTED_BENCH_STD)
+    {"std::expected", std_expected::run_chain, std_expected::run_void, std_expected::run_deep,
+     std_expected::run_large, EXPECTED_BENCH_CODE_SIZE_OF(std_expected)},
+#endif
+    {"exceptions", exceptions::run_chain, exceptions::run_void, exceptions::run_deep, exceptions::run_large,
+     EXPECTED_BENCH_CODE_SIZE_OF(exceptions)},
+    {"error_code", error_code::run_chain, error_code::run_void, error_code::run_deep, error_code::run_large,
+     EXPECTED_BENCH_CODE_SIZE_OF(error_code)},
+  };
+#if !defined(EXPECTED_BENCH_STD)
+  std::printf("std::expected with monadic operations not available, skipped\n");
+#endif
+
+  struct scenario_t
+    {
+    char const * name;
+    uint64_t (*variant_t::*run)(inputs_t);
+    };
+
+  scenario_t const scenarios[]{
+    {"monadic chain", &variant_t::run_chain},
+    {"expected<void, E> checks", &variant_t::run_void},
+    {"propagation depth 16", &variant_t::run_deep},
+    {"128 byte value", &variant_t::run_large},
+  };
+
+  uint64_t checksum{};
+  std::printf("%-26s %-14s %12s %12s\n", "scenario", "variant", "happy ns/op", "error ns/op");
+  for(scenario_t const & scenario: scenarios)
+    for(variant_t const & variant: variants)
+      {
+      double const happy_ns{time_ns(variant.*scenario.run, happy, checksum)};
+      double const error_ns{time_ns(variant.*scenario.run, failing, checksum)};
+      std::printf("%-26s %-14s %12.2f %12.2f\n", scenario.name, variant.name, happy_ns, error_ns);
+      }
+
+  std::printf("\ncode size of all scenario functions\n");
+  for(variant_t const & variant: variants)
+    if(variant.code_size >= 0)
+      std::printf("  %-14s %6td bytes\n", variant.name, variant.code_size);
+    else
+      std::printf("  %-14s n/a\n", variant.name);
+  std::printf("checksum %llu\n", static_cast<unsigned long long>(checksum));
+  return EXIT_SUCCESS;
+  }
@@ -0,0 +1,90 @@
+// lower_bound variants over sorted uint32_t arrays of growing size with random queries,
+// usage: lower_bound_bench [max_size], build with -march=native to enable AVX2 paths
+#include <small_vectors/algo/batch_lower_bound.h>
+#include <small_vectors/algo/bound_leaning_lower_bound.h>
+#include <small_vectors/algo/branchless_lower_bound.h>
+#include <small_vectors/algo/eytzinger_lower_bound.h>
+#include <small_vectors/algo/static_search_tree.h>
+#include <small_vectors/small_vector.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+namespace lb = small_vectors::algo::lower_bound;
+
+namespace
+  {
+using data_vector = small_vectors::vector<uint32_t>;
+
+struct xorshift
+  {
+  uint64_t state{0x9e37'79b9'7f4a'7c15ull};
+
+  auto operator()() noexcept -> uint32_t
+    {
+    state ^= state << 13u;
+    state ^= state >> 7u;
+    state ^= state << 17u;
+    return static_cast<uint32_t>(state >> 16u);
+    }
+  };
+
+template<typename search_fn>
+auto measure(char const * name, data_vector const & data, data_vector const & queries, search_fn search) -> void
+  {
+  uint64_t checksum{};
+  auto const start{std::chrono::steady_clock::now()};
+  for(uint32_t q: queries)
+    checksum += static_cast<uint64_t>(search(q) - data.begin());
+  auto const elapsed{std::chrono::steady_clock::now() - start};
+  double const ns{std::chrono::duration<double, std::nano>(elapsed).count() / queries.size()};
+  std::printf("  %-14s %8.2f ns/query  (checksum %llu)\n", name, ns, static_cast<unsigned long long>(checksum));
+  }
+
+auto measure_batch(data_vector const & data, data_vector const & queries) -> void
+  {
+  small_vectors::small_vector<std::size_t, uint32_t> positions(queries.size());
+  auto const start{std::chrono::steady_clock::now()};
+  lb::batch_lower_bound(data.begin(), data.end(), queries, positions.begin());
+  auto const elapsed{std::chrono::steady_clock::now() - start};
+  uint64_t checksum{};
+  for(std::size_t pos: positions)
+    checksum += pos;
+  double const ns{std::chrono::duration<double, std::nano>(elapsed).count() / queries.size()};
+  std::printf("  %-14s %8.2f ns/query  (checksum %llu)\n", "batch", ns, static_cast<unsigned long long>(checksum));
+  }
+  }  // namespace
+
+int main(int argc, char ** argv)
+  {
+  uint32_t const max_size{argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 100'000'000u};
+  constexpr uint32_t query_count{1'000'000u};
+  xorshift random;
+  data_vector queries(query_count);
+  std::ranges::generate(queries, random);
+
+  for(uint32_t size{1'000u}; size <= max_size; size *= 10u)
+    {
+    data_vector data(size);
+    std::ranges::generate(data, random);
+    std::ranges::sort(data);
+    lb::eytzinger_index const eytzinger{data};
+    lb::static_search_tree const tree{data};
+
+    std::printf("size %u\n", size);
+    measure("std", data, queries, [&](uint32_t v) { return std::lower_bound(data.begin(), data.end(), v); });
+    measure(
+      "bound_leaning",
+      data,
+      queries,
+      [&](uint32_t v) { return lb::bound_leaning(data.begin(), data.end(), v, std::ranges::less{}); }
+    );
+    measure("branchless", data, queries, [&](uint32_t v) { return lb::branchless(data.begin(), data.end(), v); });
+    measure("eytzinger", data, queries, [&](uint32_t v) { return eytzinger(data.begin(), data.end(), v); });
+    measure("s-tree", data, queries, [&](uint32_t v) { return tree(data.begin(), data.end(), v); });
+    measure_batch(data, queries);
+    }
+  return EXIT_SUCCESS;
+  }
@@ -0,0 +1,72 @@
+// copying labels into per thread records, basic_string against shared_string,
+// usage: shared_string_bench [threads], every thread copies the same set of labels so reference counts are contended
+#include <small_vectors/basic_string.h>
+#include <small_vectors/shared_string.h>
+#include <small_vectors/small_vector.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+namespace
+  {
+constexpr uint32_t label_count{64u};
+constexpr uint32_t rounds{20'000u};
+
+template<typename string_type>
+auto make_labels(std::size_t length) -> small_vectors::vector<string_type>
+  {
+  small_vectors::vector<string_type> labels;
+  for(uint32_t ix{}; ix != label_count; ++ix)
+    {
+    std::string text(length, 'a');
+    text.replace(0u, std::to_string(ix).size(), std::to_string(ix));
+    labels.emplace_back(std::string_view{text});
+    }
+  return labels;
+  }
+
+template<typename string_type>
+auto measure(char const * name, std::size_t length, uint32_t threads) -> void
+  {
+  auto const labels{make_labels<string_type>(length)};
+  auto const start{std::chrono::steady_clock::now()};
+    {
+    small_vectors::small_vector<std::jthread, uint32_t, 0> workers;
+    for(uint32_t t{}; t != threads; ++t)
+      workers.emplace_back(
+        [&labels]
+        {
+          small_vectors::vector<string_type> record;
+          record.reserve(label_count);
+          for(uint32_t round{}; round != rounds; ++round)
+            {
+            for(string_type const & label: labels)
+              record.emplace_back(label);
+            record.clear();
+            }
+        }
+      );
+    }
+  auto const elapsed{std::chrono::steady_clock::now() - start};
+  double const copies{static_cast<double>(threads) * rounds * label_count};
+  double const ns{std::chrono::duration<double, std::nano>(elapsed).count() / copies};
+  std::printf("  %-14s length %3zu  %8.2f ns/copy\n", name, length, ns);
+  }
+  }  // namespace
+
+int main(int argc, char ** argv)
+  {
+  uint32_t const threads{
+    argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : std::thread::hardware_concurrency()
+  };
+  std::printf("threads %u\n", threads);
+  for(std::size_t length: {16u, 64u, 256u})
+    {
+    measure<small_vectors::string>("basic_string", length, threads);
+    measure<small_vectors::shared_string>("shared_string", length, threads);
+    }
+  return EXIT_SUCCESS;
+  }
@@ -0,0 +1,95 @@
+// decoding posting list like uint32_t sequences, LEB128 varint byte by byte against Stream VByte scalar and SIMD,
+// usage: varint_bench [count], build with -march=native to enable SSSE3 and AVX2 paths
+#include <small_vectors/utils/varint.h>
+#include <small_vectors/small_vector.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+
+namespace varint = small_vectors::utils::varint;
+namespace stream_vbyte = small_vectors::utils::stream_vbyte;
+
+namespace
+  {
+using value_vector = small_vectors::vector<uint32_t>;
+using byte_vector = small_vectors::small_vector<std::byte, uint64_t, 0>;
+
+struct xorshift
+  {
+  uint64_t state{0x9e37'79b9'7f4a'7c15ull};
+
+  auto operator()() noexcept -> uint64_t
+    {
+    state ^= state << 13u;
+    state ^= state >> 7u;
+    state ^= state << 17u;
+    return state;
+    }
+  };
+
+template<typename decode_fn>
+auto measure(char const * name, value_vector const & values, std::size_t encoded_size, decode_fn decode) -> void
+  {
+  constexpr int rounds{20};
+  value_vector decoded(static_cast<uint32_t>(values.size()));
+  auto const start{std::chrono::steady_clock::now()};
+  for(int round{}; round != rounds; ++round)
+    decode(decoded);
+  auto const elapsed{std::chrono::steady_clock::now() - start};
+  bool const valid{std::ranges::equal(decoded, values)};
+  double const ns{std::chrono::duration<double, std::nano>(elapsed).count() / (rounds * double(values.size()))};
+  std::printf("  %-20s %6.3f ns/value  %5.2f bytes/value %s\n", name, ns, double(encoded_size) / double(values.size()),
+              valid ? "" : "INVALID");
+  }
+  }  // namespace
+
+int main(int argc, char ** argv)
+  {
+  uint32_t const count{argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 10'000'000u};
+  xorshift random;
+  for(uint32_t max_bits: {7u, 14u, 32u})
+    {
+    value_vector values(count);
+    for(uint32_t & value: values)
+      value = static_cast<uint32_t>(random() & ((uint64_t{1} << (random() % max_bits + 1u)) - 1u));
+
+    small_vectors::vector<uint8_t> leb;
+    for(uint32_t value: values)
+      varint::encode(value, std::back_inserter(leb));
+    byte_vector svb;
+    stream_vbyte::encode_append(values, svb);
+
+    std::printf("values up to %u bits\n", max_bits);
+    measure(
+      "leb128",
+      values,
+      leb.size(),
+      [&](value_vector & out)
+      {
+        auto it{leb.cbegin()};
+        for(uint32_t & value: out)
+          value = *varint::decode_fwd<uint32_t>(it, leb.cend());
+      }
+    );
+    measure(
+      "stream_vbyte scalar",
+      values,
+      svb.size(),
+      [&](value_vector & out)
+      {
+        std::span<std::byte const> const in{svb.data(), svb.size()};
+        std::size_t const control_size{(out.size() + 3u) / 4u};
+        stream_vbyte::detail::decode_scalar(in.first(control_size), in.subspan(control_size), 0u, out, 0u);
+      }
+    );
+    measure(
+      "stream_vbyte",
+      values,
+      svb.size(),
+      [&](value_vector & out) { static_cast<void>(stream_vbyte::decode(std::span{svb.data(), svb.size()}, out)); }
+    );
+    }
+  }
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <small_vectors/algo/branchless_lower_bound.h>
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+
+namespace small_vectors::inline v3_3::algo::lower_bound
+  {
+///\brief lower_bound of many independent keys over the same sorted range
+///\details keys are searched in groups of group_size in lockstep, branchless search over the same range performs the
+/// same number of halving steps for every key, so after each step next probes of the whole group are prefetched before
+/// any of them is compared keeping group_size cache misses in flight instead of one dependent chain per key
+struct batch_lower_bound_fn
+  {
+  static constexpr std::size_t group_size{16u};
+
+  ///\brief writes position of lower_bound in [first, last) for every key of \p keys to \p out
+  template<
+    std::random_access_iterator iterator,
+    std::sentinel_for<iterator> sentinel,
+    std::ranges::random_access_range keys_range,
+    std::weakly_incrementable out_iterator,
+    typename compare_type = std::ranges::less>
+    requires std::indirectly_writable<out_iterator, std::size_t>
+             && std::invocable<
+               compare_type,
+               typename std::iterator_traits<iterator>::value_type const &,
+               std::ranges::range_value_t<keys_range> const &>
+  constexpr auto operator()(
+    iterator first, sentinel last, keys_range const & keys, out_iterator out, compare_type less = {}
+  ) const noexcept(noexcept(less(*first, *std::ranges::begin(keys)))) -> out_iterator
+    {
+    auto const size{std::ranges::distance(first, last)};
+    auto key_it{std::ranges::begin(keys)};
+    auto const key_end{std::ranges::end(keys)};
+    std::array<iterator, group_size> bases;
+    while(key_it != key_end)
+      {
+      auto const count{static_cast<std::size_t>(
+        std::min(static_cast<std::ranges::range_difference_t<keys_range>>(group_size), key_end - key_it)
+      )};
+      auto const key = [key_it](std::size_t ix) -> decltype(auto)
+      { return *std::ranges::next(key_it, static_cast<std::ranges::range_difference_t<keys_range>>(ix)); };
+
+      std::fill_n(bases.begin(), count, first);
+      for(auto length{size}; length > 1;)
+        {
+        auto const half{length / 2};
+        small_vectors_clang_unsafe_buffer_usage_begin  //
+          for(std::size_t ix{}; ix != count; ++ix)
+            bases[ix] += half * static_cast<decltype(half)>(less(*(bases[ix] + half), key(ix)));
+        small_vectors_clang_unsafe_buffer_usage_end  //
+          length -= half;
+        if constexpr(std::contiguous_iterator<iterator>)
+          if(!std::is_constant_evaluated())
+            for(std::size_t ix{}; ix != count; ++ix)
+              detail::prefetch(std::to_address(bases[ix]), static_cast<std::size_t>(length / 2));
+        }
+      for(std::size_t ix{}; ix != count; ++ix, ++out)
+        {
+        auto position{static_cast<std::size_t>(bases[ix] - first)};
+        if(size != 0 && less(*bases[ix], key(ix)))
+          ++position;
+        *out = position;
+        }
+      key_it = std::ranges::next(key_it, static_cast<std::ranges::range_difference_t<keys_range>>(count));
+      }
+    return out;
+    }
+  };
+
+inline constexpr batch_lower_bound_fn batch_lower_bound{};
+  }  // namespace small_vectors::inline v3_3::algo::lower_bound
@@ -0,0 +1,567 @@
+#pragma once
+
+#include <small_vectors/algo/mtf.h>
+#include <small_vectors/algo/rle.h>
+#include <small_vectors/small_vector.h>
+#include <small_vectors/utils/expected.h>
+#include <small_vectors/utils/static_call_operator.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <thread>
+
+/// \brief Block parallel compression, each block is transformed with Burrows–Wheeler transform, move-to-front, zero
+/// run length encoding and order-0 rANS entropy coder independently so compression and decompression scale with cores
+namespace small_vectors::inline v3_3::algo::block_compressor
+  {
+using byte_buffer = small_vector<std::byte, uint64_t, 0>;
+
+enum struct error_e : uint8_t
+  {
+  invalid_header,
+  truncated_input,
+  corrupted_block,
+  /// decompressed size exceeds options_t::max_output_size
+  output_too_large,
+  out_of_memory
+  };
+
+struct options_t
+  {
+  /// size of independently compressed block, larger blocks compress better
+  uint32_t block_size{1u << 18};
+  /// number of worker threads, 0 uses std::thread::hardware_concurrency
+  uint32_t threads{};
+  /// largest decompressed size accepted by decompress, bounds allocation driven by untrusted container header
+  uint64_t max_output_size{uint64_t{1} << 32};
+  };
+
+namespace detail
+  {
+  using u8_vector = small_vector<uint8_t, uint32_t, 0>;
+  using u16_vector = small_vector<uint16_t, uint32_t, 0>;
+  using u32_vector = small_vector<uint32_t, uint32_t, 0>;
+
+  inline constexpr std::array<uint8_t, 4> magic{'S', 'V', 'B', 'C'};
+  inline constexpr uint8_t format_version{1u};
+  inline constexpr std::size_t container_header_size{magic.size() + 1u + 4u + 8u + 4u};
+  inline constexpr std::size_t block_header_size{4u * 4u};
+
+  inline constexpr uint32_t alphabet_size{rle::alphabet_size};
+
+  inline constexpr uint32_t rans_scale_bits{14u};
+  inline constexpr uint32_t rans_scale{1u << rans_scale_bits};
+  inline constexpr uint32_t rans_lower_bound{1u << 23};
+
+  using frequency_table = std::array<uint16_t, alphabet_size>;
+
+  //-------------------------------------------------------------------------------------------------------------------
+  // little endian framing
+  struct writer_t
+    {
+    byte_buffer & out;
+
+    void put(std::span<uint8_t const> bytes)
+      {
+      std::size_t const pos{out.size()};
+      out.resize(pos + bytes.size());
+      std::ranges::transform(
+        bytes, std::ranges::next(out.begin(), static_cast<std::ptrdiff_t>(pos)), [](uint8_t b) noexcept
+        { return std::byte{b}; }
+      );
+      }
+
+    template<std::unsigned_integral value_type>
+    void put(value_type value)
+      {
+      std::array<uint8_t, sizeof(value_type)> bytes;
+      for(auto & b: bytes)
+        {
+        b = static_cast<uint8_t>(value & 0xffu);
+        value = static_cast<value_type>(value >> 8u);
+        }
+      put(bytes);
+      }
+    };
+
+  struct reader_t
+    {
+    std::span<std::byte const> in;
+    std::size_t pos{};
+
+    [[nodiscard]]
+    constexpr auto available() const noexcept -> std::size_t
+      {
+      return in.size() - pos;
+      }
+
+    [[nodiscard]]
+    constexpr auto byte() noexcept -> uint8_t
+      {
+      return static_cast<uint8_t>(in[pos++]);
+      }
+
+    ///\brief reads little endian value, caller checks available()
+    template<std::unsigned_integral value_type>
+    [[nodiscard]]
+    constexpr auto get() noexcept -> value_type
+      {
+      value_type value{};
+      for(unsigned shift{}; shift != sizeof(value_type) * 8u; shift += 8u)
+        value = static_cast<value_type>(value | static_cast<value_type>(static_cast<value_type>(byte()) << shift));
+      return value;
+      }
+    };
+
+  //-------------------------------------------------------------------------------------------------------------------
+  ///\brief sorts cyclic rotations of \p block by prefix doubling with counting sort, O(n log n) regardless of
+  /// repetitions in data
+  inline auto sort_cyclic_rotations(std::span<uint8_t const> block) -> u32_vector
+    {
+    auto const n{static_cast<uint32_t>(block.size())};
+    u32_vector order(n);
+    u32_vector classes(n);
+    u32_vector counts(std::max(n, 256u));
+    for(uint8_t c: block)
+      ++counts[c];
+    for(uint32_t ix{1u}; ix != 256u; ++ix)
+      counts[ix] += counts[ix - 1u];
+    for(uint32_t ix{n}; ix != 0u; --ix)
+      order[--counts[block[ix - 1u]]] = ix - 1u;
+
+    uint32_t class_count{1u};
+    classes[order[0u]] = 0u;
+    for(uint32_t ix{1u}; ix != n; ++ix)
+      {
+      if(block[order[ix]] != block[order[ix - 1u]])
+        ++class_count;
+      classes[order[ix]] = class_count - 1u;
+      }
+
+    u32_vector next_order(n);
+    u32_vector next_classes(n);
+    for(uint32_t length{1u}; length < n && class_count != n; length <<= 1u)
+      {
+      // order by second half is order of rotations shifted by length, stable counting sort by first half class
+      for(uint32_t ix{}; ix != n; ++ix)
+        next_order[ix] = order[ix] >= length ? order[ix] - length : order[ix] + n - length;
+      std::fill_n(counts.begin(), class_count, 0u);
+      for(uint32_t ix{}; ix != n; ++ix)
+        ++counts[classes[next_order[ix]]];
+      for(uint32_t ix{1u}; ix != class_count; ++ix)
+        counts[ix] += counts[ix - 1u];
+      for(uint32_t ix{n}; ix != 0u; --ix)
+        order[--counts[classes[next_order[ix - 1u]]]] = next_order[ix - 1u];
+
+      auto const second = [&classes, length, n](uint32_t pos) noexcept
+      { return classes[pos + length < n ? pos + length : pos + length - n]; };
+      class_count = 1u;
+      next_classes[order[0u]] = 0u;
+      for(uint32_t ix{1u}; ix != n; ++ix)
+        {
+        uint32_t const cur{order[ix]};
+        uint32_t const prev{order[ix - 1u]};
+        if(classes[cur] != classes[prev] || second(cur) != second(prev))
+          ++class_count;
+        next_classes[cur] = class_count - 1u;
+        }
+      classes.swap(next_classes);
+      }
+    return order;
+    }
+
+  ///\brief bwt without end marker, \returns row of sorted rotations matrix holding original block
+  inline auto bwt_encode(std::span<uint8_t const> block, std::span<uint8_t> last_column) -> uint32_t
+    {
+    auto const n{static_cast<uint32_t>(block.size())};
+    u32_vector const order{sort_cyclic_rotations(block)};
+    uint32_t primary{};
+    for(uint32_t row{}; row != n; ++row)
+      {
+      uint32_t const start{order[row]};
+      if(start == 0u)
+        primary = row;
+      last_column[row] = block[start != 0u ? start - 1u : n - 1u];
+      }
+    return primary;
+    }
+
+  inline void bwt_decode(std::span<uint8_t const> last_column, uint32_t primary, std::span<std::byte> out)
+    {
+    auto const n{static_cast<uint32_t>(last_column.size())};
+    std::array<uint32_t, 256> starts{};
+    for(uint8_t c: last_column)
+      ++starts[c];
+    uint32_t sum{};
+    for(auto & start: starts)
+      sum += std::exchange(start, sum);
+    u32_vector next(n);
+    for(uint32_t row{}; row != n; ++row)
+      next[starts[last_column[row]]++] = row;
+    uint32_t row{next[primary]};
+    for(auto & b: out)
+      {
+      b = std::byte{last_column[row]};
+      row = next[row];
+      }
+    }
+
+  //-------------------------------------------------------------------------------------------------------------------
+  ///\brief scales symbol counts to sum of rans_scale keeping every present symbol frequency non zero
+  inline auto normalize_frequencies(std::span<uint16_t const> symbols) noexcept -> frequency_table
+    {
+    std::array<uint32_t, alphabet_size> counts{};
+    for(uint16_t symbol: symbols)
+      ++counts[symbol];
+    auto const total{static_cast<uint64_t>(symbols.size())};
+    frequency_table freq{};
+    uint32_t sum{};
+    for(uint32_t symbol{}; symbol != alphabet_size; ++symbol)
+      if(counts[symbol] != 0u)
+        {
+        freq[symbol] = static_cast<uint16_t>(std::max<uint64_t>(1u, counts[symbol] * uint64_t{rans_scale} / total));
+        sum += freq[symbol];
+        }
+    auto const largest = [&freq]() noexcept { return std::ranges::max_element(freq); };
+    for(; sum > rans_scale; --sum)
+      --*largest();
+    *largest() = static_cast<uint16_t>(*largest() + (rans_scale - sum));
+    return freq;
+    }
+
+  inline auto cumulative(frequency_table const & freq) noexcept -> std::array<uint32_t, alphabet_size>
+    {
+    std::array<uint32_t, alphabet_size> start{};
+    uint32_t sum{};
+    for(uint32_t symbol{}; symbol != alphabet_size; ++symbol)
+      {
+      start[symbol] = sum;
+      sum += freq[symbol];
+      }
+    return start;
+    }
+
+  inline void rans_encode(std::span<uint16_t const> symbols, frequency_table const & freq, writer_t & out)
+    {
+    auto const start{cumulative(freq)};
+    u8_vector reversed;
+    reversed.reserve(static_cast<uint32_t>(symbols.size() / 2u + 4u));
+    uint32_t state{rans_lower_bound};
+    for(auto it{symbols.rbegin()}; it != symbols.rend(); ++it)
+      {
+      uint32_t const f{freq[*it]};
+      uint32_t const state_max{((rans_lower_bound >> rans_scale_bits) << 8u) * f};
+      for(; state >= state_max; state >>= 8u)
+        reversed.push_back(static_cast<uint8_t>(state & 0xffu));
+      state = ((state / f) << rans_scale_bits) + (state % f) + start[*it];
+      }
+    for(unsigned shift{24u}; shift != 0u; shift -= 8u)
+      reversed.push_back(static_cast<uint8_t>(state >> shift));
+    reversed.push_back(static_cast<uint8_t>(state & 0xffu));
+    std::ranges::reverse(reversed);
+    out.put(std::span<uint8_t const>{reversed.data(), reversed.size()});
+    }
+
+  ///\returns false when stream is truncated or final decoder state does not match initial encoder state
+  inline auto rans_decode(reader_t & in, frequency_table const & freq, std::span<uint16_t> symbols) noexcept -> bool
+    {
+    auto const start{cumulative(freq)};
+    std::array<uint16_t, rans_scale> lookup{};
+    for(uint32_t symbol{}; symbol != alphabet_size; ++symbol)
+      std::ranges::fill_n(
+        std::ranges::next(lookup.begin(), start[symbol]),
+        static_cast<std::ptrdiff_t>(freq[symbol]),
+        static_cast<uint16_t>(symbol)
+      );
+    if(in.available() < 4u)
+      return false;
+    uint32_t state{in.get<uint32_t>()};
+    for(uint16_t & symbol: symbols)
+      {
+      uint32_t const slot{state & (rans_scale - 1u)};
+      symbol = lookup[slot];
+      state = freq[symbol] * (state >> rans_scale_bits) + slot - start[symbol];
+      for(; state < rans_lower_bound; state = (state << 8u) | in.byte())
+        if(in.available() == 0u) [[unlikely]]
+          return false;
+      }
+    return state == rans_lower_bound;
+    }
+
+  //-------------------------------------------------------------------------------------------------------------------
+  inline auto compress_block(std::span<std::byte const> block) -> byte_buffer
+    {
+    auto const n{static_cast<uint32_t>(block.size())};
+    u8_vector data(n);
+    std::ranges::transform(block, data.begin(), [](std::byte b) noexcept { return static_cast<uint8_t>(b); });
+    u8_vector transformed(n);
+    uint32_t const primary{bwt_encode(data, transformed)};
+    mtf::encode(transformed, transformed.begin());
+    u16_vector symbols;
+    symbols.reserve(n);
+    rle::encode(transformed, std::back_inserter(symbols));
+    frequency_table const freq{normalize_frequencies(symbols)};
+
+    byte_buffer result;
+    writer_t out{result};
+    out.put(n);
+    out.put(primary);
+    out.put(symbols.size());
+    out.put(uint32_t{});  // payload size patched below
+    auto const present{static_cast<uint16_t>(std::ranges::count_if(freq, [](uint16_t f) noexcept { return f != 0u; }))};
+    out.put(present);
+    for(uint16_t symbol{}; symbol != alphabet_size; ++symbol)
+      if(freq[symbol] != 0u)
+        {
+        out.put(symbol);
+        out.put(freq[symbol]);
+        }
+    rans_encode(symbols, freq, out);
+
+    auto payload_size{static_cast<uint32_t>(result.size() - block_header_size)};
+    for(uint64_t ix{12u}; ix != block_header_size; ++ix, payload_size >>= 8u)
+      result[ix] = std::byte{static_cast<uint8_t>(payload_size & 0xffu)};
+    return result;
+    }
+
+  inline auto decompress_block(
+    std::span<std::byte const> payload, uint32_t primary, uint32_t symbol_count, std::span<std::byte> out
+  ) -> bool
+    {
+    reader_t in{payload};
+    if(in.available() < 2u)
+      return false;
+    auto const present{in.get<uint16_t>()};
+    if(present == 0u || present > alphabet_size || in.available() < present * 4u)
+      return false;
+    frequency_table freq{};
+    uint32_t sum{};
+    // symbols are written in strictly increasing order, duplicate would leave part of decode lookup unset
+    uint32_t next_symbol{};
+    for(uint16_t ix{}; ix != present; ++ix)
+      {
+      auto const symbol{in.get<uint16_t>()};
+      auto const f{in.get<uint16_t>()};
+      if(symbol < next_symbol || symbol >= alphabet_size || f == 0u)
+        return false;
+      next_symbol = symbol + 1u;
+      freq[symbol] = f;
+      sum += f;
+      }
+    if(sum != rans_scale || symbol_count > out.size() + 1u || primary >= out.size())
+      return false;
+
+    u16_vector symbols(symbol_count);
+    if(!rans_decode(in, freq, symbols))
+      return false;
+    u8_vector transformed(static_cast<uint32_t>(out.size()));
+    if(auto const decoded{rle::decode(symbols, transformed)}; !decoded || *decoded != transformed.size())
+      return false;
+    mtf::decode(transformed, transformed.begin());
+    bwt_decode(transformed, primary, out);
+    return true;
+    }
+
+  //-------------------------------------------------------------------------------------------------------------------
+  ///\brief runs \p fn for indexes [0, count) on worker threads, rethrows first exception thrown by \p fn
+  template<typename function>
+  inline void parallel_for(std::size_t count, uint32_t threads, function const & fn)
+    {
+    if(threads == 0u)
+      threads = std::max(1u, std::thread::hardware_concurrency());
+    auto const workers{static_cast<uint32_t>(std::min<std::size_t>(count, threads))};
+    std::atomic<std::size_t> next{};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto const worker = [&]() noexcept
+    {
+      try
+        {
+        for(std::size_t ix{next.fetch_add(1u)}; ix < count; ix = next.fetch_add(1u))
+          fn(ix);
+        }
+      catch(...)
+        {
+        std::lock_guard lock{error_mutex};
+        if(!error)
+          error = std::current_exception();
+        next.store(count);
+        }
+    };
+      {
+      small_vector<std::jthread, uint32_t, 0> pool;
+      pool.reserve(workers);
+      for(uint32_t ix{1u}; ix < workers; ++ix)
+        pool.emplace_back(worker);
+      worker();
+      }
+    if(error)
+      std::rethrow_exception(error);
+    }
+
+  //-------------------------------------------------------------------------------------------------------------------
+  ///\brief decodes \p block_count blocks following validated container header in \p in
+  ///\warning throws std::bad_alloc on allocation failure
+  inline auto decompress_blocks(
+    reader_t in, uint32_t block_size, uint64_t total_size, uint32_t block_count, uint32_t threads
+  ) -> cxx23::expected<byte_buffer, error_e>
+    {
+    using cxx23::unexpected;
+
+    struct block_info
+      {
+      std::span<std::byte const> payload;
+      uint32_t primary;
+      uint32_t symbol_count;
+      };
+
+    small_vector<block_info, uint32_t, 0> blocks(block_count);
+    for(uint32_t ix{}; ix != block_count; ++ix)
+      {
+      if(in.available() < block_header_size)
+        return unexpected{error_e::truncated_input};
+      auto const raw_size{in.get<uint32_t>()};
+      blocks[ix].primary = in.get<uint32_t>();
+      blocks[ix].symbol_count = in.get<uint32_t>();
+      auto const payload_size{in.get<uint32_t>()};
+      if(raw_size != std::min<uint64_t>(block_size, total_size - uint64_t{ix} * block_size))
+        return unexpected{error_e::corrupted_block};
+      if(in.available() < payload_size)
+        return unexpected{error_e::truncated_input};
+      blocks[ix].payload = in.in.subspan(in.pos, payload_size);
+      in.pos += payload_size;
+      }
+
+    byte_buffer result(total_size);
+    std::span<std::byte> const output{result.data(), result.size()};
+    std::atomic<bool> corrupted{};
+    parallel_for(
+      block_count,
+      threads,
+      [&](std::size_t ix)
+      {
+        uint64_t const offset{ix * uint64_t{block_size}};
+        auto const out{output.subspan(offset, std::min<uint64_t>(block_size, total_size - offset))};
+        block_info const & info{blocks[ix]};
+        if(!decompress_block(info.payload, info.primary, info.symbol_count, out))
+          corrupted.store(true);
+      }
+    );
+    if(corrupted.load())
+      return unexpected{error_e::corrupted_block};
+    return result;
+    }
+  }  // namespace detail
+
+struct compress_fn
+  {
+  ///\brief compresses \p input into framed container of independently compressed blocks
+  ///\warning throws std::bad_alloc on allocation failure
+  [[nodiscard]]
+  small_vector_static_call_operator auto
+    operator()(std::span<std::byte const> input, options_t options = {}) small_vector_static_call_operator_const
+    -> byte_buffer
+    {
+    std::size_t const block_size{std::max(1u, options.block_size)};
+    std::size_t const block_count{(input.size() + block_size - 1u) / block_size};
+    small_vector<byte_buffer, uint32_t, 0> blocks(static_cast<uint32_t>(block_count));
+    detail::parallel_for(
+      block_count,
+      options.threads,
+      [&](std::size_t ix)
+      {
+        std::size_t const offset{ix * block_size};
+        blocks[ix] = detail::compress_block(input.subspan(offset, std::min(block_size, input.size() - offset)));
+      }
+    );
+
+    byte_buffer result;
+    uint64_t total_size{detail::container_header_size};
+    for(byte_buffer const & block: blocks)
+      total_size += block.size();
+    result.reserve(total_size);
+    detail::writer_t out{result};
+    out.put(detail::magic);
+    out.put(detail::format_version);
+    out.put(static_cast<uint32_t>(block_size));
+    out.put(static_cast<uint64_t>(input.size()));
+    out.put(static_cast<uint32_t>(block_count));
+    for(byte_buffer const & block: blocks)
+      result.insert(result.end(), block.begin(), block.end());
+    return result;
+    }
+
+  template<std::ranges::contiguous_range byte_range>
+    requires(sizeof(std::ranges::range_value_t<byte_range>) == 1u)
+  [[nodiscard]]
+  small_vector_static_call_operator auto
+    operator()(byte_range const & input, options_t options = {}) small_vector_static_call_operator_const -> byte_buffer
+    {
+    return compress_fn{}(std::as_bytes(std::span{input}), options);
+    }
+  };
+
+inline constexpr compress_fn compress;
+
+struct decompress_fn
+  {
+  ///\brief decompresses container produced by compress, blocks are decoded in parallel
+  ///\details header fields are validated against input size and options_t::max_output_size before any allocation,
+  /// allocation failure is reported as error_e::out_of_memory
+  [[nodiscard]]
+  small_vector_static_call_operator auto
+    operator()(std::span<std::byte const> input, options_t options = {}) small_vector_static_call_operator_const
+    -> cxx23::expected<byte_buffer, error_e>
+    {
+    using cxx23::unexpected;
+    detail::reader_t in{input};
+    if(in.available() < detail::container_header_size)
+      return unexpected{error_e::truncated_input};
+    for(uint8_t m: detail::magic)
+      if(in.byte() != m)
+        return unexpected{error_e::invalid_header};
+    if(in.byte() != detail::format_version)
+      return unexpected{error_e::invalid_header};
+    auto const block_size{in.get<uint32_t>()};
+    auto const total_size{in.get<uint64_t>()};
+    auto const block_count{in.get<uint32_t>()};
+    if(block_size == 0u || total_size / block_size + (total_size % block_size != 0u ? 1u : 0u) != block_count)
+      return unexpected{error_e::invalid_header};
+    // every block has header, so count is bounded by bytes actually present
+    if(block_count > in.available() / detail::block_header_size)
+      return unexpected{error_e::truncated_input};
+    if(total_size > options.max_output_size || total_size > std::numeric_limits<std::size_t>::max())
+      return unexpected{error_e::output_too_large};
+    try
+      {
+      return detail::decompress_blocks(in, block_size, total_size, block_count, options.threads);
+      }
+    catch(std::bad_alloc const &)
+      {
+      return unexpected{error_e::out_of_memory};
+      }
+    }
+
+  template<std::ranges::contiguous_range byte_range>
+    requires(sizeof(std::ranges::range_value_t<byte_range>) == 1u)
+  [[nodiscard]]
+  small_vector_static_call_operator auto
+    operator()(byte_range const & input, options_t options = {}) small_vector_static_call_operator_const
+    -> cxx23::expected<byte_buffer, error_e>
+    {
+    return decompress_fn{}(std::as_bytes(std::span{input}), options);
+    }
+  };
+
+inline constexpr decompress_fn decompress;
+  }  // namespace small_vectors::inline v3_3::algo::block_compressor
@@ -1,10 +1,11 @@
 #pragma once
 
 #include <small_vectors/version.h>
+#include <algorithm>
 #include <concepts>
 #include <iterator>
 
-/// \brief Burrows–Wheeler transform
+/// \brief lower_bound variants for sorted random access ranges
 namespace small_vectors::inline v3_3::algo::lower_bound
   {
 
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <small_vectors/version.h>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+namespace small_vectors::inline v3_3::algo::lower_bound
+  {
+namespace detail
+  {
+  ///\brief prefetches cache line of \p base [\p index] without forming out of range pointer
+  template<typename value_type>
+  inline void prefetch(value_type const * base, std::size_t index) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(reinterpret_cast<void const *>(reinterpret_cast<uintptr_t>(base) + index * sizeof(value_type)));
+#else
+    static_cast<void>(base);
+    static_cast<void>(index);
+#endif
+    }
+  }  // namespace detail
+
+///\brief binary search without data dependent branches
+///\details loop runs exactly bit_width(size) times and narrows range with conditional move, for contiguous ranges both
+/// possible next probes are prefetched so memory latency of large arrays overlaps with comparison
+struct branchless_lower_bound_fn
+  {
+  template<
+    std::random_access_iterator iterator,
+    std::sentinel_for<iterator> sentinel,
+    typename value_type,
+    typename compare_type = std::ranges::less>
+    requires std::
+      invocable<compare_type, typename std::iterator_traits<iterator>::value_type const &, value_type const &>
+    constexpr auto operator()(iterator first, sentinel last, value_type const & v, compare_type less = {}) const
+    noexcept(noexcept(less(*first, v))) -> iterator
+    {
+    auto length{std::ranges::distance(first, last)};
+    if(length == 0)
+      return first;
+    iterator base{first};
+    while(length > 1)
+      {
+      auto const half{length / 2};
+      if constexpr(std::contiguous_iterator<iterator>)
+        if(!std::is_constant_evaluated())
+          {
+          auto const * data{std::to_address(base)};
+          detail::prefetch(data, static_cast<std::size_t>(half / 2));
+          detail::prefetch(data, static_cast<std::size_t>(half + half / 2));
+          }
+      small_vectors_clang_unsafe_buffer_usage_begin  //
+        base = less(*(base + half), v) ? base + half : base;
+      small_vectors_clang_unsafe_buffer_usage_end  //
+        length -= half;
+      }
+    small_vectors_clang_unsafe_buffer_usage_begin  //
+      return less(*base, v) ? base + 1 : base;
+    small_vectors_clang_unsafe_buffer_usage_end  //
+    }
+  };
+
+inline constexpr branchless_lower_bound_fn branchless{};
+  }  // namespace small_vectors::inline v3_3::algo::lower_bound
@@ -20,6 +20,79 @@ namespace concepts
       || std::same_as<std::remove_const_t<value_type>, wchar_t>;
   }
 
+namespace detail
+  {
+  ///\brief all rotations of text with appended end marker sorted lexicographically
+  template<typename char_type>
+  struct sorted_rotations_t
+    {
+    using string_type = small_vectors::basic_string<char_type>;
+    using size_type = typename string_type::size_type;
+    using view_type = std::basic_string_view<char_type>;
+
+    /// text with end marker written twice so every rotation is a continuous view
+    string_type table;
+    /// rotation start indexes in sorted order, equal to suffix array of text with end marker
+    small_vectors::small_vector<uint32_t, uint32_t> rotations;
+
+    [[nodiscard]]
+    constexpr auto size() const noexcept -> size_type
+      {
+      return static_cast<size_type>(rotations.size());
+      }
+
+    ///\returns last column of sorted rotation matrix at \p row
+    [[nodiscard]]
+    constexpr auto last_column(uint32_t row) const noexcept -> char_type
+      {
+      return table[rotations[row] + size() - 1u];
+      }
+    };
+
+  template<char end_marker, std::contiguous_iterator source_iterator, std::sentinel_for<source_iterator> sentinel>
+  [[nodiscard]]
+  constexpr auto sort_rotations(source_iterator beg, sentinel end)
+    -> sorted_rotations_t<std::iter_value_t<source_iterator>>
+    {
+    namespace ranges = std::ranges;
+    using char_type = std::iter_value_t<source_iterator>;
+    using result_type = sorted_rotations_t<char_type>;
+    using size_type = typename result_type::size_type;
+    using view_type = typename result_type::view_type;
+    result_type result;
+    size_type sz{size_type(ranges::distance(beg, end) + 1u)};
+    result.table.resize_and_overwrite(
+      sz + sz,
+      [sz, beg, end](char_type * data, size_type /*cap*/)
+      {
+        auto it{data};
+        it = ranges::copy(beg, end, it).out;
+        *it = char_type(end_marker);
+        small_vectors_clang_unsafe_buffer_usage_begin  //
+          ++ it;
+        small_vectors_clang_unsafe_buffer_usage_end  //
+          it
+          = ranges::copy(beg, end, it).out;
+        *it = char_type(end_marker);
+        return sz + sz;
+      }
+    );
+    auto const f_view = [sz, &table = result.table](uint32_t ix) noexcept
+    {
+      auto begit{ranges::next(ranges::begin(table), ix)};
+      return view_type{begit, ranges::next(begit, sz)};
+    };
+
+    result.rotations.resize(sz);
+    std::iota(ranges::begin(result.rotations), ranges::end(result.rotations), 0u);
+    ranges::sort(
+      result.rotations,
+      [&f_view](uint32_t lix, uint32_t rix) noexcept { return f_view(lix).compare(f_view(rix)) < 0; }
+    );
+    return result;
+    }
+  }  // namespace detail
+
 template<char EndMarker>
 struct encode_t
   {
@@ -36,48 +109,15 @@ struct encode_t
     {
     namespace ranges = std::ranges;
     using char_type = std::iter_value_t<source_iterator>;
-    using string_type = small_vectors::basic_string<char_type>;
-    using size_type = typename string_type::size_type;
     if(beg != end)
       {
-      size_type sz{size_type(ranges::distance(beg, end) + 1u)};
-      string_type table;
-      table.resize_and_overwrite(
-        sz + sz,
-        [sz, beg, end](char_type * data, size_type /*cap*/)
-        {
-          auto it{data};
-          it = ranges::copy(beg, end, it).out;
-          *it = char_type(end_marker);
-          small_vectors_clang_unsafe_buffer_usage_begin  //
-            ++ it;
-          small_vectors_clang_unsafe_buffer_usage_end  //
-            it
-            = ranges::copy(beg, end, it).out;
-          *it = char_type(end_marker);
-          return sz + sz;
-        }
-      );
-      using view_type = std::basic_string_view<char_type>;
-      auto const f_view = [sz, &table](uint32_t ix) noexcept
-      {
-        auto begit{ranges::next(ranges::begin(table), ix)};
-        return view_type{begit, ranges::next(begit, sz)};
-      };
-
-      small_vectors::small_vector<uint32_t, uint32_t> rotvec;
-      rotvec.resize(sz);
-      std::iota(ranges::begin(rotvec), ranges::end(rotvec), 0u);
-      ranges::sort(
-        rotvec, [&f_view](uint32_t lix, uint32_t rix) noexcept { return f_view(lix).compare(f_view(rix)) < 0; }
-      );
-
+      auto const sorted{detail::sort_rotations<end_marker>(beg, end)};
       out = ranges::transform(
-              rotvec,
+              sorted.rotations,
               out,
-              [&table, sz](uint32_t ix) noexcept -> char_type
+              [&sorted](uint32_t ix) noexcept -> char_type
               {
-                char_type c{table[ix + sz - 1u]};
+                char_type c{sorted.table[ix + sorted.size() - 1u]};
                 return c;
               }
       ).out;
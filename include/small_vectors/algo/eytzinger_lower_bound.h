@@ -0,0 +1,104 @@
+#pragma once
+
+#include <small_vectors/algo/branchless_lower_bound.h>
+#include <small_vectors/small_vector.h>
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <ranges>
+
+namespace small_vectors::inline v3_3::algo::lower_bound
+  {
+///\brief copy of sorted range in Eytzinger (breadth first, heap like) order for cache friendly lower_bound
+///\details node k has children 2k and 2k+1 so first levels of every search share few hot cache lines and search
+/// prefetches descendants prefetch_levels levels ahead, one cache line holds all of them. Sorted position of every
+/// slot is kept in separate array read once per search to map result back to source range
+template<typename ValueType, typename CompareType = std::ranges::less>
+struct eytzinger_index
+  {
+  using value_type = ValueType;
+  using compare_type = CompareType;
+  using size_type = uint32_t;
+
+  /// slots per cache line rounded down to power of two
+  static constexpr size_type prefetch_stride{
+    std::bit_floor(static_cast<size_type>(std::max<std::size_t>(1u, 64u / sizeof(value_type))))
+  };
+
+  /// 1 based, slot 0 is unused
+  small_vector<value_type, size_type> values_;
+  small_vector<size_type, size_type> ranks_;
+  [[no_unique_address]] compare_type less_;
+
+  constexpr eytzinger_index() noexcept = default;
+
+  ///\brief builds layout from \p sorted range sorted according to \p less
+  template<std::ranges::random_access_range sorted_range>
+    requires std::convertible_to<std::ranges::range_reference_t<sorted_range>, value_type>
+  explicit constexpr eytzinger_index(sorted_range const & sorted, compare_type less = {}) :
+      values_(static_cast<size_type>(std::ranges::size(sorted) + 1u)),
+      ranks_(static_cast<size_type>(std::ranges::size(sorted) + 1u)),
+      less_{std::move(less)}
+    {
+    size_type rank{};
+    build(sorted, rank, 1u);
+    ranks_[0u] = size();
+    }
+
+  [[nodiscard]]
+  constexpr auto size() const noexcept -> size_type
+    {
+    return static_cast<size_type>(values_.size() - 1u);
+    }
+
+  ///\returns position in source sorted range of first element not less than \p v or size() when there is no such
+  template<typename key_type>
+    requires std::invocable<compare_type const &, value_type const &, key_type const &>
+  [[nodiscard]]
+  constexpr auto lower_bound_index(key_type const & v) const noexcept(noexcept(less_(values_[0u], v))) -> size_type
+    {
+    std::size_t const n{size()};
+    std::size_t k{1u};
+    value_type const * data{values_.data()};
+    while(k <= n)
+      {
+      if(!std::is_constant_evaluated())
+        detail::prefetch(data, k * prefetch_stride);
+      small_vectors_clang_unsafe_buffer_usage_begin  //
+        k = 2u * k + (less_(data[k], v) ? 1u : 0u);
+      small_vectors_clang_unsafe_buffer_usage_end  //
+      }
+    // cancel right turns made after the last left turn, slot 0 means every element is less than v
+    k >>= std::countr_one(k) + 1;
+    return ranks_[k];
+    }
+
+  ///\brief lower_bound over source range [first, last) the index was built from
+  template<std::random_access_iterator iterator, std::sentinel_for<iterator> sentinel, typename key_type>
+  [[nodiscard]]
+  constexpr auto operator()(iterator first, sentinel, key_type const & v) const
+    noexcept(noexcept(lower_bound_index(v))) -> iterator
+    {
+    return std::ranges::next(first, static_cast<std::iter_difference_t<iterator>>(lower_bound_index(v)));
+    }
+
+private:
+  template<typename sorted_range>
+  constexpr void build(sorted_range const & sorted, size_type & rank, size_type k)
+    {
+    if(k <= size())
+      {
+      build(sorted, rank, 2u * k);
+      values_[k] = std::ranges::begin(sorted)[rank];
+      ranks_[k] = rank++;
+      build(sorted, rank, 2u * k + 1u);
+      }
+    }
+  };
+
+template<std::ranges::random_access_range sorted_range>
+eytzinger_index(sorted_range const &) -> eytzinger_index<std::ranges::range_value_t<sorted_range>>;
+  }  // namespace small_vectors::inline v3_3::algo::lower_bound
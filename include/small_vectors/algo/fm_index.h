@@ -0,0 +1,205 @@
+#pragma once
+
+#include <small_vectors/algo/bwt.h>
+#include <small_vectors/algo/rank_select_bit_vector.h>
+#include <small_vectors/algo/wavelet_tree.h>
+#include <algorithm>
+#include <concepts>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+
+/// \brief FM-index, compressed full text index over Burrows–Wheeler transform
+namespace small_vectors::inline v3_3::algo
+  {
+///\brief substring count and locate queries over bwt of text without decoding it
+///\details occurrences are answered by backward search with wavelet_tree rank over compacted alphabet instead of
+/// uncompressed occurrence table, locate walks LF mapping to nearest sampled suffix array row, at most sample_rate - 1
+/// steps per occurrence
+template<bwt::concepts::char_type CharType>
+struct fm_index
+  {
+  using char_type = CharType;
+  using size_type = succinct::rank_select_bit_vector::size_type;
+  using symbol_type = succinct::wavelet_tree::symbol_type;
+  using view_type = std::basic_string_view<char_type>;
+
+  static constexpr size_type npos{succinct::rank_select_bit_vector::npos};
+
+  /// distinct symbols of bwt in ascending order, index in alphabet is the wavelet tree symbol
+  small_vector<symbol_type, size_type> alphabet_;
+  /// count of symbols lower than alphabet symbol, with total count at the end
+  small_vector<size_type, size_type> c_;
+  succinct::wavelet_tree bwt_;
+  /// rows with sampled suffix array value
+  succinct::rank_select_bit_vector sampled_;
+  small_vector<size_type, size_type> samples_;
+  size_type sample_rate_{};
+
+  constexpr fm_index() noexcept = default;
+
+  ///\brief constructs from bwt of text with end marker and suffix array of the same text
+  ///\param sample_rate every sample_rate-th text position is kept from suffix array
+  template<std::ranges::input_range bwt_range, std::ranges::input_range suffix_array_range>
+    requires std::same_as<std::ranges::range_value_t<bwt_range>, char_type>
+             && std::integral<std::ranges::range_value_t<suffix_array_range>>
+  constexpr fm_index(bwt_range const & bwt, suffix_array_range const & suffix_array, size_type sample_rate) :
+      sample_rate_{std::max(size_type{1u}, sample_rate)}
+    {
+    small_vector<symbol_type, size_type> symbols;
+    for(char_type c: bwt)
+      symbols.push_back(to_symbol(c));
+    build_alphabet(symbols);
+    bwt_ = succinct::wavelet_tree{symbols};
+
+    small_vector<bool, size_type> sampled(symbols.size());
+    auto sample_it{std::ranges::begin(sampled)};
+    for(auto pos: suffix_array)
+      {
+      auto const text_pos{static_cast<size_type>(pos)};
+      if(text_pos % sample_rate_ == 0u)
+        {
+        *sample_it = true;
+        samples_.push_back(text_pos);
+        }
+      ++sample_it;
+      }
+    sampled_ = succinct::rank_select_bit_vector{sampled};
+    }
+
+  ///\brief builds index of \p text by sorting its rotations with \p end_marker which must not occur in text
+  template<char end_marker, std::ranges::contiguous_range text_range>
+    requires std::same_as<std::ranges::range_value_t<text_range>, char_type>
+  [[nodiscard]]
+  static constexpr auto build(text_range const & text, size_type sample_rate) -> fm_index
+    {
+    auto const sorted{bwt::detail::sort_rotations<end_marker>(std::ranges::begin(text), std::ranges::end(text))};
+    small_vector<char_type, size_type> last_column(sorted.size());
+    for(size_type row{}; row != sorted.size(); ++row)
+      last_column[row] = sorted.last_column(row);
+    return fm_index{last_column, sorted.rotations, sample_rate};
+    }
+
+  ///\returns number of symbols in indexed bwt including end marker
+  [[nodiscard]]
+  constexpr auto size() const noexcept -> size_type
+    {
+    return bwt_.size();
+    }
+
+  [[nodiscard]]
+  constexpr auto sample_rate() const noexcept -> size_type
+    {
+    return sample_rate_;
+    }
+
+  ///\returns number of occurrences of \p pattern in text
+  [[nodiscard]]
+  constexpr auto count(view_type pattern) const noexcept -> size_type
+    {
+    auto const [first, last]{backward_search(pattern)};
+    return last - first;
+    }
+
+  [[nodiscard]]
+  constexpr auto contains(view_type pattern) const noexcept -> bool
+    {
+    return count(pattern) != 0u;
+    }
+
+  ///\brief writes text positions of all occurrences of \p pattern in suffix array order
+  template<std::weakly_incrementable out_iterator>
+  constexpr auto locate(view_type pattern, out_iterator out) const noexcept -> out_iterator
+    {
+    auto const [first, last]{backward_search(pattern)};
+    for(size_type row{first}; row != last; ++row)
+      {
+      *out = text_position(row);
+      ++out;
+      }
+    return out;
+    }
+
+  ///\returns text positions of all occurrences of \p pattern in suffix array order
+  [[nodiscard]]
+  constexpr auto locate(view_type pattern) const -> small_vector<size_type, size_type>
+    {
+    auto const [first, last]{backward_search(pattern)};
+    small_vector<size_type, size_type> positions(last - first);
+    locate(pattern, std::ranges::begin(positions));
+    return positions;
+    }
+
+  ///\returns row range [first, last) of sorted rotations prefixed with \p pattern
+  [[nodiscard]]
+  constexpr auto backward_search(view_type pattern) const noexcept -> std::pair<size_type, size_type>
+    {
+    size_type first{};
+    size_type last{size()};
+    for(auto it{pattern.rbegin()}; it != pattern.rend() && first != last; ++it)
+      {
+      size_type const code{alphabet_code(to_symbol(*it))};
+      if(code == npos)
+        return {};
+      first = c_[code] + bwt_.rank(code, first);
+      last = c_[code] + bwt_.rank(code, last);
+      }
+    if(first == last)
+      return {};
+    return {first, last};
+    }
+
+  ///\returns text position of suffix array \p row
+  [[nodiscard]]
+  constexpr auto text_position(size_type row) const noexcept -> size_type
+    {
+    size_type steps{};
+    while(!sampled_[row])
+      {
+      row = lf(row);
+      ++steps;
+      }
+    return samples_[sampled_.rank1(row)] + steps;
+    }
+
+  ///\returns row of rotation starting one symbol before rotation at \p row
+  [[nodiscard]]
+  constexpr auto lf(size_type row) const noexcept -> size_type
+    {
+    symbol_type const code{bwt_.access(row)};
+    return c_[code] + bwt_.rank(code, row);
+    }
+
+private:
+  [[nodiscard]]
+  static constexpr auto to_symbol(char_type c) noexcept -> symbol_type
+    {
+    return static_cast<symbol_type>(static_cast<std::make_unsigned_t<char_type>>(c));
+    }
+
+  [[nodiscard]]
+  constexpr auto alphabet_code(symbol_type symbol) const noexcept -> size_type
+    {
+    auto it{std::ranges::lower_bound(alphabet_, symbol)};
+    if(it == alphabet_.end() || *it != symbol)
+      return npos;
+    return static_cast<size_type>(std::ranges::distance(alphabet_.begin(), it));
+    }
+
+  ///\brief compacts \p symbols into alphabet codes and computes cumulative counts
+  constexpr void build_alphabet(small_vector<symbol_type, size_type> & symbols)
+    {
+    alphabet_.assign(symbols);
+    std::ranges::sort(alphabet_);
+    alphabet_.erase(std::unique(alphabet_.begin(), alphabet_.end()), alphabet_.end());
+    c_.resize(alphabet_.size() + 1u);
+    for(symbol_type & symbol: symbols)
+      {
+      symbol = alphabet_code(symbol);
+      ++c_[symbol + 1u];
+      }
+    for(size_type code{1u}; code != c_.size(); ++code)
+      c_[code] += c_[code - 1u];
+    }
+  };
+  }  // namespace small_vectors::inline v3_3::algo
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <small_vectors/utils/static_call_operator.h>
+#include <small_vectors/version.h>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <ranges>
+#include <type_traits>
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/// \brief Move-to-front transform of byte sequences
+namespace small_vectors::inline v3_3::algo::mtf
+  {
+namespace concepts
+  {
+  template<typename value_type>
+  concept byte_type = sizeof(value_type) == 1u
+                      && (std::integral<std::remove_const_t<value_type>>
+                          || std::same_as<std::remove_const_t<value_type>, std::byte>);
+  }
+
+namespace detail
+  {
+  ///\brief recency ordered table of all byte values, front holds most recently used symbol
+  ///\details search compares whole table with AVX2 or SSE2 equality masks, move to front of symbols within the first
+  /// vector register is a single lane shift and blend, deeper symbols fall back to memmove
+  struct table_t
+    {
+    alignas(32) std::array<uint8_t, 256> symbols;
+
+    constexpr table_t() noexcept { std::iota(symbols.begin(), symbols.end(), uint8_t{}); }
+
+    ///\returns position of \p symbol in table
+    [[nodiscard]]
+    constexpr auto find(uint8_t symbol) const noexcept -> uint8_t
+      {
+#if defined(__AVX2__)
+      if(!std::is_constant_evaluated())
+        {
+        __m256i const needle{_mm256_set1_epi8(static_cast<char>(symbol))};
+        for(uint32_t offset{}; offset != symbols.size(); offset += 32u)
+          {
+          small_vectors_clang_unsafe_buffer_usage_begin  //
+            __m256i const chunk{_mm256_load_si256(reinterpret_cast<__m256i const *>(symbols.data() + offset))};
+          small_vectors_clang_unsafe_buffer_usage_end  //
+            auto const mask{static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle)))};
+          if(mask != 0u)
+            return static_cast<uint8_t>(offset + static_cast<uint32_t>(std::countr_zero(mask)));
+          }
+        }
+#elif defined(__SSE2__)
+      if(!std::is_constant_evaluated())
+        {
+        __m128i const needle{_mm_set1_epi8(static_cast<char>(symbol))};
+        for(uint32_t offset{}; offset != symbols.size(); offset += 16u)
+          {
+          small_vectors_clang_unsafe_buffer_usage_begin  //
+            __m128i const chunk{_mm_load_si128(reinterpret_cast<__m128i const *>(symbols.data() + offset))};
+          small_vectors_clang_unsafe_buffer_usage_end  //
+            auto const mask{static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)))};
+          if(mask != 0u)
+            return static_cast<uint8_t>(offset + static_cast<uint32_t>(std::countr_zero(mask)));
+          }
+        }
+#endif
+      return static_cast<uint8_t>(std::ranges::distance(symbols.begin(), std::ranges::find(symbols, symbol)));
+      }
+
+    ///\brief moves symbol at \p index to the front
+    ///\returns moved symbol
+    constexpr auto move_to_front(uint8_t index) noexcept -> uint8_t
+      {
+      uint8_t const symbol{symbols[index]};
+#if defined(__AVX2__)
+      if(!std::is_constant_evaluated() && index < 32u)
+        {
+        auto * const front_ptr{reinterpret_cast<__m256i *>(symbols.data())};
+        __m256i const front{_mm256_load_si256(front_ptr)};
+        // shift by one byte across 128 bit lanes and put symbol into lane 0
+        __m256i const shifted{_mm256_or_si256(
+          _mm256_alignr_epi8(front, _mm256_permute2x128_si256(front, front, 0x08), 15),
+          _mm256_setr_epi32(symbol, 0, 0, 0, 0, 0, 0, 0)
+        )};
+        __m256i const lanes{_mm256_setr_m128i(
+          _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+          _mm_setr_epi8(16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31)
+        )};
+        __m256i const take{_mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(index + 1)), lanes)};
+        _mm256_store_si256(front_ptr, _mm256_blendv_epi8(front, shifted, take));
+        return symbol;
+        }
+#elif defined(__SSE2__)
+      if(!std::is_constant_evaluated() && index < 16u)
+        {
+        auto * const front_ptr{reinterpret_cast<__m128i *>(symbols.data())};
+        __m128i const front{_mm_load_si128(front_ptr)};
+        __m128i const shifted{_mm_or_si128(_mm_slli_si128(front, 1), _mm_cvtsi32_si128(symbol))};
+        __m128i const lanes{_mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15)};
+        __m128i const take{_mm_cmplt_epi8(lanes, _mm_set1_epi8(static_cast<char>(index + 1)))};
+        _mm_store_si128(front_ptr, _mm_or_si128(_mm_and_si128(take, shifted), _mm_andnot_si128(take, front)));
+        return symbol;
+        }
+#endif
+      auto const it{std::ranges::next(symbols.begin(), index)};
+      std::ranges::copy_backward(symbols.begin(), it, std::ranges::next(it));
+      symbols[0u] = symbol;
+      return symbol;
+      }
+    };
+  }  // namespace detail
+
+///\brief replaces every byte with its position in recency table, runs of equal bytes become runs of zeros
+struct encode_t
+  {
+  template<
+    std::input_iterator source_iterator,
+    std::sentinel_for<source_iterator> sentinel,
+    std::weakly_incrementable out_iterator>
+    requires concepts::byte_type<std::iter_value_t<source_iterator>> && std::indirectly_writable<out_iterator, uint8_t>
+  small_vector_static_call_operator constexpr auto
+    operator()(source_iterator beg, sentinel end, out_iterator out) small_vector_static_call_operator_const noexcept
+    -> out_iterator
+    {
+    detail::table_t table;
+    for(; beg != end; ++beg, ++out)
+      {
+      uint8_t const index{table.find(static_cast<uint8_t>(*beg))};
+      table.move_to_front(index);
+      *out = index;
+      }
+    return out;
+    }
+
+  template<std::ranges::input_range source_range, std::weakly_incrementable out_iterator>
+  small_vector_static_call_operator constexpr auto
+    operator()(source_range const & range, out_iterator out) small_vector_static_call_operator_const noexcept
+    {
+    return encode_t{}(std::ranges::begin(range), std::ranges::end(range), out);
+    }
+  };
+
+inline constexpr encode_t encode;
+
+///\brief inverse of encode, output may alias input
+struct decode_t
+  {
+  template<
+    std::input_iterator source_iterator,
+    std::sentinel_for<source_iterator> sentinel,
+    std::weakly_incrementable out_iterator>
+    requires concepts::byte_type<std::iter_value_t<source_iterator>> && std::indirectly_writable<out_iterator, uint8_t>
+  small_vector_static_call_operator constexpr auto
+    operator()(source_iterator beg, sentinel end, out_iterator out) small_vector_static_call_operator_const noexcept
+    -> out_iterator
+    {
+    detail::table_t table;
+    for(; beg != end; ++beg, ++out)
+      *out = table.move_to_front(static_cast<uint8_t>(*beg));
+    return out;
+    }
+
+  template<std::ranges::input_range source_range, std::weakly_incrementable out_iterator>
+  small_vector_static_call_operator constexpr auto
+    operator()(source_range const & range, out_iterator out) small_vector_static_call_operator_const noexcept
+    {
+    return decode_t{}(std::ranges::begin(range), std::ranges::end(range), out);
+    }
+  };
+
+inline constexpr decode_t decode;
+  }  // namespace small_vectors::inline v3_3::algo::mtf
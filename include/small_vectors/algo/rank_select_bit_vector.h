@@ -0,0 +1,290 @@
+#pragma once
+
+#include <small_vectors/small_vector.h>
+#include <small_vectors/utils/static_call_operator.h>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <span>
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+/// \brief Succinct data structures
+namespace small_vectors::inline v3_3::algo::succinct
+  {
+namespace detail
+  {
+  inline constexpr uint64_t ones_step_8{0x0101'0101'0101'0101ull};
+  inline constexpr uint64_t msbs_step_8{0x8080'8080'8080'8080ull};
+
+  ///\brief position of the \p rank -th (counting from 0) set bit in \p word, \p rank must be lower than popcount(word)
+  struct select_in_word_t
+    {
+    [[nodiscard]]
+    small_vector_static_call_operator constexpr auto
+      operator()(uint64_t word, uint32_t rank) small_vector_static_call_operator_const noexcept -> uint32_t
+      {
+#if defined(__BMI2__)
+      if(!std::is_constant_evaluated())
+        return static_cast<uint32_t>(std::countr_zero(_pdep_u64(uint64_t{1} << rank, word)));
+#endif
+      // broadword select, byte population counts summed into inclusive prefix sums per byte
+      uint64_t sums{word - ((word >> 1) & 0x5555'5555'5555'5555ull)};
+      sums = (sums & 0x3333'3333'3333'3333ull) + ((sums >> 2) & 0x3333'3333'3333'3333ull);
+      sums = ((sums + (sums >> 4)) & 0x0f0f'0f0f'0f0f'0f0full) * ones_step_8;
+      // prefix sums are monotonic so bytes with sum <= rank form a prefix of the word
+      uint64_t const le_mask{((rank * ones_step_8 | msbs_step_8) - sums) & msbs_step_8};
+      auto const bit_offset{static_cast<uint32_t>(std::popcount(le_mask) * 8)};
+      auto const ones_before{static_cast<uint32_t>(((sums << 8) >> bit_offset) & 0xffu)};
+      uint64_t byte{(word >> bit_offset) & 0xffu};
+      for(uint32_t remaining{rank - ones_before}; remaining != 0u; --remaining)
+        byte &= byte - 1u;
+      return bit_offset + static_cast<uint32_t>(std::countr_zero(byte));
+      }
+    };
+
+  inline constexpr select_in_word_t select_in_word;
+  }  // namespace detail
+
+///\brief immutable bit vector with constant time rank and fast select
+///\details layout is rank9 like, every 512 bit superblock is stored as 2 header words followed by 8 data words so rank
+/// touches single cache line pair, header holds absolute number of ones before superblock and seven 9 bit relative
+/// counts for words 1..7. Select uses sampled superblock hints, binary search over headers and in word select with
+/// pdep when BMI2 is available or broadword fallback
+struct rank_select_bit_vector
+  {
+  using size_type = uint32_t;
+  using storage_type = small_vector<uint64_t, size_type>;
+  using samples_type = small_vector<size_type, size_type>;
+
+  static constexpr size_type npos{std::numeric_limits<size_type>::max()};
+  static constexpr size_type word_bits{64u};
+  static constexpr size_type block_words{8u};
+  static constexpr size_type block_bits{word_bits * block_words};
+  static constexpr size_type header_words{2u};
+  static constexpr size_type block_stride{header_words + block_words};
+  static constexpr size_type select_sample_rate{4096u};
+
+  storage_type words_;
+  samples_type select1_samples_;
+  samples_type select0_samples_;
+  size_type size_{};
+  size_type ones_{};
+
+  constexpr rank_select_bit_vector() noexcept = default;
+
+  ///\brief constructs from \p bit_count bits packed lsb first into \p bits words
+  constexpr rank_select_bit_vector(std::span<uint64_t const> bits, size_type bit_count) :
+      words_(storage_size(bit_count))
+    {
+    size_type const word_count{(bit_count + word_bits - 1u) / word_bits};
+    for(size_type ix{}; ix != word_count; ++ix)
+      words_[data_index(ix)] = bits[ix];
+    if(size_type const tail{bit_count % word_bits}; tail != 0u)
+      words_[data_index(word_count - 1u)] &= (uint64_t{1} << tail) - 1u;
+    size_ = bit_count;
+    build_index();
+    }
+
+  ///\brief constructs from range of values convertible to bool
+  template<std::ranges::input_range bool_range>
+    requires std::convertible_to<std::ranges::range_value_t<bool_range>, bool>
+  explicit constexpr rank_select_bit_vector(bool_range const & range) :
+      words_(storage_size(static_cast<size_type>(std::ranges::distance(range))))
+    {
+    size_type pos{};
+    for(auto && value: range)
+      {
+      if(static_cast<bool>(value))
+        words_[data_index(pos / word_bits)] |= uint64_t{1} << (pos % word_bits);
+      ++pos;
+      }
+    size_ = pos;
+    build_index();
+    }
+
+  [[nodiscard]]
+  constexpr auto size() const noexcept -> size_type
+    {
+    return size_;
+    }
+
+  [[nodiscard]]
+  constexpr auto empty() const noexcept -> bool
+    {
+    return size_ == 0u;
+    }
+
+  [[nodiscard]]
+  constexpr auto count_ones() const noexcept -> size_type
+    {
+    return ones_;
+    }
+
+  [[nodiscard]]
+  constexpr auto count_zeros() const noexcept -> size_type
+    {
+    return size_ - ones_;
+    }
+
+  [[nodiscard]]
+  constexpr auto operator[](size_type pos) const noexcept -> bool
+    {
+    return ((words_[data_index(pos / word_bits)] >> (pos % word_bits)) & 1u) != 0u;
+    }
+
+  ///\returns number of set bits in range [0, pos), pos must be <= size()
+  [[nodiscard]]
+  constexpr auto rank1(size_type pos) const noexcept -> size_type
+    {
+    size_type const block{pos / block_bits};
+    size_type const word{(pos / word_bits) % block_words};
+    size_type const header{block * block_stride};
+    uint64_t const relative{word != 0u ? (words_[header + 1u] >> (9u * (word - 1u))) & 0x1ffu : 0u};
+    uint64_t const mask{(uint64_t{1} << (pos % word_bits)) - 1u};
+    uint64_t const data{words_[header + header_words + word]};
+    return static_cast<size_type>(words_[header] + relative + static_cast<uint64_t>(std::popcount(data & mask)));
+    }
+
+  ///\returns number of unset bits in range [0, pos), pos must be <= size()
+  [[nodiscard]]
+  constexpr auto rank0(size_type pos) const noexcept -> size_type
+    {
+    return pos - rank1(pos);
+    }
+
+  template<bool bit>
+  [[nodiscard]]
+  constexpr auto rank(size_type pos) const noexcept -> size_type
+    {
+    if constexpr(bit)
+      return rank1(pos);
+    else
+      return rank0(pos);
+    }
+
+  ///\returns position of the \p k -th (counting from 0) set bit or npos when there is no such bit
+  [[nodiscard]]
+  constexpr auto select1(size_type k) const noexcept -> size_type
+    {
+    return select<true>(k);
+    }
+
+  ///\returns position of the \p k -th (counting from 0) unset bit or npos when there is no such bit
+  [[nodiscard]]
+  constexpr auto select0(size_type k) const noexcept -> size_type
+    {
+    return select<false>(k);
+    }
+
+  template<bool bit>
+  [[nodiscard]]
+  constexpr auto select(size_type k) const noexcept -> size_type
+    {
+    if(k >= (bit ? count_ones() : count_zeros())) [[unlikely]]
+      return npos;
+
+    samples_type const & samples{bit ? select1_samples_ : select0_samples_};
+    size_type const sample{k / select_sample_rate};
+    size_type lo{samples[sample]};
+    size_type hi{
+      sample + 1u < samples.size() ? static_cast<size_type>(samples[sample + 1u] + 1u) : block_count()
+    };
+    // last superblock with count before it <= k
+    while(hi - lo > 1u)
+      {
+      size_type const mid{lo + (hi - lo) / 2u};
+      if(block_rank<bit>(mid) <= k)
+        lo = mid;
+      else
+        hi = mid;
+      }
+    size_type const header{lo * block_stride};
+    size_type rank_in_block{k - block_rank<bit>(lo)};
+    uint64_t const relative{words_[header + 1u]};
+    size_type word{};
+    size_type counted{};
+    for(size_type next{1u}; next != block_words; ++next)
+      {
+      auto const ones{static_cast<size_type>((relative >> (9u * (next - 1u))) & 0x1ffu)};
+      size_type const count{bit ? ones : next * word_bits - ones};
+      if(count > rank_in_block)
+        break;
+      word = next;
+      counted = count;
+      }
+    rank_in_block -= counted;
+    uint64_t const data{words_[header + header_words + word]};
+    return lo * block_bits + word * word_bits + detail::select_in_word(bit ? data : ~data, rank_in_block);
+    }
+
+private:
+  [[nodiscard]]
+  static constexpr auto storage_size(size_type bit_count) noexcept -> size_type
+    {
+    return (bit_count / block_bits + 1u) * block_stride;
+    }
+
+  [[nodiscard]]
+  static constexpr auto data_index(size_type word_index) noexcept -> size_type
+    {
+    return (word_index / block_words) * block_stride + header_words + word_index % block_words;
+    }
+
+  [[nodiscard]]
+  constexpr auto block_count() const noexcept -> size_type
+    {
+    return static_cast<size_type>(words_.size() / block_stride);
+    }
+
+  template<bool bit>
+  [[nodiscard]]
+  constexpr auto block_rank(size_type block) const noexcept -> size_type
+    {
+    auto const ones{static_cast<size_type>(words_[block * block_stride])};
+    if constexpr(bit)
+      return ones;
+    else
+      return block * block_bits - ones;
+    }
+
+  constexpr void build_index()
+    {
+    uint64_t total{};
+    size_type next_one_sample{};
+    size_type next_zero_sample{};
+    // there is always one block more than needed for data allowing rank(size()) without branching
+    for(size_type block{}, blocks{block_count()}; block != blocks; ++block)
+      {
+      size_type const header{block * block_stride};
+      words_[header] = total;
+      uint64_t relative{};
+      uint64_t in_block{};
+      for(size_type word{}; word != block_words; ++word)
+        {
+        if(word != 0u)
+          relative |= in_block << (9u * (word - 1u));
+        in_block += static_cast<uint64_t>(std::popcount(words_[header + header_words + word]));
+        }
+      words_[header + 1u] = relative;
+
+      // sample superblocks containing every select_sample_rate-th set and unset bit, zero padding past size() is
+      // sampled too but never reached as select checks k against count of bits
+      for(; next_one_sample < total + in_block; next_one_sample += select_sample_rate)
+        select1_samples_.push_back(block);
+      size_type const zeros_end{static_cast<size_type>((block + 1u) * block_bits - (total + in_block))};
+      for(; next_zero_sample < zeros_end; next_zero_sample += select_sample_rate)
+        select0_samples_.push_back(block);
+      total += in_block;
+      }
+    ones_ = static_cast<size_type>(total);
+    if(select1_samples_.empty())
+      select1_samples_.push_back(0u);
+    if(select0_samples_.empty())
+      select0_samples_.push_back(0u);
+    }
+  };
+  }  // namespace small_vectors::inline v3_3::algo::succinct
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <small_vectors/algo/mtf.h>
+#include <small_vectors/utils/expected.h>
+#include <small_vectors/utils/static_call_operator.h>
+#include <small_vectors/version.h>
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+/// \brief Zero run length coding of move-to-front output
+/// \details runs of zeros are written as bijective base 2 numbers with digits run_a = 1 and run_b = 2 least
+/// significant first, every other byte value v is written as v + 1, so output alphabet has 257 symbols
+namespace small_vectors::inline v3_3::algo::rle
+  {
+using symbol_type = uint16_t;
+
+inline constexpr symbol_type run_a{0u};
+inline constexpr symbol_type run_b{1u};
+inline constexpr uint32_t alphabet_size{257u};
+
+enum struct decode_error_e : uint8_t
+  {
+  output_overflow,
+  /// symbol outside of alphabet
+  corrupted
+  };
+
+namespace detail
+  {
+  ///\returns number of leading zero bytes in \p data
+  template<mtf::concepts::byte_type value_type>
+  [[nodiscard]]
+  constexpr auto zero_run_length(std::span<value_type const> data) noexcept -> std::size_t
+    {
+    std::size_t pos{};
+#if defined(__AVX2__)
+    if(!std::is_constant_evaluated())
+      for(; data.size() - pos >= 32u; pos += 32u)
+        {
+        small_vectors_clang_unsafe_buffer_usage_begin  //
+          __m256i const chunk{_mm256_loadu_si256(reinterpret_cast<__m256i const *>(data.data() + pos))};
+        small_vectors_clang_unsafe_buffer_usage_end  //
+          auto const non_zero{
+            ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, _mm256_setzero_si256())))
+          };
+        if(non_zero != 0u)
+          return pos + static_cast<std::size_t>(std::countr_zero(non_zero));
+        }
+#endif
+#if defined(__SSE2__)
+    if(!std::is_constant_evaluated())
+      for(; data.size() - pos >= 16u; pos += 16u)
+        {
+        small_vectors_clang_unsafe_buffer_usage_begin  //
+          __m128i const chunk{_mm_loadu_si128(reinterpret_cast<__m128i const *>(data.data() + pos))};
+        small_vectors_clang_unsafe_buffer_usage_end  //
+          auto const non_zero{
+            ~static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_setzero_si128()))) & 0xffffu
+          };
+        if(non_zero != 0u)
+          return pos + static_cast<std::size_t>(std::countr_zero(non_zero));
+        }
+#endif
+    for(; pos != data.size() && static_cast<uint8_t>(data[pos]) == 0u; ++pos)
+      ;
+    return pos;
+    }
+  }  // namespace detail
+
+struct encode_t
+  {
+  template<
+    std::contiguous_iterator source_iterator,
+    std::sized_sentinel_for<source_iterator> sentinel,
+    std::weakly_incrementable out_iterator>
+    requires mtf::concepts::byte_type<std::iter_value_t<source_iterator>>
+             && std::indirectly_writable<out_iterator, symbol_type>
+  small_vector_static_call_operator constexpr auto
+    operator()(source_iterator beg, sentinel end, out_iterator out) small_vector_static_call_operator_const noexcept
+    -> out_iterator
+    {
+    using value_type = std::iter_value_t<source_iterator>;
+    small_vectors_clang_unsafe_buffer_usage_begin  //
+      std::span<value_type const> const data{std::to_address(beg), static_cast<std::size_t>(end - beg)};
+    small_vectors_clang_unsafe_buffer_usage_end  //
+    for(std::size_t pos{}; pos != data.size();)
+      {
+      if(auto const value{static_cast<uint8_t>(data[pos])}; value != 0u)
+        {
+        *out = static_cast<symbol_type>(value + 1u);
+        ++out;
+        ++pos;
+        continue;
+        }
+      std::size_t run{detail::zero_run_length(data.subspan(pos))};
+      pos += run;
+      for(; run != 0u; run = (run - 1u) >> 1u, ++out)
+        *out = (run & 1u) != 0u ? run_a : run_b;
+      }
+    return out;
+    }
+
+  template<std::ranges::contiguous_range source_range, std::weakly_incrementable out_iterator>
+  small_vector_static_call_operator constexpr auto
+    operator()(source_range const & range, out_iterator out) small_vector_static_call_operator_const noexcept
+    {
+    return encode_t{}(std::ranges::begin(range), std::ranges::end(range), out);
+    }
+  };
+
+inline constexpr encode_t encode;
+
+struct decode_t
+  {
+  ///\brief decodes symbols into \p out
+  ///\returns number of bytes written or decode_error_e::output_overflow when decoded data does not fit into \p out,
+  /// decode_error_e::corrupted for symbol outside of alphabet
+  template<std::input_iterator source_iterator, std::sentinel_for<source_iterator> sentinel>
+    requires std::convertible_to<std::iter_value_t<source_iterator>, symbol_type>
+  small_vector_static_call_operator constexpr auto operator()(
+    source_iterator beg, sentinel end, std::span<uint8_t> out
+  ) small_vector_static_call_operator_const noexcept -> cxx23::expected<std::size_t, decode_error_e>
+    {
+    std::size_t pos{};
+    uint64_t run{};
+    uint64_t weight{1u};
+    auto const flush_run = [&]() noexcept -> bool
+    {
+      if(run > out.size() - pos) [[unlikely]]
+        return false;
+      std::ranges::fill_n(
+        std::ranges::next(out.begin(), static_cast<std::ptrdiff_t>(pos)), static_cast<std::ptrdiff_t>(run), uint8_t{}
+      );
+      pos += static_cast<std::size_t>(run);
+      run = 0u;
+      weight = 1u;
+      return true;
+    };
+    for(; beg != end; ++beg)
+      {
+      auto const value{*beg};
+      if constexpr(std::integral<std::iter_value_t<source_iterator>>)
+        if(!std::in_range<symbol_type>(value)) [[unlikely]]
+          return cxx23::unexpected{decode_error_e::corrupted};
+      auto const symbol{static_cast<symbol_type>(value)};
+      if(symbol >= alphabet_size) [[unlikely]]
+        return cxx23::unexpected{decode_error_e::corrupted};
+      if(symbol <= run_b)
+        {
+        if(weight > out.size()) [[unlikely]]
+          return cxx23::unexpected{decode_error_e::output_overflow};
+        run += symbol == run_a ? weight : weight << 1u;
+        weight <<= 1u;
+        }
+      else
+        {
+        if(!flush_run() || pos == out.size()) [[unlikely]]
+          return cxx23::unexpected{decode_error_e::output_overflow};
+        out[pos++] = static_cast<uint8_t>(symbol - 1u);
+        }
+      }
+    if(!flush_run()) [[unlikely]]
+      return cxx23::unexpected{decode_error_e::output_overflow};
+    return pos;
+    }
+
+  template<std::ranges::input_range source_range>
+  small_vector_static_call_operator constexpr auto
+    operator()(source_range const & range, std::span<uint8_t> out) small_vector_static_call_operator_const noexcept
+    -> cxx23::expected<std::size_t, decode_error_e>
+    {
+    return decode_t{}(std::ranges::begin(range), std::ranges::end(range), out);
+    }
+  };
+
+inline constexpr decode_t decode;
+  }  // namespace small_vectors::inline v3_3::algo::rle
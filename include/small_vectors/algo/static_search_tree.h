@@ -0,0 +1,154 @@
+#pragma once
+
+#include <small_vectors/algo/branchless_lower_bound.h>
+#include <small_vectors/small_vector.h>
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <type_traits>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace small_vectors::inline v3_3::algo::lower_bound
+  {
+namespace concepts
+  {
+  template<typename value_type>
+  concept search_tree_key = std::integral<value_type> || std::floating_point<value_type>;
+  }
+
+///\brief static B-tree (S-tree) with implicit node links over arithmetic keys
+///\details every node is one cache line of keys, node k has children k * (node_keys + 1) + i + 1 so search touches
+/// log(node_keys + 1) n cache lines instead of log2 n. Rank of key in node is counted with AVX2 compare and movemask
+/// for 32 bit integers and with branchless counting loop otherwise. Last node is padded with numeric_limits::max()
+/// keys which never compare less than searched value
+template<concepts::search_tree_key KeyType>
+struct static_search_tree
+  {
+  using value_type = KeyType;
+  using size_type = uint32_t;
+
+  static constexpr size_type node_keys{static_cast<size_type>(64u / sizeof(value_type))};
+
+  small_vector<value_type, size_type> keys_;
+  /// sorted position of every key slot, size() for padding
+  small_vector<size_type, size_type> ranks_;
+  size_type size_{};
+
+  constexpr static_search_tree() noexcept = default;
+
+  template<std::ranges::random_access_range sorted_range>
+    requires std::convertible_to<std::ranges::range_reference_t<sorted_range>, value_type>
+  explicit constexpr static_search_tree(sorted_range const & sorted) :
+      size_{static_cast<size_type>(std::ranges::size(sorted))}
+    {
+    size_type const nodes{node_count()};
+    keys_.resize(nodes * node_keys);
+    ranks_.resize(nodes * node_keys);
+    size_type rank{};
+    build(sorted, rank, 0u);
+    }
+
+  [[nodiscard]]
+  constexpr auto size() const noexcept -> size_type
+    {
+    return size_;
+    }
+
+  ///\returns position in source sorted range of first element not less than \p v or size() when there is no such
+  [[nodiscard]]
+  constexpr auto lower_bound_index(value_type v) const noexcept -> size_type
+    {
+    std::size_t const nodes{node_count()};
+    // slot of best candidate, rank is read once after descent to keep ranks out of cache during search
+    std::size_t slot{nodes * node_keys};
+    value_type const * data{keys_.data()};
+    for(std::size_t node{}; node < nodes;)
+      {
+      std::size_t const offset{node * node_keys};
+      small_vectors_clang_unsafe_buffer_usage_begin  //
+        size_type const i{rank_in_node(data + offset, v)};
+      small_vectors_clang_unsafe_buffer_usage_end  //
+        if(i != node_keys)
+          slot = offset + i;
+      node = node * (node_keys + 1u) + i + 1u;
+      }
+    return slot != nodes * node_keys ? ranks_[slot] : size_;
+    }
+
+  ///\brief lower_bound over source range [first, last) the tree was built from
+  template<std::random_access_iterator iterator, std::sentinel_for<iterator> sentinel>
+  [[nodiscard]]
+  constexpr auto operator()(iterator first, sentinel, value_type v) const noexcept -> iterator
+    {
+    return std::ranges::next(first, static_cast<std::iter_difference_t<iterator>>(lower_bound_index(v)));
+    }
+
+private:
+  [[nodiscard]]
+  constexpr auto node_count() const noexcept -> size_type
+    {
+    return (size_ + node_keys - 1u) / node_keys;
+    }
+
+  ///\returns number of keys in node lower than \p v
+  [[nodiscard]]
+  static constexpr auto rank_in_node(value_type const * node, value_type v) noexcept -> size_type
+    {
+#if defined(__AVX2__)
+    if constexpr(std::integral<value_type> && sizeof(value_type) == 4u)
+      if(!std::is_constant_evaluated())
+        {
+        // unsigned keys are compared as signed after flipping sign bit
+        int const bias{std::is_signed_v<value_type> ? 0 : std::numeric_limits<int>::min()};
+        __m256i const flip{_mm256_set1_epi32(bias)};
+        __m256i const needle{_mm256_xor_si256(_mm256_set1_epi32(static_cast<int>(v)), flip)};
+        small_vectors_clang_unsafe_buffer_usage_begin  //
+          __m256i const lo{_mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(node)), flip)};
+        __m256i const hi{_mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(node + 8)), flip)};
+        small_vectors_clang_unsafe_buffer_usage_end  //
+          auto const mask_lo{_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(needle, lo)))};
+        auto const mask_hi{_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(needle, hi)))};
+        return static_cast<size_type>(std::popcount(static_cast<uint32_t>(mask_lo | (mask_hi << 8))));
+        }
+#endif
+    size_type count{};
+    small_vectors_clang_unsafe_buffer_usage_begin  //
+      for(size_type ix{}; ix != node_keys; ++ix)
+        count += node[ix] < v ? 1u : 0u;
+    small_vectors_clang_unsafe_buffer_usage_end  //
+      return count;
+    }
+
+  template<typename sorted_range>
+  constexpr void build(sorted_range const & sorted, size_type & rank, std::size_t node)
+    {
+    if(node >= node_count())
+      return;
+    for(size_type ix{}; ix != node_keys; ++ix)
+      {
+      build(sorted, rank, node * (node_keys + 1u) + ix + 1u);
+      std::size_t const slot{node * node_keys + ix};
+      if(rank < size_)
+        {
+        keys_[slot] = static_cast<value_type>(std::ranges::begin(sorted)[rank]);
+        ranks_[slot] = rank++;
+        }
+      else
+        {
+        keys_[slot] = std::numeric_limits<value_type>::max();
+        ranks_[slot] = size_;
+        }
+      }
+    build(sorted, rank, node * (node_keys + 1u) + node_keys + 1u);
+    }
+  };
+
+template<std::ranges::random_access_range sorted_range>
+static_search_tree(sorted_range const &) -> static_search_tree<std::ranges::range_value_t<sorted_range>>;
+  }  // namespace small_vectors::inline v3_3::algo::lower_bound
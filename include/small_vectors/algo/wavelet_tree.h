@@ -0,0 +1,182 @@
+#pragma once
+
+#include <small_vectors/algo/rank_select_bit_vector.h>
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <ranges>
+
+/// \brief Succinct data structures
+namespace small_vectors::inline v3_3::algo::succinct
+  {
+///\brief pointerless wavelet tree over integer alphabet in levelwise (wavelet matrix) layout
+///\details every level holds one rank_select_bit_vector of the symbol bit at that level, sequence is stably
+/// partitioned by the bit before next level so access and rank are O(levels) rank operations and select is O(levels)
+/// select operations, levels are the bit width of the largest symbol
+struct wavelet_tree
+  {
+  using size_type = rank_select_bit_vector::size_type;
+  using symbol_type = uint32_t;
+  using level_type = rank_select_bit_vector;
+
+  static constexpr size_type npos{rank_select_bit_vector::npos};
+
+  small_vector<level_type, size_type> levels_;
+  small_vector<size_type, size_type> zeros_;
+  size_type size_{};
+
+  constexpr wavelet_tree() noexcept = default;
+
+  template<std::ranges::input_range symbol_range>
+    requires std::integral<std::ranges::range_value_t<symbol_range>>
+  explicit constexpr wavelet_tree(symbol_range const & symbols)
+    {
+    small_vector<symbol_type, size_type> current;
+    for(auto && symbol: symbols)
+      current.push_back(static_cast<symbol_type>(symbol));
+    size_ = current.size();
+
+    symbol_type const max_symbol{current.empty() ? symbol_type{} : *std::ranges::max_element(current)};
+    size_type const level_count{std::max(size_type{1u}, static_cast<size_type>(std::bit_width(max_symbol)))};
+    levels_.reserve(level_count);
+    zeros_.reserve(level_count);
+
+    small_vector<symbol_type, size_type> next(size_);
+    small_vector<bool, size_type> bits(size_);
+    for(size_type level{}; level != level_count; ++level)
+      {
+      size_type const shift{level_count - 1u - level};
+      std::ranges::transform(
+        current, std::ranges::begin(bits), [shift](symbol_type s) noexcept { return ((s >> shift) & 1u) != 0u; }
+      );
+      levels_.emplace_back(bits);
+      size_type const zeros{levels_.back().count_zeros()};
+      zeros_.push_back(zeros);
+      // stable partition zeros first
+      size_type zix{};
+      size_type oix{zeros};
+      for(symbol_type s: current)
+        if(((s >> shift) & 1u) != 0u)
+          next[oix++] = s;
+        else
+          next[zix++] = s;
+      current.swap(next);
+      }
+    }
+
+  [[nodiscard]]
+  constexpr auto size() const noexcept -> size_type
+    {
+    return size_;
+    }
+
+  [[nodiscard]]
+  constexpr auto empty() const noexcept -> bool
+    {
+    return size_ == 0u;
+    }
+
+  [[nodiscard]]
+  constexpr auto level_count() const noexcept -> size_type
+    {
+    return levels_.size();
+    }
+
+  ///\returns symbol at position \p pos
+  [[nodiscard]]
+  constexpr auto access(size_type pos) const noexcept -> symbol_type
+    {
+    symbol_type symbol{};
+    for(size_type level{}; level != levels_.size(); ++level)
+      {
+      level_type const & bv{levels_[level]};
+      bool const bit{bv[pos]};
+      symbol = static_cast<symbol_type>((symbol << 1u) | (bit ? 1u : 0u));
+      pos = bit ? zeros_[level] + bv.rank1(pos) : bv.rank0(pos);
+      }
+    return symbol;
+    }
+
+  [[nodiscard]]
+  constexpr auto operator[](size_type pos) const noexcept -> symbol_type
+    {
+    return access(pos);
+    }
+
+  ///\returns number of occurrences of \p symbol in range [0, pos)
+  [[nodiscard]]
+  constexpr auto rank(symbol_type symbol, size_type pos) const noexcept -> size_type
+    {
+    if(!fits(symbol)) [[unlikely]]
+      return 0u;
+    size_type first{};
+    for(size_type level{}; level != levels_.size(); ++level)
+      {
+      level_type const & bv{levels_[level]};
+      if(bit_at(symbol, level))
+        {
+        first = zeros_[level] + bv.rank1(first);
+        pos = zeros_[level] + bv.rank1(pos);
+        }
+      else
+        {
+        first = bv.rank0(first);
+        pos = bv.rank0(pos);
+        }
+      }
+    return pos - first;
+    }
+
+  ///\returns position of the \p k -th (counting from 0) occurrence of \p symbol or npos when there is no such
+  [[nodiscard]]
+  constexpr auto select(symbol_type symbol, size_type k) const noexcept -> size_type
+    {
+    if(!fits(symbol) || empty()) [[unlikely]]
+      return npos;
+    // start of the symbol bucket at the last level
+    size_type first{};
+    size_type last{size_};
+    for(size_type level{}; level != levels_.size(); ++level)
+      {
+      level_type const & bv{levels_[level]};
+      if(bit_at(symbol, level))
+        {
+        first = zeros_[level] + bv.rank1(first);
+        last = zeros_[level] + bv.rank1(last);
+        }
+      else
+        {
+        first = bv.rank0(first);
+        last = bv.rank0(last);
+        }
+      }
+    if(k >= last - first)
+      return npos;
+
+    size_type pos{first + k};
+    for(size_type level{levels_.size()}; level != 0u; --level)
+      {
+      level_type const & bv{levels_[level - 1u]};
+      if(bit_at(symbol, level - 1u))
+        pos = bv.select1(pos - zeros_[level - 1u]);
+      else
+        pos = bv.select0(pos);
+      }
+    return pos;
+    }
+
+private:
+  [[nodiscard]]
+  constexpr auto fits(symbol_type symbol) const noexcept -> bool
+    {
+    return static_cast<size_type>(std::bit_width(symbol)) <= levels_.size();
+    }
+
+  [[nodiscard]]
+  constexpr auto bit_at(symbol_type symbol, size_type level) const noexcept -> bool
+    {
+    return ((symbol >> (levels_.size() - 1u - level)) & 1u) != 0u;
+    }
+  };
+  }  // namespace small_vectors::inline v3_3::algo::succinct
@@ -4,9 +4,13 @@
 #include <small_vectors/concepts/concepts.h>
 #include <small_vectors/concepts/integral_or_byte.h>
 #include <small_vectors/detail/adapter_iterator.h>
+#include <small_vectors/detail/string_search.h>
+#include <small_vectors/utils/hash.h>
+#include <small_vectors/utils/static_call_operator.h>
 #include <string_view>
 #include <algorithm>
 #include <array>
+#include <functional>
 
 namespace small_vectors::inline v3_3
   {
@@ -149,6 +153,50 @@ basic_fixed_string
 
   constexpr operator std::basic_string_view<char_type>() const noexcept { return {&data_[0], N}; }
 
+  [[nodiscard]]
+  constexpr auto find(char_type ch, std::size_t pos = 0u) const noexcept -> std::size_t
+    {
+    return detail::string::search_char(view(), ch, pos);
+    }
+
+  [[nodiscard]]
+  constexpr auto find(std::basic_string_view<char_type> s, std::size_t pos = 0u) const noexcept -> std::size_t
+    {
+    return detail::string::search(view(), s, pos);
+    }
+
+  ///\brief finds first occurrence of \p s at or after \p pos ignoring case of ASCII letters
+  [[nodiscard]]
+  constexpr auto find_icase(std::basic_string_view<char_type> s, std::size_t pos = 0u) const noexcept -> std::size_t
+    {
+    return detail::string::search_icase(view(), s, pos);
+    }
+
+  [[nodiscard]]
+  constexpr auto find_first_of(std::basic_string_view<char_type> s, std::size_t pos = 0u) const noexcept
+    -> std::size_t
+    {
+    return detail::string::search_first_of(view(), s, pos);
+    }
+
+  [[nodiscard]]
+  constexpr auto contains(char_type ch) const noexcept -> bool
+    {
+    return find(ch) != std::basic_string_view<char_type>::npos;
+    }
+
+  [[nodiscard]]
+  constexpr auto contains(std::basic_string_view<char_type> s) const noexcept -> bool
+    {
+    return find(s) != std::basic_string_view<char_type>::npos;
+    }
+
+  [[nodiscard]]
+  constexpr auto contains_icase(std::basic_string_view<char_type> s) const noexcept -> bool
+    {
+    return find_icase(s) != std::basic_string_view<char_type>::npos;
+    }
+
   constexpr auto operator<=>(basic_fixed_string<char_type, N> const &) const noexcept = default;
 
   template<std::size_t M>
@@ -204,3 +252,17 @@ inline consteval auto cast_fixed_string(char_type const (&str)[N]) noexcept -> b
   }
 
   }  // namespace small_vectors::inline v3_3
+
+namespace std
+  {
+template<typename char_type, std::size_t N>
+struct hash<small_vectors::basic_fixed_string<char_type, N>>
+  {
+  small_vector_static_call_operator inline constexpr auto operator()(
+    small_vectors::basic_fixed_string<char_type, N> const & str
+  ) small_vector_static_call_operator_const noexcept -> std::size_t
+    {
+    return static_cast<std::size_t>(small_vectors::utils::wyhash(str.view()));
+    }
+  };
+  }  // namespace std
@@ -24,10 +24,17 @@
 #include <small_vectors/detail/vector_storage.h>
 #include <small_vectors/detail/vector_func.h>
 #include <small_vectors/detail/string_func.h>
+#include <small_vectors/detail/string_search.h>
+#include <small_vectors/utils/hash.h>
 #include <small_vectors/detail/adapter_iterator.h>
 #include <small_vectors/ranges/accumulate.h>
+#include <algorithm>
+#include <array>
+#include <functional>
 #include <numeric>
 #include <compare>
+#include <span>
+#include <utility>
 
 namespace small_vectors::inline v3_3
   {
@@ -496,27 +503,43 @@ basic_string_t
 
   inline constexpr auto contains(std::convertible_to<view_type> auto const & s) const noexcept -> bool
     {
-    return view().find(static_cast<view_type>(s)) != view_type::npos;
+    return detail::string::search(view(), static_cast<view_type>(s)) != view_type::npos;
     }
 
-  inline constexpr auto contains(char_type ch) const noexcept -> bool { return view().find(ch) != view_type::npos; }
+  inline constexpr auto contains(char_type ch) const noexcept -> bool
+    {
+    return detail::string::search_char(view(), ch) != view_type::npos;
+    }
+
+  ///\brief checks if string contains \p s ignoring case of ASCII letters
+  inline constexpr auto contains_icase(std::convertible_to<view_type> auto const & s) const noexcept -> bool
+    {
+    return detail::string::search_icase(view(), static_cast<view_type>(s)) != view_type::npos;
+    }
 
   inline constexpr auto find(char_type ch, size_type pos = 0u) const noexcept -> size_type
     {
-    return static_cast<size_type>(view().find(ch, pos));
+    return static_cast<size_type>(detail::string::search_char(view(), ch, pos));
     }
 
   inline constexpr auto find(std::convertible_to<view_type> auto const & s, size_type pos = 0u) const noexcept
     -> size_type
     {
-    return static_cast<size_type>(view().find(static_cast<view_type>(s), pos));
+    return static_cast<size_type>(detail::string::search(view(), static_cast<view_type>(s), pos));
     }
 
   inline constexpr auto
     find(std::convertible_to<view_type> auto const & s, size_type pos, size_type count) const noexcept -> size_type
     {
     auto vs{static_cast<view_type>(s).substr(0u, count)};
-    return static_cast<size_type>(view().find(vs, pos));
+    return static_cast<size_type>(detail::string::search(view(), vs, pos));
+    }
+
+  ///\brief finds first occurrence of \p s at or after \p pos ignoring case of ASCII letters
+  inline constexpr auto find_icase(std::convertible_to<view_type> auto const & s, size_type pos = 0u) const noexcept
+    -> size_type
+    {
+    return static_cast<size_type>(detail::string::search_icase(view(), static_cast<view_type>(s), pos));
     }
 
   inline constexpr auto rfind(char_type ch, size_type pos = npos) const noexcept -> size_type
@@ -551,7 +574,7 @@ basic_string_t
   inline constexpr auto find_first_of(std::convertible_to<view_type> auto const & v, size_type pos = 0u) const noexcept
     -> size_type
     {
-    return static_cast<size_type>(view().find_first_of(static_cast<view_type>(v), pos));
+    return static_cast<size_type>(detail::string::search_first_of(view(), static_cast<view_type>(v), pos));
     }
 
   constexpr auto replace(size_type pos, size_type count, std::convertible_to<view_type> auto const & v)
@@ -595,25 +618,116 @@ basic_string_t
     return replace(pos, count, count2, ch);
     }
 
-  ///\brief replaces all occurrences of \ref what with \ref with
+  ///\returns true when \p v points into characters of this string, conservatively true for any non empty \p v during
+  /// constant evaluation where pointers to unrelated objects can not be ordered
+  [[nodiscard]]
+  inline constexpr auto overlaps(view_type v) const noexcept -> bool
+    {
+    if(v.empty())
+      return false;
+    if(std::is_constant_evaluated())
+      return true;
+    std::less<char_type const *> const less;
+    small_vectors_clang_unsafe_buffer_usage_begin  //
+      return less(v.data(), data() + size()) && less(data(), v.data() + v.size());
+    small_vectors_clang_unsafe_buffer_usage_end  //
+    }
+
+  ///\brief replaces all non overlapping occurrences of \ref what with \ref with scanning from the beginning
+  ///\details matches are counted first and string is resized at most once and rewritten in single pass. \p what and
+  /// \p with may view this string, they are copied before rewrite then
+  ///\returns number of replacements
   inline constexpr auto
     find_and_replace(std::convertible_to<view_type> auto const & what, std::convertible_to<view_type> auto const & with)
       -> size_type
     {
-    size_type const what_size = static_cast<size_type>(what.size());
-    size_type const with_size = static_cast<size_type>(with.size());
-    size_type replacments_count{};
-    if(what_size != 0)
+    view_type const what_view{static_cast<view_type>(what)};
+    view_type const with_view{static_cast<view_type>(with)};
+    if(what_view.empty())
+      return 0u;
+    if(overlaps(what_view) || overlaps(with_view)) [[unlikely]]
       {
-      size_type fpos = find(what, 0);
-      while(fpos != npos)
-        {
-        replace(fpos, what_size, with);
-        ++replacments_count;
-        fpos = find(what, static_cast<size_type>(fpos + with_size));
-        }
+      // only views into this string are copied, they fit its capacity
+      basic_string_t what_copy;
+      basic_string_t with_copy;
+      if(overlaps(what_view))
+        what_copy = what_view;
+      if(overlaps(with_view))
+        with_copy = with_view;
+      return find_and_replace(
+        overlaps(what_view) ? what_copy.view() : what_view, overlaps(with_view) ? with_copy.view() : with_view
+      );
       }
-    return replacments_count;
+    return detail::string::find_and_replace(
+      storage_,
+      [what_view, with_view](view_type text, size_type from) noexcept
+      {
+        return detail::string::replace_match_t<char_type, size_type>{
+          static_cast<size_type>(detail::string::search(text, what_view, from)),
+          static_cast<size_type>(what_view.size()),
+          with_view
+        };
+      }
+    );
+    }
+
+  ///\brief replaces all non overlapping occurrences of every pattern with its replacement in single pass
+  ///\details at every position the earliest match wins and among matches at the same position the first pattern in
+  /// \p replacements, replacements are not searched for further matches, empty patterns are ignored. Patterns viewing
+  /// this string are copied before rewrite
+  ///\returns number of replacements
+  template<std::size_t pattern_count>
+  inline constexpr auto find_and_replace(std::pair<view_type, view_type> const (&replacements)[pattern_count])
+    -> size_type
+    {
+    return find_and_replace(std::span<std::pair<view_type, view_type> const, pattern_count>{replacements});
+    }
+
+  template<std::size_t pattern_count>
+  inline constexpr auto find_and_replace(std::span<std::pair<view_type, view_type> const, pattern_count> patterns)
+    -> size_type
+    {
+    auto const views_this{[this](std::pair<view_type, view_type> const & pattern) noexcept
+                          { return overlaps(pattern.first) || overlaps(pattern.second); }};
+    if(std::ranges::any_of(patterns, views_this)) [[unlikely]]
+      {
+      // only views into this string are copied, they fit its capacity
+      std::array<basic_string_t, pattern_count * 2u> copies;
+      std::array<std::pair<view_type, view_type>, pattern_count> copied;
+      auto copy_if_overlaps{[this](view_type v, basic_string_t & copy) -> view_type
+                            {
+                              if(!overlaps(v))
+                                return v;
+                              copy = v;
+                              return copy.view();
+                            }};
+      for(std::size_t ix{}; ix != pattern_count; ++ix)
+        copied[ix] = {
+          copy_if_overlaps(patterns[ix].first, copies[ix * 2u]),
+          copy_if_overlaps(patterns[ix].second, copies[ix * 2u + 1u])
+        };
+      return find_and_replace(std::span<std::pair<view_type, view_type> const, pattern_count>{copied});
+      }
+    // next occurrence of every pattern, valid while not behind search position, reset when pass starts from 0
+    std::array<size_type, pattern_count> next{};
+    return detail::string::find_and_replace(
+      storage_,
+      [patterns, &next](view_type text, size_type from) noexcept
+      {
+        detail::string::replace_match_t<char_type, size_type> best{npos, 0u, {}};
+        for(std::size_t ix{}; ix != pattern_count; ++ix)
+          {
+          auto const & [what, with]{patterns[ix]};
+          if(what.empty())
+            continue;
+          if(from == 0u || (next[ix] != npos && next[ix] < from))
+            next[ix] = static_cast<size_type>(detail::string::search(text, what, from));
+          if(next[ix] < best.pos)
+            best = {next[ix], static_cast<size_type>(what.size()), with};
+          }
+        return best;
+      }
+    );
     }
 
   inline constexpr void swap(basic_string_t & other) noexcept { detail::string::swap(storage_, other.storage_); }
@@ -731,19 +845,48 @@ inline constexpr void swap(basic_string_t<V, N, T> & lhs, basic_string_t<V, N, T
   lhs.swap(rhs);
   }
 
+///\brief wyhash of string content, same value in constant evaluation and at run time
 template<typename V, uint64_t N, typename T>
-inline constexpr auto hash(basic_string_t<V, N, T> const & str) noexcept
+inline constexpr auto hash(basic_string_t<V, N, T> const & str) noexcept -> std::size_t
   {
-  using char_type = V;
-  if(std::is_constant_evaluated())
-    return small_vectors::ranges::accumulate(
-      str,
-      std::size_t{5381},
-      [](std::size_t init, char_type c) noexcept { return init * (c ? static_cast<std::size_t>(c) + 33 : 5381); }
-    );
-  else
-    return std::hash<std::basic_string_view<V>>()(str.view());
+  return static_cast<std::size_t>(utils::wyhash(str.view()));
   }
+
+///\brief transparent hasher for unordered containers with basic_string_t or basic_fixed_string keys
+///\details hashes any text convertible to basic_string_view so containers can be probed with views or literals
+/// without constructing temporary key, produces same values as std::hash of basic_string_t and basic_fixed_string
+template<typename char_type>
+struct basic_string_hash
+  {
+  using is_transparent = void;
+
+  small_vector_static_call_operator constexpr auto operator()(std::basic_string_view<char_type> text
+  ) small_vector_static_call_operator_const noexcept -> std::size_t
+    {
+    return static_cast<std::size_t>(utils::wyhash(text));
+    }
+  };
+
+///\brief transparent equality for unordered containers used together with basic_string_hash
+template<typename char_type>
+struct basic_string_equal
+  {
+  using is_transparent = void;
+
+  small_vector_static_call_operator constexpr auto operator()(
+    std::basic_string_view<char_type> l, std::basic_string_view<char_type> r
+  ) small_vector_static_call_operator_const noexcept -> bool
+    {
+    return l == r;
+    }
+  };
+
+using string_hash = basic_string_hash<char>;
+using string_equal = basic_string_equal<char>;
+using u8string_hash = basic_string_hash<char8_t>;
+using u8string_equal = basic_string_equal<char8_t>;
+using wstring_hash = basic_string_hash<wchar_t>;
+using wstring_equal = basic_string_equal<wchar_t>;
   }  // namespace small_vectors::inline v3_3
 
 namespace std
@@ -0,0 +1,525 @@
+#pragma once
+
+#include <small_vectors/version.h>
+#include <small_vectors/detail/adapter_iterator.h>
+#include <small_vectors/detail/string_search.h>
+#include <small_vectors/detail/vector_func.h>
+#include <small_vectors/utils/hash.h>
+#include <small_vectors/utils/static_call_operator.h>
+#include <algorithm>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+namespace small_vectors::inline v3_3
+  {
+///\brief string occupying three pointers with inline storage using every byte of the object
+///\details layout follows fbstring, inline form keeps characters from the first byte and the last code unit holds
+/// remaining inline capacity, which becomes 0 and so null terminator when inline buffer is full. Heap form stores data
+/// pointer and size in the same bytes and marks last code unit with value that is never valid remaining capacity,
+/// capacity of heap form is stored in header in front of allocated characters. With 8 byte pointers string holds 23
+/// chars inline in 24 bytes. Object has no self references so it is trivially relocatable and move is a byte copy.
+/// Bytes of pointer can not be reinterpreted in constant evaluation so unlike basic_string this class is not constexpr
+template<typename CharType>
+class [[clang::trivial_abi]] basic_compact_string
+  {
+public:
+  using value_type = CharType;
+  using char_type = value_type;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using view_type = std::basic_string_view<char_type>;
+  using traits_type = std::char_traits<char_type>;
+  using iterator = detail::adapter_iterator<char_type *>;
+  using const_iterator = detail::adapter_iterator<char_type const *>;
+
+  static constexpr size_type npos{view_type::npos};
+
+private:
+  static constexpr size_type inline_units{3u * sizeof(void *) / sizeof(char_type)};
+  static constexpr size_type marker_index{inline_units - 1u};
+  static constexpr char_type heap_marker{static_cast<char_type>(inline_units)};
+  /// code units in front of heap characters holding allocation capacity
+  static constexpr size_type header_units{(sizeof(size_type) + sizeof(char_type) - 1u) / sizeof(char_type)};
+
+  static_assert(inline_units >= 2u && inline_units < 128u);
+  static_assert(sizeof(char_type *) + sizeof(size_type) < inline_units * sizeof(char_type));
+
+  alignas(char_type *) char_type buffer_[inline_units]{};
+
+public:
+  ///\returns number of characters stored without allocation
+  [[nodiscard]]
+  static constexpr auto inline_capacity() noexcept -> size_type
+    {
+    return inline_units - 1u;
+    }
+
+  basic_compact_string() noexcept { set_inline_size(0u); }
+
+  explicit basic_compact_string(view_type s) : basic_compact_string() { assign(s); }
+
+  basic_compact_string(char_type const * s) : basic_compact_string(view_type{s}) {}
+
+  ///\brief Constructs the string with count copies of character ch
+  basic_compact_string(size_type count, char_type ch) : basic_compact_string() { resize(count, ch); }
+
+  basic_compact_string(basic_compact_string const & rh) : basic_compact_string(rh.view()) {}
+
+  basic_compact_string(basic_compact_string && rh) noexcept
+    {
+    std::memcpy(buffer_, rh.buffer_, sizeof(buffer_));
+    rh.set_inline_size(0u);
+    }
+
+  ~basic_compact_string() { release(); }
+
+  auto operator=(basic_compact_string const & rh) -> basic_compact_string & { return assign(rh.view()); }
+
+  auto operator=(basic_compact_string && rh) noexcept -> basic_compact_string &
+    {
+    if(this != &rh)
+      {
+      release();
+      std::memcpy(buffer_, rh.buffer_, sizeof(buffer_));
+      rh.set_inline_size(0u);
+      }
+    return *this;
+    }
+
+  auto operator=(view_type s) -> basic_compact_string & { return assign(s); }
+
+  [[nodiscard]]
+  auto is_inline() const noexcept -> bool
+    {
+    small_vectors_clang_unsafe_buffer_usage_begin  //
+      return buffer_[marker_index] != heap_marker;
+    small_vectors_clang_unsafe_buffer_usage_end  //
+    }
+
+  [[nodiscard]]
+  auto size() const noexcept -> size_type
+    {
+    if(is_inline())
+      {
+      small_vectors_clang_unsafe_buffer_usage_begin  //
+        return inline_capacity() - static_cast<size_type>(buffer_[marker_index]);
+      small_vectors_clang_unsafe_buffer_usage_end  //
+      }
+    return heap_size();
+    }
+
+  [[nodiscard]]
+  auto length() const noexcept -> size_type
+    {
+    return size();
+    }
+
+  [[nodiscard]]
+  auto empty() const noexcept -> bool
+    {
+    return size() == 0u;
+    }
+
+  [[nodiscard]]
+  auto capacity() const noexcept -> size_type
+    {
+    return is_inline() ? inline_capacity() : heap_capacity(heap_data());
+    }
+
+  [[nodiscard]]
+  auto data() noexcept -> char_type *
+    {
+    return is_inline() ? &buffer_[0] : heap_data();
+    }
+
+  [[nodiscard]]
+  auto data() const noexcept -> char_type const *
+    {
+    return is_inline() ? &buffer_[0] : heap_data();
+    }
+
+  [[nodiscard]]
+  auto c_str() const noexcept -> char_type const *
+    {
+    return data();
+    }
+
+  [[nodiscard]]
+  auto view() const noexcept -> view_type
+    {
+    return view_type{data(), size()};
+    }
+
+  operator view_type() const noexcept { return view(); }
+
+  [[nodiscard]]
+  auto begin() noexcept -> iterator
+    {
+    return iterator{data()};
+    }
+
+  [[nodiscard]]
+  auto begin() const noexcept -> const_iterator
+    {
+    return const_iterator{data()};
+    }
+
+  [[nodiscard]]
+  auto cbegin() const noexcept -> const_iterator
+    {
+    return begin();
+    }
+
+  [[nodiscard]]
+  auto end() noexcept -> iterator
+    {
+    small_vectors_clang_unsafe_buffer_usage_begin  //
+      return iterator{data() + size()};
+    small_vectors_clang_unsafe_buffer_usage_end  //
+    }
+
+  [[nodiscard]]
+  auto end() const noexcept -> const_iterator
+    {
+    small_vectors_clang_unsafe_buffer_usage_begin  //
+      return const_iterator{data() + size()};
+    small_vectors_clang_unsafe_buffer_usage_end  //
+    }
+
+  [[nodiscard]]
+  auto cend() const noexcept -> const_iterator
+    {
+    return end();
+    }
+
+  [[nodiscard]]
+  auto operator[](size_type index) noexcept -> char_type &
+    {
+    small_vectors_clang_unsafe_buffer_usage_begin  //
+      return data()[index];
+    small_vectors_clang_unsafe_buffer_usage_end  //
+    }
+
+  [[nodiscard]]
+  auto operator[](size_type index) const noexcept -> char_type const &
+    {
+    small_vectors_clang_unsafe_buffer_usage_begin  //
+      return data()[index];
+    small_vectors_clang_unsafe_buffer_usage_end  //
+    }
+
+  [[nodiscard]]
+  auto front() const noexcept -> char_type
+    {
+    return *data();
+    }
+
+  [[nodiscard]]
+  auto back() const noexcept -> char_type
+    {
+    return (*this)[size() - 1u];
+    }
+
+  [[nodiscard]]
+  auto find(view_type s, size_type pos = 0u) const noexcept -> size_type
+    {
+    return detail::string::search(view(), s, pos);
+    }
+
+  [[nodiscard]]
+  auto contains(view_type s) const noexcept -> bool
+    {
+    return find(s) != npos;
+    }
+
+  [[nodiscard]]
+  auto starts_with(view_type s) const noexcept -> bool
+    {
+    return view().starts_with(s);
+    }
+
+  [[nodiscard]]
+  auto ends_with(view_type s) const noexcept -> bool
+    {
+    return view().ends_with(s);
+    }
+
+  ///\brief ensures capacity of at least \p new_capacity characters, never shrinks
+  void reserve(size_type new_capacity)
+    {
+    if(new_capacity > capacity())
+      reallocate(new_capacity);
+    }
+
+  ///\brief moves heap content back to inline storage when it fits or trims allocation to size
+  void shrink_to_fit()
+    {
+    if(is_inline() || heap_capacity(heap_data()) == heap_size())
+      return;
+    char_type * const old{heap_data()};
+    size_type const count{heap_size()};
+    if(count <= inline_capacity())
+      {
+      traits_type::copy(&buffer_[0], old, count);
+      set_inline_size(count);
+      }
+    else
+      {
+      char_type * const fresh{allocate(count)};
+      traits_type::copy(fresh, old, count);
+      set_heap(fresh, count);
+      }
+    deallocate(old);
+    }
+
+  void clear() noexcept { set_size(0u); }
+
+  void resize(size_type count, char_type ch = char_type{})
+    {
+    size_type const old_size{size()};
+    if(count > old_size)
+      {
+      reserve_for(count);
+      small_vectors_clang_unsafe_buffer_usage_begin  //
+        traits_type::assign(data() + old_size, count - old_size, ch);
+      small_vectors_clang_unsafe_buffer_usage_end  //
+      }
+    set_size(count);
+    }
+
+  void push_back(char_type ch)
+    {
+    size_type const old_size{size()};
+    reserve_for(old_size + 1u);
+    small_vectors_clang_unsafe_buffer_usage_begin  //
+      data()[old_size] = ch;
+    small_vectors_clang_unsafe_buffer_usage_end  //
+      set_size(old_size + 1u);
+    }
+
+  void pop_back() noexcept { set_size(size() - 1u); }
+
+  auto assign(view_type s) -> basic_compact_string &
+    {
+    if(s.size() <= capacity())
+      {
+      // source may be part of this string
+      traits_type::move(data(), s.data(), s.size());
+      set_size(s.size());
+      }
+    else
+      {
+      char_type * const fresh{allocate(s.size())};
+      traits_type::copy(fresh, s.data(), s.size());
+      release();
+      set_heap(fresh, s.size());
+      }
+    return *this;
+    }
+
+  auto append(view_type s) -> basic_compact_string &
+    {
+    size_type const old_size{size()};
+    size_type const new_size{old_size + s.size()};
+    if(new_size <= capacity())
+      {
+      small_vectors_clang_unsafe_buffer_usage_begin  //
+        traits_type::copy(data() + old_size, s.data(), s.size());
+      small_vectors_clang_unsafe_buffer_usage_end  //
+        set_size(new_size);
+      }
+    else
+      {
+      // old buffer is released after copy as s may be part of this string
+      char_type * const fresh{allocate(grown_capacity(new_size))};
+      traits_type::copy(fresh, data(), old_size);
+      small_vectors_clang_unsafe_buffer_usage_begin  //
+        traits_type::copy(fresh + old_size, s.data(), s.size());
+      small_vectors_clang_unsafe_buffer_usage_end  //
+        release();
+      set_heap(fresh, new_size);
+      }
+    return *this;
+    }
+
+  auto operator+=(view_type s) -> basic_compact_string & { return append(s); }
+
+  auto operator+=(char_type ch) -> basic_compact_string &
+    {
+    push_back(ch);
+    return *this;
+    }
+
+  void swap(basic_compact_string & other) noexcept
+    {
+    char_type tmp[inline_units];
+    std::memcpy(tmp, buffer_, sizeof(buffer_));
+    std::memcpy(buffer_, other.buffer_, sizeof(buffer_));
+    std::memcpy(other.buffer_, tmp, sizeof(buffer_));
+    }
+
+  [[nodiscard]]
+  friend auto operator==(basic_compact_string const & l, basic_compact_string const & r) noexcept -> bool
+    {
+    return l.view() == r.view();
+    }
+
+  [[nodiscard]]
+  friend auto operator==(basic_compact_string const & l, std::convertible_to<view_type> auto const & r) noexcept
+    -> bool
+    {
+    return l.view() == static_cast<view_type>(r);
+    }
+
+  [[nodiscard]]
+  friend auto operator<=>(basic_compact_string const & l, basic_compact_string const & r) noexcept
+    {
+    return l.view() <=> r.view();
+    }
+
+  [[nodiscard]]
+  friend auto operator<=>(basic_compact_string const & l, std::convertible_to<view_type> auto const & r) noexcept
+    {
+    return l.view() <=> static_cast<view_type>(r);
+    }
+
+private:
+  void set_inline_size(size_type count) noexcept
+    {
+    small_vectors_clang_unsafe_buffer_usage_begin  //
+      if(count != inline_capacity())
+        buffer_[count] = char_type{};
+    buffer_[marker_index] = static_cast<char_type>(inline_capacity() - count);
+    small_vectors_clang_unsafe_buffer_usage_end  //
+    }
+
+  void set_heap(char_type * heap, size_type count) noexcept
+    {
+    small_vectors_clang_unsafe_buffer_usage_begin  //
+      heap[count] = char_type{};
+    std::memcpy(&buffer_[0], &heap, sizeof(heap));
+    std::memcpy(reinterpret_cast<std::byte *>(&buffer_[0]) + sizeof(heap), &count, sizeof(count));
+    buffer_[marker_index] = heap_marker;
+    small_vectors_clang_unsafe_buffer_usage_end  //
+    }
+
+  void set_size(size_type count) noexcept
+    {
+    if(is_inline())
+      set_inline_size(count);
+    else
+      set_heap(heap_data(), count);
+    }
+
+  [[nodiscard]]
+  auto heap_data() const noexcept -> char_type *
+    {
+    char_type * heap;
+    std::memcpy(&heap, &buffer_[0], sizeof(heap));
+    return heap;
+    }
+
+  [[nodiscard]]
+  auto heap_size() const noexcept -> size_type
+    {
+    size_type count;
+    small_vectors_clang_unsafe_buffer_usage_begin  //
+      std::memcpy(&count, reinterpret_cast<std::byte const *>(&buffer_[0]) + sizeof(char_type *), sizeof(count));
+    small_vectors_clang_unsafe_buffer_usage_end  //
+      return count;
+    }
+
+  [[nodiscard]]
+  static auto heap_capacity(char_type const * heap) noexcept -> size_type
+    {
+    size_type result;
+    small_vectors_clang_unsafe_buffer_usage_begin  //
+      std::memcpy(&result, heap - header_units, sizeof(result));
+    small_vectors_clang_unsafe_buffer_usage_end  //
+      return result;
+    }
+
+  ///\returns characters of new allocation with room for \p count characters and null terminator
+  [[nodiscard]]
+  static auto allocate(size_type count) -> char_type *
+    {
+    char_type * const block{std::allocator<char_type>{}.allocate(header_units + count + 1u)};
+    std::memcpy(block, &count, sizeof(count));
+    small_vectors_clang_unsafe_buffer_usage_begin  //
+      return block + header_units;
+    small_vectors_clang_unsafe_buffer_usage_end  //
+    }
+
+  static void deallocate(char_type * heap) noexcept
+    {
+    size_type const count{heap_capacity(heap)};
+    small_vectors_clang_unsafe_buffer_usage_begin  //
+      std::allocator<char_type>{}.deallocate(heap - header_units, header_units + count + 1u);
+    small_vectors_clang_unsafe_buffer_usage_end  //
+    }
+
+  void release() noexcept
+    {
+    if(!is_inline())
+      deallocate(heap_data());
+    }
+
+  void reallocate(size_type new_capacity)
+    {
+    size_type const count{size()};
+    char_type * const fresh{allocate(new_capacity)};
+    traits_type::copy(fresh, data(), count);
+    release();
+    set_heap(fresh, count);
+    }
+
+  [[nodiscard]]
+  auto grown_capacity(size_type required) const -> size_type
+    {
+    size_type const old_size{size()};
+    size_type const new_capacity{detail::growth(old_size, static_cast<size_type>(required - old_size))};
+    if(new_capacity == 0u) [[unlikely]]
+      throw std::length_error{"Out of buffer space"};
+    return new_capacity;
+    }
+
+  ///\brief grows capacity with growth factor when \p required characters do not fit
+  void reserve_for(size_type required)
+    {
+    if(required > capacity())
+      reallocate(grown_capacity(required));
+    }
+  };
+
+using compact_string = basic_compact_string<char>;
+using u8compact_string = basic_compact_string<char8_t>;
+using u16compact_string = basic_compact_string<char16_t>;
+using u32compact_string = basic_compact_string<char32_t>;
+using wcompact_string = basic_compact_string<wchar_t>;
+
+template<typename char_type>
+inline void swap(basic_compact_string<char_type> & l, basic_compact_string<char_type> & r) noexcept
+  {
+  l.swap(r);
+  }
+  }  // namespace small_vectors::inline v3_3
+
+namespace std
+  {
+template<typename char_type>
+struct hash<small_vectors::basic_compact_string<char_type>>
+  {
+  small_vector_static_call_operator inline auto operator()(small_vectors::basic_compact_string<char_type> const & str
+  ) small_vector_static_call_operator_const noexcept -> std::size_t
+    {
+    return static_cast<std::size_t>(small_vectors::utils::wyhash(str.view()));
+    }
+  };
+  }  // namespace std
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <small_vectors/basic_string.h>
+#include <small_vectors/utils/static_call_operator.h>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+namespace small_vectors::inline v3_3
+  {
+namespace detail::concat
+  {
+  template<typename value_type>
+  concept character
+    = std::same_as<value_type, char> || std::same_as<value_type, wchar_t> || std::same_as<value_type, char8_t>
+      || std::same_as<value_type, char16_t> || std::same_as<value_type, char32_t>;
+
+  ///\brief integers are written in decimal, character types and bool are excluded
+  template<typename value_type>
+  concept integer = std::integral<value_type> && !std::same_as<value_type, bool> && !character<value_type>;
+
+  template<typename value_type, typename char_type>
+  concept argument = std::same_as<value_type, char_type>
+                     || std::convertible_to<value_type const &, std::basic_string_view<char_type>>
+                     || integer<value_type>;
+
+  template<integer value_type>
+  [[nodiscard]]
+  inline constexpr auto magnitude(value_type value) noexcept
+    {
+    using unsigned_type = std::make_unsigned_t<value_type>;
+    auto const result{static_cast<unsigned_type>(value)};
+    if constexpr(std::is_signed_v<value_type>)
+      if(value < 0)
+        return static_cast<unsigned_type>(unsigned_type{} - result);
+    return result;
+    }
+
+  template<std::unsigned_integral value_type>
+  [[nodiscard]]
+  inline constexpr auto decimal_digits(value_type value) noexcept -> std::size_t
+    {
+    std::size_t digits{1u};
+    for(; value >= 10u; value /= 10u)
+      ++digits;
+    return digits;
+    }
+
+  ///\returns number of characters \p arg contributes to result
+  template<typename char_type>
+  struct length_t
+    {
+    template<argument<char_type> value_type>
+    small_vector_static_call_operator inline constexpr auto operator()(value_type const & arg
+    ) small_vector_static_call_operator_const noexcept -> std::size_t
+      {
+      if constexpr(std::same_as<value_type, char_type>)
+        return 1u;
+      else if constexpr(std::convertible_to<value_type const &, std::basic_string_view<char_type>>)
+        return static_cast<std::basic_string_view<char_type>>(arg).size();
+      else
+        return decimal_digits(magnitude(arg)) + (std::is_signed_v<value_type> && arg < 0 ? 1u : 0u);
+      }
+    };
+
+  ///\brief writes \p arg at \p out and returns position past written characters
+  template<typename char_type>
+  struct write_t
+    {
+    template<argument<char_type> value_type>
+    small_vector_static_call_operator inline constexpr auto operator()(char_type * out, value_type const & arg
+    ) small_vector_static_call_operator_const noexcept -> char_type *
+      {
+      small_vectors_clang_unsafe_buffer_usage_begin  //
+        if constexpr(std::same_as<value_type, char_type>)
+        {
+        *out = arg;
+        return out + 1;
+        }
+      else if constexpr(std::convertible_to<value_type const &, std::basic_string_view<char_type>>)
+        {
+        auto const text{static_cast<std::basic_string_view<char_type>>(arg)};
+        std::char_traits<char_type>::copy(out, text.data(), text.size());
+        return out + text.size();
+        }
+      else
+        {
+        if constexpr(std::is_signed_v<value_type>)
+          if(arg < 0)
+            *out++ = char_type('-');
+        auto value{magnitude(arg)};
+        char_type * const last{out + decimal_digits(value)};
+        char_type * it{last};
+        do
+          {
+          *--it = static_cast<char_type>(char_type('0') + static_cast<char_type>(value % 10u));
+          value /= 10u;
+          } while(value != 0u);
+        return last;
+        }
+      small_vectors_clang_unsafe_buffer_usage_end  //
+      }
+    };
+
+  ///\brief appends all \p args to \p target growing it at most once
+  struct append_all_t
+    {
+    template<typename string_type, typename... args_type>
+    small_vector_static_call_operator inline constexpr void operator()(
+      string_type & target, args_type const &... args
+    ) small_vector_static_call_operator_const
+      {
+      using char_type = typename string_type::value_type;
+      using size_type = typename string_type::size_type;
+      std::size_t const old_size{target.size()};
+      std::size_t const new_size{old_size + (std::size_t{} + ... + length_t<char_type>{}(args))};
+      if(new_size > std::size_t{std::numeric_limits<size_type>::max()}) [[unlikely]]
+        throw std::length_error{"Out of buffer space"};
+      // old buffer stays valid until op returns so arguments may refer to target itself
+      target.resize_and_overwrite(
+        static_cast<size_type>(new_size),
+        [old_size, new_size, &args...](char_type * data, size_type) noexcept -> size_type
+        {
+          small_vectors_clang_unsafe_buffer_usage_begin  //
+            [[maybe_unused]] char_type * out{data + old_size};
+          small_vectors_clang_unsafe_buffer_usage_end  //
+            ((out = write_t<char_type>{}(out, args)), ...);
+          return static_cast<size_type>(new_size);
+        }
+      );
+      }
+    };
+
+  inline constexpr append_all_t append_all;
+  }  // namespace detail::concat
+
+///\brief concatenates strings, views, characters and integers into new string with single allocation
+///\details total length is computed first, then result is sized once with resize_and_overwrite and every argument is
+/// written directly into final buffer, integers in decimal. Replacement for chains like a + "/" + b + ".log" which
+/// materialize intermediate strings
+template<typename string_type = string, typename... args_type>
+  requires(detail::concat::argument<args_type, typename string_type::value_type> && ...)
+[[nodiscard]]
+inline constexpr auto concat(args_type const &... args) -> string_type
+  {
+  string_type result;
+  detail::concat::append_all(result, args...);
+  return result;
+  }
+
+///\brief appends concatenation of \p args to \p target growing it at most once
+template<typename string_type, typename... args_type>
+  requires(detail::concat::argument<args_type, typename string_type::value_type> && ...)
+inline constexpr auto concat_append(string_type & target, args_type const &... args) -> string_type &
+  {
+  detail::concat::append_all(target, args...);
+  return target;
+  }
+  }  // namespace small_vectors::inline v3_3
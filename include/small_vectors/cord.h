@@ -0,0 +1,265 @@
+#pragma once
+
+#include <small_vectors/basic_string.h>
+#include <small_vectors/small_vector.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ranges>
+#include <string_view>
+#include <utility>
+
+namespace small_vectors::inline v3_3
+  {
+///\brief rope of reference counted string chunks for building and slicing large text without copying
+///\details cord is list of views into shared chunks, every chunk is basic_string owned by shared_ptr. Appending owned
+/// string moves it into new chunk, appending short view copies it into tail chunk while the tail is owned only by
+/// this cord, longer views get own chunk. Copy of cord and substr share chunks and only adjust views. chunks() exposes
+/// views in order for scatter gather output and flatten() joins them into one string with single allocation
+template<typename CharType>
+class basic_cord
+  {
+public:
+  using char_type = CharType;
+  using view_type = std::basic_string_view<char_type>;
+  using string_type = basic_string<char_type>;
+  using size_type = std::size_t;
+
+  static constexpr size_type npos{view_type::npos};
+  /// views up to this size are copied into tail chunk instead of creating new one
+  static constexpr size_type small_append_limit{512u};
+  /// capacity reserved for tail chunk collecting small appends
+  static constexpr size_type tail_chunk_capacity{4096u};
+
+private:
+  struct piece_t
+    {
+    std::shared_ptr<string_type> owner;
+    view_type text;
+    };
+
+  small_vector<piece_t, uint32_t, 4> pieces_;
+  size_type size_{};
+
+public:
+  basic_cord() noexcept = default;
+
+  explicit basic_cord(view_type text) { append(text); }
+
+  explicit basic_cord(string_type && text) { append(std::move(text)); }
+
+  [[nodiscard]]
+  auto size() const noexcept -> size_type
+    {
+    return size_;
+    }
+
+  [[nodiscard]]
+  auto empty() const noexcept -> bool
+    {
+    return size_ == 0u;
+    }
+
+  [[nodiscard]]
+  auto chunk_count() const noexcept -> size_type
+    {
+    return pieces_.size();
+    }
+
+  ///\returns range of views of consecutive chunks, suitable for building iovec array for writev
+  [[nodiscard]]
+  auto chunks() const noexcept
+    {
+    return std::views::transform(pieces_, [](piece_t const & piece) noexcept -> view_type { return piece.text; });
+    }
+
+  void clear() noexcept
+    {
+    pieces_.clear();
+    size_ = 0u;
+    }
+
+  ///\brief appends \p text taking ownership of its buffer without copying characters
+  auto append(string_type && text) -> basic_cord &
+    {
+    if(!text.empty())
+      {
+      auto owner{std::make_shared<string_type>(std::move(text))};
+      view_type const view{owner->view()};
+      pieces_.emplace_back(std::move(owner), view);
+      size_ += view.size();
+      }
+    return *this;
+    }
+
+  ///\brief appends copy of \p text, short text is gathered in tail chunk
+  auto append(view_type text) -> basic_cord &
+    {
+    if(text.empty())
+      return *this;
+    if(text.size() <= small_append_limit && can_extend_tail(text))
+      {
+      piece_t & tail{pieces_.back()};
+      string_type & owner{*tail.owner};
+      auto const offset{static_cast<size_type>(tail.text.data() - owner.data())};
+      owner.append(text);
+      small_vectors_clang_unsafe_buffer_usage_begin  //
+        tail.text = view_type{owner.data() + offset, tail.text.size() + text.size()};
+      small_vectors_clang_unsafe_buffer_usage_end  //
+      }
+    else
+      {
+      string_type chunk;
+      if(text.size() <= small_append_limit)
+        chunk.reserve(static_cast<typename string_type::size_type>(tail_chunk_capacity));
+      chunk.append(text);
+      auto owner{std::make_shared<string_type>(std::move(chunk))};
+      view_type const view{owner->view()};
+      pieces_.emplace_back(std::move(owner), view);
+      }
+    size_ += text.size();
+    return *this;
+    }
+
+  ///\brief appends chunks of \p other sharing them without copying characters
+  auto append(basic_cord const & other) -> basic_cord &
+    {
+    // other may be this cord
+    auto const count{other.pieces_.size()};
+    size_type const other_size{other.size_};
+    pieces_.reserve(static_cast<uint32_t>(pieces_.size() + count));
+    for(uint32_t ix{}; ix != count; ++ix)
+      pieces_.emplace_back(other.pieces_[ix]);
+    size_ += other_size;
+    return *this;
+    }
+
+  auto operator+=(view_type text) -> basic_cord & { return append(text); }
+
+  auto operator+=(string_type && text) -> basic_cord & { return append(std::move(text)); }
+
+  auto operator+=(basic_cord const & other) -> basic_cord & { return append(other); }
+
+  ///\returns cord sharing chunks of this one viewing [pos, pos + count)
+  [[nodiscard]]
+  auto substr(size_type pos, size_type count = npos) const -> basic_cord
+    {
+    basic_cord result;
+    if(pos >= size_)
+      return result;
+    count = std::min(count, size_ - pos);
+    result.size_ = count;
+    for(piece_t const & piece: pieces_)
+      {
+      if(count == 0u)
+        break;
+      if(pos >= piece.text.size())
+        {
+        pos -= piece.text.size();
+        continue;
+        }
+      view_type const part{piece.text.substr(pos, count)};
+      result.pieces_.emplace_back(piece.owner, part);
+      count -= part.size();
+      pos = 0u;
+      }
+    return result;
+    }
+
+  ///\returns character at \p index
+  [[nodiscard]]
+  auto operator[](size_type index) const noexcept -> char_type
+    {
+    for(piece_t const & piece: pieces_)
+      {
+      if(index < piece.text.size())
+        return piece.text[index];
+      index -= piece.text.size();
+      }
+    return char_type{};
+    }
+
+  ///\brief joins all chunks into single string allocated once
+  template<typename result_type = string_type>
+  [[nodiscard]]
+  auto flatten() const -> result_type
+    {
+    result_type result;
+    using result_size_type = typename result_type::size_type;
+    result.resize_and_overwrite(
+      static_cast<result_size_type>(size_),
+      [this](char_type * out, result_size_type) noexcept -> result_size_type
+      {
+        for(piece_t const & piece: pieces_)
+          out = std::ranges::copy(piece.text, out).out;
+        return static_cast<result_size_type>(size_);
+      }
+    );
+    return result;
+    }
+
+  [[nodiscard]]
+  friend auto operator==(basic_cord const & l, view_type r) noexcept -> bool
+    {
+    if(l.size_ != r.size())
+      return false;
+    for(piece_t const & piece: l.pieces_)
+      {
+      if(!r.starts_with(piece.text))
+        return false;
+      r.remove_prefix(piece.text.size());
+      }
+    return true;
+    }
+
+  [[nodiscard]]
+  friend auto operator==(basic_cord const & l, basic_cord const & r) noexcept -> bool
+    {
+    if(l.size_ != r.size_)
+      return false;
+    // walk both chunk lists comparing overlapping parts
+    auto rit{r.pieces_.begin()};
+    view_type rtext{};
+    for(piece_t const & piece: l.pieces_)
+      {
+      view_type ltext{piece.text};
+      while(!ltext.empty())
+        {
+        if(rtext.empty())
+          rtext = (rit++)->text;
+        size_type const common{std::min(ltext.size(), rtext.size())};
+        if(ltext.substr(0u, common) != rtext.substr(0u, common))
+          return false;
+        ltext.remove_prefix(common);
+        rtext.remove_prefix(common);
+        }
+      }
+    return true;
+    }
+
+private:
+  [[nodiscard]]
+  auto can_extend_tail(view_type text) const noexcept -> bool
+    {
+    if(pieces_.empty())
+      return false;
+    piece_t const & tail{pieces_.back()};
+    string_type const & owner{*tail.owner};
+    std::less<char_type const *> const less;
+    small_vectors_clang_unsafe_buffer_usage_begin  //
+      char_type const * const owner_end{owner.data() + owner.size()};
+    bool const aliases_owner{!less(text.data(), owner.data()) && less(text.data(), owner.data() + owner.capacity())};
+    small_vectors_clang_unsafe_buffer_usage_end  //
+      // tail chunk must not be visible to other cords, its view must end at the end of chunk and growth must not
+      // reallocate
+      return tail.owner.use_count() == 1 && tail.text.data() + tail.text.size() == owner_end && !aliases_owner
+             && owner.size() + text.size() <= owner.capacity();
+    }
+  };
+
+using cord = basic_cord<char>;
+using u8cord = basic_cord<char8_t>;
+using wcord = basic_cord<wchar_t>;
+  }  // namespace small_vectors::inline v3_3
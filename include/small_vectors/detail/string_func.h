@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <string_view>
 #include <iterator>
+#include <limits>
 #include <ranges>
 #include <small_vectors/utils/static_call_operator.h>
 
@@ -794,5 +795,82 @@ struct pop_back_t
 
 inline constexpr pop_back_t pop_back;
 
+//-------------------------------------------------------------------------------------------------------------------
+///\brief match reported to find_and_replace, pos is numeric_limits<size_type>::max() when there are no more matches
+template<typename char_type, typename size_type>
+struct replace_match_t
+  {
+  size_type pos;
+  size_type length;
+  std::basic_string_view<char_type> replacement;
+  };
+
+struct find_and_replace_t
+  {
+  ///\brief replaces non overlapping matches reported by \p next_match(text, from) scanning left to right
+  ///\details first pass computes final size and the largest growth of any prefix, string is resized once to old size
+  /// plus that growth, content is moved to the end and rewritten front to back so write position never passes read
+  /// position, next_match is called again from position 0 for the second pass. Replacements reported by next_match must
+  /// not view \p storage as it is rewritten in place, basic_string::find_and_replace copies such arguments first
+  ///\returns number of replacements
+  template<detail_concepts::vector_storage vector_storage, typename matcher_type>
+  small_vector_static_call_operator inline constexpr auto operator()(
+    vector_storage & storage, matcher_type next_match
+  ) small_vector_static_call_operator_const -> typename vector_storage::size_type
+    {
+    using char_type = typename vector_storage::value_type;
+    using size_type = typename vector_storage::size_type;
+    using view_type = std::basic_string_view<char_type>;
+    constexpr size_type npos{std::numeric_limits<size_type>::max()};
+
+    size_type const old_size{storage.size_};
+    size_type count{};
+    size_type read{};
+    size_type written{};
+    size_type shift{};
+      {
+      view_type const text{storage.data(), old_size};
+      for(auto match{next_match(text, read)}; match.pos != npos; match = next_match(text, read))
+        {
+        written = static_cast<size_type>(written + (match.pos - read) + match.replacement.size());
+        read = static_cast<size_type>(match.pos + match.length);
+        if(written > read)
+          shift = std::max(shift, static_cast<size_type>(written - read));
+        ++count;
+        }
+      }
+    if(count == 0u)
+      return count;
+
+    size_type const new_size{static_cast<size_type>(written + (old_size - read))};
+    resize_and_overwrite(
+      storage,
+      static_cast<size_type>(old_size + shift),
+      [&next_match, old_size, shift, new_size](char_type * data, size_type /*cap*/) -> size_type
+      {
+        small_vectors_clang_unsafe_buffer_usage_begin  //
+          char_type * const source{data + shift};
+        if(shift != 0u)
+          std::copy_backward(data, data + old_size, source + old_size);
+        view_type const text{source, old_size};
+        char_type * out{data};
+        size_type from{};
+        for(auto match{next_match(text, from)}; match.pos != npos; match = next_match(text, from))
+          {
+          out = std::copy(source + from, source + match.pos, out);
+          out = std::copy(match.replacement.begin(), match.replacement.end(), out);
+          from = static_cast<size_type>(match.pos + match.length);
+          }
+        std::copy(source + from, source + old_size, out);
+        small_vectors_clang_unsafe_buffer_usage_end  //
+          return new_size;
+      }
+    );
+    return count;
+    }
+  };
+
+inline constexpr find_and_replace_t find_and_replace;
+
   }  // namespace small_vectors::inline v3_3::detail::string
 
@@ -0,0 +1,325 @@
+#pragma once
+#include <small_vectors/version.h>
+#include <small_vectors/utils/static_call_operator.h>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace small_vectors::inline v3_3::detail::string
+  {
+namespace search_detail
+  {
+  template<typename char_type>
+  inline constexpr bool simd_char = sizeof(char_type) == 1u;
+
+  ///\returns ASCII lower case of \p c, other values are returned unchanged
+  template<typename char_type>
+  inline constexpr auto ascii_lower(char_type c) noexcept -> char_type
+    {
+    return c >= char_type('A') && c <= char_type('Z') ? static_cast<char_type>(c + (char_type('a') - char_type('A')))
+                                                      : c;
+    }
+
+  template<typename char_type>
+  inline constexpr auto ascii_iequal(char_type const * l, char_type const * r, std::size_t count) noexcept -> bool
+    {
+    small_vectors_clang_unsafe_buffer_usage_begin  //
+      for(std::size_t ix{}; ix != count; ++ix)
+        if(ascii_lower(l[ix]) != ascii_lower(r[ix]))
+          return false;
+    small_vectors_clang_unsafe_buffer_usage_end  //
+      return true;
+    }
+
+#if defined(__SSE2__)
+  ///\brief thin wrapper over widest available byte vector so search loops are written once
+#if defined(__AVX2__)
+  struct simd_t
+    {
+    using reg = __m256i;
+    static constexpr std::size_t width{32u};
+
+    static auto load(void const * p) noexcept -> reg { return _mm256_loadu_si256(static_cast<reg const *>(p)); }
+
+    static auto broadcast(uint8_t v) noexcept -> reg { return _mm256_set1_epi8(static_cast<char>(v)); }
+
+    static auto eq(reg l, reg r) noexcept -> reg { return _mm256_cmpeq_epi8(l, r); }
+
+    /// signed byte compare l > r
+    static auto gt(reg l, reg r) noexcept -> reg { return _mm256_cmpgt_epi8(l, r); }
+
+    static auto and_(reg l, reg r) noexcept -> reg { return _mm256_and_si256(l, r); }
+
+    static auto or_(reg l, reg r) noexcept -> reg { return _mm256_or_si256(l, r); }
+
+    /// ~l & r
+    static auto andnot(reg l, reg r) noexcept -> reg { return _mm256_andnot_si256(l, r); }
+
+    static auto mask(reg v) noexcept -> uint32_t { return static_cast<uint32_t>(_mm256_movemask_epi8(v)); }
+
+    static auto high_nibble(reg v) noexcept -> reg { return and_(_mm256_srli_epi16(v, 4), broadcast(0x0fu)); }
+
+    static auto table(std::array<uint8_t, 16> const & t) noexcept -> reg
+      {
+      return _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<__m128i const *>(t.data())));
+      }
+
+    /// per lane table lookup by low 4 bits of \p index
+    static auto lookup(reg table, reg index) noexcept -> reg { return _mm256_shuffle_epi8(table, index); }
+    };
+#else
+  struct simd_t
+    {
+    using reg = __m128i;
+    static constexpr std::size_t width{16u};
+
+    static auto load(void const * p) noexcept -> reg { return _mm_loadu_si128(static_cast<reg const *>(p)); }
+
+    static auto broadcast(uint8_t v) noexcept -> reg { return _mm_set1_epi8(static_cast<char>(v)); }
+
+    static auto eq(reg l, reg r) noexcept -> reg { return _mm_cmpeq_epi8(l, r); }
+
+    /// signed byte compare l > r
+    static auto gt(reg l, reg r) noexcept -> reg { return _mm_cmpgt_epi8(l, r); }
+
+    static auto and_(reg l, reg r) noexcept -> reg { return _mm_and_si128(l, r); }
+
+    static auto or_(reg l, reg r) noexcept -> reg { return _mm_or_si128(l, r); }
+
+    /// ~l & r
+    static auto andnot(reg l, reg r) noexcept -> reg { return _mm_andnot_si128(l, r); }
+
+    static auto mask(reg v) noexcept -> uint32_t { return static_cast<uint32_t>(_mm_movemask_epi8(v)); }
+
+    static auto high_nibble(reg v) noexcept -> reg { return and_(_mm_srli_epi16(v, 4), broadcast(0x0fu)); }
+
+#if defined(__SSSE3__)
+    static auto table(std::array<uint8_t, 16> const & t) noexcept -> reg
+      {
+      return _mm_loadu_si128(reinterpret_cast<__m128i const *>(t.data()));
+      }
+
+    /// table lookup by low 4 bits of \p index
+    static auto lookup(reg table, reg index) noexcept -> reg { return _mm_shuffle_epi8(table, index); }
+#endif
+    };
+#endif
+
+  ///\returns \p v with ASCII upper case letters folded to lower case
+  inline auto ascii_lower(simd_t::reg v) noexcept -> simd_t::reg
+    {
+    simd_t::reg const upper{simd_t::and_(
+      simd_t::gt(v, simd_t::broadcast(uint8_t('A' - 1))), simd_t::gt(simd_t::broadcast(uint8_t('Z' + 1)), v)
+    )};
+    return simd_t::or_(v, simd_t::and_(upper, simd_t::broadcast(0x20u)));
+    }
+#endif
+  }  // namespace search_detail
+
+//-------------------------------------------------------------------------------------------------------------------
+///\brief position of first \p ch in \p text at or after \p pos, npos when there is none
+struct search_char_t
+  {
+  template<typename char_type>
+  small_vector_static_call_operator inline constexpr auto operator()(
+    std::basic_string_view<char_type> text, char_type ch, std::size_t pos = 0u
+  ) small_vector_static_call_operator_const noexcept -> std::size_t
+    {
+    if(pos > text.size())
+      return std::basic_string_view<char_type>::npos;
+#if defined(__SSE2__)
+    if constexpr(search_detail::simd_char<char_type>)
+      if(!std::is_constant_evaluated())
+        {
+        using search_detail::simd_t;
+        simd_t::reg const needle{simd_t::broadcast(static_cast<uint8_t>(ch))};
+        small_vectors_clang_unsafe_buffer_usage_begin  //
+          for(; pos + simd_t::width <= text.size(); pos += simd_t::width)
+          {
+          uint32_t const m{simd_t::mask(simd_t::eq(simd_t::load(text.data() + pos), needle))};
+          if(m != 0u)
+            return pos + static_cast<std::size_t>(std::countr_zero(m));
+          }
+        small_vectors_clang_unsafe_buffer_usage_end  //
+        }
+#endif
+    return text.find(ch, pos);
+    }
+  };
+
+inline constexpr search_char_t search_char;
+
+//-------------------------------------------------------------------------------------------------------------------
+///\brief position of first occurrence of \p needle in \p text at or after \p pos, npos when there is none
+///\details candidates are filtered by comparing first and last needle character against whole vector of text
+/// positions at once, only positions where both match are verified with full compare
+struct search_t
+  {
+  template<typename char_type>
+  small_vector_static_call_operator inline constexpr auto operator()(
+    std::basic_string_view<char_type> text, std::basic_string_view<char_type> needle, std::size_t pos = 0u
+  ) small_vector_static_call_operator_const noexcept -> std::size_t
+    {
+    std::size_t const m{needle.size()};
+    if(pos > text.size() || m > text.size() - pos)
+      return std::basic_string_view<char_type>::npos;
+    if(m == 1u)
+      return search_char(text, needle.front(), pos);
+#if defined(__SSE2__)
+    if constexpr(search_detail::simd_char<char_type>)
+      if(!std::is_constant_evaluated() && m != 0u)
+        {
+        using search_detail::simd_t;
+        using traits_type = std::char_traits<char_type>;
+        simd_t::reg const first{simd_t::broadcast(static_cast<uint8_t>(needle.front()))};
+        simd_t::reg const last{simd_t::broadcast(static_cast<uint8_t>(needle.back()))};
+        small_vectors_clang_unsafe_buffer_usage_begin  //
+          for(; pos + m - 1u + simd_t::width <= text.size(); pos += simd_t::width)
+          {
+          char_type const * block{text.data() + pos};
+          uint32_t candidates{simd_t::mask(
+            simd_t::and_(simd_t::eq(simd_t::load(block), first), simd_t::eq(simd_t::load(block + m - 1u), last))
+          )};
+          while(candidates != 0u)
+            {
+            auto const offset{static_cast<std::size_t>(std::countr_zero(candidates))};
+            if(traits_type::compare(block + offset + 1u, needle.data() + 1u, m - 2u) == 0)
+              return pos + offset;
+            candidates &= candidates - 1u;
+            }
+          }
+        small_vectors_clang_unsafe_buffer_usage_end  //
+        }
+#endif
+    return text.find(needle, pos);
+    }
+  };
+
+inline constexpr search_t search;
+
+//-------------------------------------------------------------------------------------------------------------------
+///\brief position of first character of \p text at or after \p pos that is any of \p set, npos when there is none
+///\details for byte characters set is encoded as 256 bit bitmap split into two 16 byte tables indexed by low nibble,
+/// one for values below 0x80 and one above, each vector of text is classified with three table lookups (pshufb)
+struct search_first_of_t
+  {
+  template<typename char_type>
+  small_vector_static_call_operator inline constexpr auto operator()(
+    std::basic_string_view<char_type> text, std::basic_string_view<char_type> set, std::size_t pos = 0u
+  ) small_vector_static_call_operator_const noexcept -> std::size_t
+    {
+    if(set.size() == 1u)
+      return search_char(text, set.front(), pos);
+    if constexpr(search_detail::simd_char<char_type>)
+      if(!std::is_constant_evaluated() && !set.empty() && pos < text.size())
+        {
+        std::array<uint8_t, 16> low_half{};
+        std::array<uint8_t, 16> high_half{};
+        for(char_type c: set)
+          {
+          auto const u{static_cast<uint8_t>(c)};
+          auto & table{u < 0x80u ? low_half : high_half};
+          table[u & 0x0fu] = static_cast<uint8_t>(table[u & 0x0fu] | (1u << ((u >> 4u) & 7u)));
+          }
+#if defined(__SSSE3__)
+        using search_detail::simd_t;
+        constexpr std::array<uint8_t, 16> bit_of_high_nibble{1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+        simd_t::reg const low_table{simd_t::table(low_half)};
+        simd_t::reg const high_table{simd_t::table(high_half)};
+        simd_t::reg const bit_table{simd_t::table(bit_of_high_nibble)};
+        simd_t::reg const low_nibble_mask{simd_t::broadcast(0x0fu)};
+        simd_t::reg const zero{simd_t::broadcast(0u)};
+        small_vectors_clang_unsafe_buffer_usage_begin  //
+          for(; pos + simd_t::width <= text.size(); pos += simd_t::width)
+          {
+          simd_t::reg const v{simd_t::load(text.data() + pos)};
+          simd_t::reg const low_nibble{simd_t::and_(v, low_nibble_mask)};
+          // bytes >= 0x80 are negative as signed
+          simd_t::reg const is_high{simd_t::gt(zero, v)};
+          simd_t::reg const row{simd_t::or_(
+            simd_t::andnot(is_high, simd_t::lookup(low_table, low_nibble)),
+            simd_t::and_(is_high, simd_t::lookup(high_table, low_nibble))
+          )};
+          simd_t::reg const bit{simd_t::lookup(bit_table, simd_t::high_nibble(v))};
+          uint32_t const m{simd_t::mask(simd_t::eq(simd_t::and_(row, bit), bit))};
+          if(m != 0u)
+            return pos + static_cast<std::size_t>(std::countr_zero(m));
+          }
+        small_vectors_clang_unsafe_buffer_usage_end  //
+#endif
+        for(; pos < text.size(); ++pos)
+          {
+          auto const u{static_cast<uint8_t>(text[pos])};
+          auto const & table{u < 0x80u ? low_half : high_half};
+          if((table[u & 0x0fu] & (1u << ((u >> 4u) & 7u))) != 0u)
+            return pos;
+          }
+        return std::basic_string_view<char_type>::npos;
+        }
+    return text.find_first_of(set, pos);
+    }
+  };
+
+inline constexpr search_first_of_t search_first_of;
+
+//-------------------------------------------------------------------------------------------------------------------
+///\brief position of first occurrence of \p needle in \p text at or after \p pos ignoring ASCII letter case
+///\details uses same first and last character filter as search with both text and needle folded to lower case
+struct search_icase_t
+  {
+  template<typename char_type>
+  small_vector_static_call_operator inline constexpr auto operator()(
+    std::basic_string_view<char_type> text, std::basic_string_view<char_type> needle, std::size_t pos = 0u
+  ) small_vector_static_call_operator_const noexcept -> std::size_t
+    {
+    using search_detail::ascii_lower;
+    std::size_t const m{needle.size()};
+    if(pos > text.size() || m > text.size() - pos)
+      return std::basic_string_view<char_type>::npos;
+    if(m == 0u)
+      return pos;
+#if defined(__SSE2__)
+    if constexpr(search_detail::simd_char<char_type>)
+      if(!std::is_constant_evaluated())
+        {
+        using search_detail::simd_t;
+        simd_t::reg const first{simd_t::broadcast(static_cast<uint8_t>(ascii_lower(needle.front())))};
+        simd_t::reg const last{simd_t::broadcast(static_cast<uint8_t>(ascii_lower(needle.back())))};
+        small_vectors_clang_unsafe_buffer_usage_begin  //
+          for(; pos + m - 1u + simd_t::width <= text.size(); pos += simd_t::width)
+          {
+          char_type const * block{text.data() + pos};
+          uint32_t candidates{simd_t::mask(simd_t::and_(
+            simd_t::eq(ascii_lower(simd_t::load(block)), first),
+            simd_t::eq(ascii_lower(simd_t::load(block + m - 1u)), last)
+          ))};
+          while(candidates != 0u)
+            {
+            auto const offset{static_cast<std::size_t>(std::countr_zero(candidates))};
+            if(search_detail::ascii_iequal(block + offset + 1u, needle.data() + 1u, m - 1u))
+              return pos + offset;
+            candidates &= candidates - 1u;
+            }
+          }
+        small_vectors_clang_unsafe_buffer_usage_end  //
+        }
+#endif
+    char_type const first{ascii_lower(needle.front())};
+    small_vectors_clang_unsafe_buffer_usage_begin  //
+      for(; pos + m <= text.size(); ++pos)
+        if(ascii_lower(text[pos]) == first
+           && search_detail::ascii_iequal(text.data() + pos + 1u, needle.data() + 1u, m - 1u))
+          return pos;
+    small_vectors_clang_unsafe_buffer_usage_end  //
+      return std::basic_string_view<char_type>::npos;
+    }
+  };
+
+inline constexpr search_icase_t search_icase;
+  }  // namespace small_vectors::inline v3_3::detail::string
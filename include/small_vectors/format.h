@@ -0,0 +1,136 @@
+// SPDX-FileCopyrightText: 2024 Artur Bać
+// SPDX-License-Identifier: MIT
+
+#pragma once
+#include <small_vectors/basic_string.h>
+#include <small_vectors/formattable/basic_string.h>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <format>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace small_vectors::inline v3_3
+  {
+namespace detail::format
+  {
+  /// output shorter than this is formatted once on stack and copied with single growth of target
+  inline constexpr std::size_t stack_buffer_size{256u};
+
+  ///\brief appends formatted output to \p target growing it at most once
+  template<concepts::same_as_basic_string string_type, typename... args_type>
+  inline void append(
+    string_type & target,
+    std::basic_format_string<typename string_type::char_type, std::type_identity_t<args_type>...> fmt,
+    args_type &&... args
+  )
+    {
+    using char_type = typename string_type::char_type;
+    using size_type = typename string_type::size_type;
+    std::array<char_type, stack_buffer_size> buffer;
+    auto const result{std::format_to_n(
+      buffer.data(), static_cast<std::ptrdiff_t>(buffer.size()), fmt, std::forward<args_type>(args)...
+    )};
+    auto const length{static_cast<std::size_t>(result.size)};
+    if(length <= buffer.size())
+      {
+      target.append(std::basic_string_view<char_type>{buffer.data(), length});
+      return;
+      }
+    // output does not fit stack buffer, size target exactly and format second time directly into it
+    std::size_t const old_size{target.size()};
+    if(old_size + length > std::size_t{std::numeric_limits<size_type>::max()}) [[unlikely]]
+      throw std::length_error{"Out of buffer space"};
+    auto const new_size{static_cast<size_type>(old_size + length)};
+    target.resize_and_overwrite(
+      new_size,
+      [&](char_type * data, size_type) -> size_type
+      {
+        small_vectors_clang_unsafe_buffer_usage_begin  //
+          std::format_to(data + old_size, fmt, std::forward<args_type>(args)...);
+        small_vectors_clang_unsafe_buffer_usage_end  //
+          return new_size;
+      }
+    );
+    }
+  }  // namespace detail::format
+
+///\brief std::format producing small_vectors::string without intermediate std::string
+template<typename... args_type>
+[[nodiscard]]
+inline auto format(std::format_string<args_type...> fmt, args_type &&... args) -> string
+  {
+  string result;
+  detail::format::append(result, fmt, std::forward<args_type>(args)...);
+  return result;
+  }
+
+///\brief std::format producing small_vectors::wstring without intermediate std::wstring
+template<typename... args_type>
+[[nodiscard]]
+inline auto format(std::wformat_string<args_type...> fmt, args_type &&... args) -> wstring
+  {
+  wstring result;
+  detail::format::append(result, fmt, std::forward<args_type>(args)...);
+  return result;
+  }
+
+///\brief replaces content of \p target with formatted output, existing capacity is reused
+///\details for static strings throws std::length_error when output exceeds capacity, use format_to_n to truncate
+template<concepts::same_as_basic_string string_type, typename... args_type>
+inline auto format_to(
+  string_type & target,
+  std::basic_format_string<typename string_type::char_type, std::type_identity_t<args_type>...> fmt,
+  args_type &&... args
+) -> string_type &
+  {
+  target.clear();
+  detail::format::append(target, fmt, std::forward<args_type>(args)...);
+  return target;
+  }
+
+///\brief appends formatted output to \p target
+template<concepts::same_as_basic_string string_type, typename... args_type>
+inline auto format_append(
+  string_type & target,
+  std::basic_format_string<typename string_type::char_type, std::type_identity_t<args_type>...> fmt,
+  args_type &&... args
+) -> string_type &
+  {
+  detail::format::append(target, fmt, std::forward<args_type>(args)...);
+  return target;
+  }
+
+///\brief replaces content of \p target with formatted output truncated to its capacity, never allocates
+///\details intended for fixed capacity static strings on hot paths like logging, for buffered strings output is
+/// truncated to current capacity
+///\returns length of untruncated output, greater than target size when output was truncated
+template<concepts::same_as_basic_string string_type, typename... args_type>
+inline auto format_to_n(
+  string_type & target,
+  std::basic_format_string<typename string_type::char_type, std::type_identity_t<args_type>...> fmt,
+  args_type &&... args
+) -> std::size_t
+  {
+  using char_type = typename string_type::char_type;
+  using size_type = typename string_type::size_type;
+  size_type const limit{target.capacity()};
+  std::size_t length{};
+  target.resize_and_overwrite(
+    limit,
+    [&](char_type * data, size_type) -> size_type
+    {
+      auto const result{
+        std::format_to_n(data, static_cast<std::ptrdiff_t>(limit), fmt, std::forward<args_type>(args)...)
+      };
+      length = static_cast<std::size_t>(result.size);
+      return static_cast<size_type>(std::min<std::size_t>(length, limit));
+    }
+  );
+  return length;
+  }
+  }  // namespace small_vectors::inline v3_3
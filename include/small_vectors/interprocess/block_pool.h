@@ -0,0 +1,284 @@
+#pragma once
+#include <small_vectors/version.h>
+#include <small_vectors/utils/expected.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+namespace small_vectors::inline v3_3::ip
+  {
+enum struct pool_error_e : uint8_t
+  {
+    /// all blocks are allocated
+    exhausted = 1
+  };
+
+using block_index = uint32_t;
+
+inline constexpr block_index invalid_block_index{std::numeric_limits<block_index>::max()};
+  }  // namespace small_vectors::inline v3_3::ip
+
+///\brief allocation result is stored in 4 bytes with exhausted pool encoded as invalid_block_index
+template<>
+struct cxx23::expected_niche<small_vectors::ip::block_index, small_vectors::ip::pool_error_e> :
+    cxx23::sentinel_niche<
+      small_vectors::ip::block_index,
+      small_vectors::ip::invalid_block_index,
+      small_vectors::ip::pool_error_e,
+      small_vectors::ip::pool_error_e::exhausted>
+  {
+  };
+
+namespace small_vectors::inline v3_3::ip
+  {
+namespace detail
+  {
+  ///\brief block index with generation tag packed into single lock free word
+  ///\details tag is bumped on every change of list head so compare exchange of stale head fails even when same
+  /// index was popped and pushed back meanwhile (ABA)
+  struct tagged_index
+    {
+    static constexpr unsigned index_bits{std::numeric_limits<block_index>::digits};
+
+    uint64_t data_;
+
+    [[nodiscard]]
+    static constexpr auto make(block_index index, uint32_t tag) noexcept -> tagged_index
+      {
+      return {uint64_t{index} | (uint64_t{tag} << index_bits)};
+      }
+
+    [[nodiscard]]
+    constexpr auto index() const noexcept -> block_index
+      {
+      return static_cast<block_index>(data_);
+      }
+
+    [[nodiscard]]
+    constexpr auto tag() const noexcept -> uint32_t
+      {
+      return static_cast<uint32_t>(data_ >> index_bits);
+      }
+
+    [[nodiscard]]
+    constexpr auto next(block_index index) const noexcept -> tagged_index
+      {
+      return make(index, tag() + 1u);
+      }
+    };
+
+  inline constexpr std::size_t cache_line_size{64u};
+  }  // namespace detail
+
+///\brief fixed size block pool placed in mapped region with lock free free list
+///\details Treiber stack of free block indices with generation tagged head, links live in separate array so blocks
+/// are fully owned by user between allocate and deallocate. Blocks are identified with 32 bit index valid in every
+/// process mapping the region, producer may allocate block, fill it and pass only its index to consumer. Place with
+/// ip::construct_at, pool requires no further initialization. Each block starts at multiple of \p BlockSize from
+/// cache line aligned storage
+template<std::size_t BlockSize, block_index Count>
+  requires(BlockSize != 0u && Count != 0u && Count < invalid_block_index)
+class block_pool
+  {
+  using atomic_head = std::atomic<uint64_t>;
+  static_assert(atomic_head::is_always_lock_free && std::atomic<block_index>::is_always_lock_free);
+
+  alignas(detail::cache_line_size) atomic_head head_;
+  alignas(detail::cache_line_size) std::array<std::atomic<block_index>, Count> next_;
+  alignas(detail::cache_line_size) std::array<std::array<std::byte, BlockSize>, Count> blocks_;
+
+public:
+  using block_type = std::span<std::byte, BlockSize>;
+  using const_block_type = std::span<std::byte const, BlockSize>;
+  using allocation_result = cxx23::expected<block_index, pool_error_e>;
+
+  static constexpr std::size_t block_size{BlockSize};
+
+  block_pool() noexcept : head_{detail::tagged_index::make(0u, 0u).data_}
+    {
+    for(block_index ix{}; ix != Count; ++ix)
+      next_[ix].store(ix + 1u == Count ? invalid_block_index : ix + 1u, std::memory_order_relaxed);
+    }
+
+  block_pool(block_pool const &) = delete;
+  auto operator=(block_pool const &) -> block_pool & = delete;
+
+  [[nodiscard]]
+  static constexpr auto capacity() noexcept -> block_index
+    {
+    return Count;
+    }
+
+  ///\returns index of free block or pool_error_e::exhausted
+  [[nodiscard]]
+  auto allocate() noexcept -> allocation_result
+    {
+    detail::tagged_index head{head_.load(std::memory_order_acquire)};
+    while(head.index() != invalid_block_index)
+      {
+      block_index const next{next_[head.index()].load(std::memory_order_relaxed)};
+      if(head_.compare_exchange_weak(
+           head.data_, head.next(next).data_, std::memory_order_acquire, std::memory_order_acquire
+         ))
+        return head.index();
+      }
+    return cxx23::unexpected{pool_error_e::exhausted};
+    }
+
+  ///\brief pops up to \p indices size blocks with single compare exchange
+  ///\details links below tagged head can change only after head changes, so chain walked from head is still valid
+  /// when compare exchange of same head succeeds
+  ///\returns number of blocks stored into \p indices, 0 when pool is exhausted
+  [[nodiscard]]
+  auto allocate_chain(std::span<block_index> indices) noexcept -> std::size_t
+    {
+    if(indices.empty())
+      return 0u;
+    detail::tagged_index head{head_.load(std::memory_order_acquire)};
+    for(;;)
+      {
+      std::size_t count{};
+      block_index next{head.index()};
+      for(; count != indices.size() && next != invalid_block_index; ++count)
+        {
+        indices[count] = next;
+        next = next_[next].load(std::memory_order_relaxed);
+        }
+      if(count == 0u)
+        return 0u;
+      if(head_.compare_exchange_weak(
+           head.data_, head.next(next).data_, std::memory_order_acquire, std::memory_order_acquire
+         ))
+        return count;
+      }
+    }
+
+  void deallocate(block_index index) noexcept
+    {
+    std::array<block_index, 1u> const chain{index};
+    deallocate_chain(chain);
+    }
+
+  ///\brief returns all \p indices to pool with single compare exchange
+  void deallocate_chain(std::span<block_index const> indices) noexcept
+    {
+    if(indices.empty())
+      return;
+    for(std::size_t ix{1u}; ix != indices.size(); ++ix)
+      {
+      assert(indices[ix - 1u] < Count);
+      next_[indices[ix - 1u]].store(indices[ix], std::memory_order_relaxed);
+      }
+    block_index const last{indices.back()};
+    assert(last < Count);
+    detail::tagged_index head{head_.load(std::memory_order_relaxed)};
+    do
+      next_[last].store(head.index(), std::memory_order_relaxed);
+    while(!head_.compare_exchange_weak(
+      head.data_, head.next(indices.front()).data_, std::memory_order_release, std::memory_order_relaxed
+    ));
+    }
+
+  [[nodiscard]]
+  auto block(block_index index) noexcept -> block_type
+    {
+    assert(index < Count);
+    return block_type{blocks_[index]};
+    }
+
+  [[nodiscard]]
+  auto block(block_index index) const noexcept -> const_block_type
+    {
+    assert(index < Count);
+    return const_block_type{blocks_[index]};
+    }
+
+  ///\returns index of block containing \p address
+  [[nodiscard]]
+  auto index_of(void const * address) const noexcept -> block_index
+    {
+    auto const offset{reinterpret_cast<std::uintptr_t>(address) - reinterpret_cast<std::uintptr_t>(blocks_.data())};
+    assert(offset < sizeof(blocks_));
+    return static_cast<block_index>(offset / BlockSize);
+    }
+  };
+
+///\brief process local cache of free block indices in front of shared block_pool
+///\details allocations and releases are served from local array, shared free list is touched once per batch of
+/// \p CacheSize / 2 blocks. Cached blocks are returned to pool on destruction, blocks cached by process which
+/// terminated without it are lost for other processes
+template<typename pool_type, block_index CacheSize = 32u>
+  requires(CacheSize >= 2u)
+class block_pool_cache
+  {
+  static constexpr block_index batch_size{CacheSize / 2u};
+
+  pool_type & pool_;
+  std::array<block_index, CacheSize> indices_;
+  block_index size_{};
+
+  void refill() noexcept
+    {
+    size_ = static_cast<block_index>(pool_.allocate_chain(std::span{indices_}.first(batch_size)));
+    }
+
+  void release(block_index count) noexcept
+    {
+    size_ -= count;
+    pool_.deallocate_chain(std::span{indices_}.subspan(size_, count));
+    }
+
+public:
+  using allocation_result = typename pool_type::allocation_result;
+
+  explicit block_pool_cache(pool_type & pool) noexcept : pool_{pool} {}
+
+  block_pool_cache(block_pool_cache const &) = delete;
+  auto operator=(block_pool_cache const &) -> block_pool_cache & = delete;
+
+  ~block_pool_cache() { flush(); }
+
+  [[nodiscard]]
+  auto pool() const noexcept -> pool_type &
+    {
+    return pool_;
+    }
+
+  [[nodiscard]]
+  auto cached() const noexcept -> block_index
+    {
+    return size_;
+    }
+
+  [[nodiscard]]
+  auto allocate() noexcept -> allocation_result
+    {
+    if(size_ == 0u) [[unlikely]]
+      {
+      refill();
+      if(size_ == 0u)
+        return cxx23::unexpected{pool_error_e::exhausted};
+      }
+    return indices_[--size_];
+    }
+
+  void deallocate(block_index index) noexcept
+    {
+    if(size_ == CacheSize) [[unlikely]]
+      release(batch_size);
+    indices_[size_++] = index;
+    }
+
+  ///\brief returns all cached blocks to shared pool
+  void flush() noexcept
+    {
+    if(size_ != 0u)
+      release(size_);
+    }
+  };
+  }  // namespace small_vectors::inline v3_3::ip
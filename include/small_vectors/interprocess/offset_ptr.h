@@ -0,0 +1,185 @@
+#pragma once
+#include <small_vectors/version.h>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
+namespace small_vectors::inline v3_3::ip
+  {
+///\brief pointer stored as distance from its own address
+///\details valid in every process mapping same region as long as pointer and pointee live in that region, regardless
+/// of address region is mapped at. Copy recomputes distance for new location so offset_ptr is not trivially copyable
+/// and must not be memcpy'd. Distance 0 represents nullptr so offset_ptr can not point to itself
+template<typename T>
+class offset_ptr
+  {
+  std::ptrdiff_t offset_{};
+
+  [[nodiscard]]
+  static auto address(void const * ptr) noexcept -> std::uintptr_t
+    {
+    return reinterpret_cast<std::uintptr_t>(ptr);
+    }
+
+  void assign(T * ptr) noexcept
+    {
+    offset_ = ptr == nullptr ? 0 : static_cast<std::ptrdiff_t>(address(ptr) - address(this));
+    }
+
+public:
+  using element_type = T;
+  using pointer = T *;
+  using difference_type = std::ptrdiff_t;
+
+  offset_ptr() noexcept = default;
+
+  offset_ptr(std::nullptr_t) noexcept {}
+
+  offset_ptr(T * ptr) noexcept { assign(ptr); }
+
+  offset_ptr(offset_ptr const & other) noexcept { assign(other.get()); }
+
+  template<typename U>
+    requires(!std::same_as<U, T> && std::convertible_to<U *, T *>)
+  offset_ptr(offset_ptr<U> const & other) noexcept
+    {
+    assign(other.get());
+    }
+
+  ~offset_ptr() = default;
+
+  auto operator=(offset_ptr const & other) noexcept -> offset_ptr &
+    {
+    assign(other.get());
+    return *this;
+    }
+
+  auto operator=(T * ptr) noexcept -> offset_ptr &
+    {
+    assign(ptr);
+    return *this;
+    }
+
+  auto operator=(std::nullptr_t) noexcept -> offset_ptr &
+    {
+    offset_ = 0;
+    return *this;
+    }
+
+  [[nodiscard]]
+  auto get() const noexcept -> T *
+    {
+    if(offset_ == 0)
+      return nullptr;
+    return reinterpret_cast<T *>(address(this) + static_cast<std::uintptr_t>(offset_));
+    }
+
+  ///\returns raw distance from this, 0 for nullptr
+  [[nodiscard]]
+  auto offset() const noexcept -> std::ptrdiff_t
+    {
+    return offset_;
+    }
+
+  [[nodiscard]]
+  static auto pointer_to(std::type_identity_t<T> & ref) noexcept -> offset_ptr
+    requires(!std::is_void_v<T>)
+    {
+    return offset_ptr{std::addressof(ref)};
+    }
+
+  explicit operator bool() const noexcept { return offset_ != 0; }
+
+  [[nodiscard]]
+  auto operator*() const noexcept -> T &
+    requires(!std::is_void_v<T>)
+    {
+    return *get();
+    }
+
+  [[nodiscard]]
+  auto operator->() const noexcept -> T *
+    {
+    return get();
+    }
+
+  [[nodiscard]]
+  auto operator[](difference_type index) const noexcept -> T &
+    requires(!std::is_void_v<T>)
+    {
+    return *std::next(get(), index);
+    }
+
+  auto operator+=(difference_type count) noexcept -> offset_ptr &
+    requires(!std::is_void_v<T>)
+    {
+    offset_ += count * static_cast<difference_type>(sizeof(T));
+    return *this;
+    }
+
+  auto operator-=(difference_type count) noexcept -> offset_ptr &
+    requires(!std::is_void_v<T>)
+    {
+    offset_ -= count * static_cast<difference_type>(sizeof(T));
+    return *this;
+    }
+
+  auto operator++() noexcept -> offset_ptr & { return *this += 1; }
+
+  auto operator--() noexcept -> offset_ptr & { return *this -= 1; }
+
+  auto operator++(int) noexcept -> offset_ptr
+    {
+    offset_ptr result{*this};
+    ++*this;
+    return result;
+    }
+
+  auto operator--(int) noexcept -> offset_ptr
+    {
+    offset_ptr result{*this};
+    --*this;
+    return result;
+    }
+
+  [[nodiscard]]
+  friend auto operator+(offset_ptr const & ptr, difference_type count) noexcept -> offset_ptr
+    {
+    return offset_ptr{std::next(ptr.get(), count)};
+    }
+
+  [[nodiscard]]
+  friend auto operator-(offset_ptr const & ptr, difference_type count) noexcept -> offset_ptr
+    {
+    return offset_ptr{std::prev(ptr.get(), count)};
+    }
+
+  [[nodiscard]]
+  friend auto operator-(offset_ptr const & l, offset_ptr const & r) noexcept -> difference_type
+    {
+    return l.get() - r.get();
+    }
+
+  [[nodiscard]]
+  friend auto operator==(offset_ptr const & l, offset_ptr const & r) noexcept -> bool
+    {
+    return l.get() == r.get();
+    }
+
+  [[nodiscard]]
+  friend auto operator==(offset_ptr const & l, std::nullptr_t) noexcept -> bool
+    {
+    return l.offset_ == 0;
+    }
+
+  [[nodiscard]]
+  friend auto operator<=>(offset_ptr const & l, offset_ptr const & r) noexcept -> std::strong_ordering
+    {
+    return std::compare_three_way{}(l.get(), r.get());
+    }
+  };
+  }  // namespace small_vectors::inline v3_3::ip
@@ -0,0 +1,313 @@
+#pragma once
+#include <small_vectors/version.h>
+#include <small_vectors/interprocess/offset_ptr.h>
+#include <small_vectors/interprocess/region_allocator.h>
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace small_vectors::inline v3_3::ip
+  {
+///\brief growable vector placed in mapped region with elements allocated from region_arena
+///\details storage is referenced with offset_ptr so vector object placed in region (eg with shared_type_decl) is
+/// usable from every process mapping that region at any address. Elements must themselves be position independent,
+/// trivially copyable types, static_vector, static_string, offset_ptr and nested offset_vector qualify. Capacity always
+/// fills whole arena size class block
+template<typename T, std::unsigned_integral SizeType = uint32_t>
+class offset_vector
+  {
+  static_assert(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_destructible_v<T>);
+
+public:
+  using value_type = T;
+  using size_type = SizeType;
+  using difference_type = std::ptrdiff_t;
+  using allocator_type = region_allocator<T>;
+  using reference = T &;
+  using const_reference = T const &;
+  using pointer = T *;
+  using const_pointer = T const *;
+  using iterator = T *;
+  using const_iterator = T const *;
+
+private:
+  allocator_type alloc_;
+  offset_ptr<T> data_;
+  size_type size_{};
+  size_type capacity_{};
+
+  [[nodiscard]]
+  static auto capacity_for(std::size_t count) -> size_type
+    {
+    if(count > std::numeric_limits<size_type>::max()) [[unlikely]]
+      throw std::length_error{"offset_vector size exceeds size_type"};
+    std::size_t const result{region_arena::block_size(count * sizeof(T)) / sizeof(T)};
+    return static_cast<size_type>(std::min<std::size_t>(result, std::numeric_limits<size_type>::max()));
+    }
+
+  void reallocate(size_type new_capacity)
+    {
+    T * new_data{alloc_.allocate(new_capacity)};
+    T * old_data{data()};
+    std::uninitialized_move_n(old_data, size_, new_data);
+    std::destroy_n(old_data, size_);
+    if(old_data != nullptr)
+      alloc_.deallocate(old_data, capacity_);
+    data_ = new_data;
+    capacity_ = new_capacity;
+    }
+
+  void grow_for(std::size_t count)
+    {
+    if(count > capacity_)
+      reallocate(capacity_for(std::max<std::size_t>(count, std::size_t{capacity_} * 2u)));
+    }
+
+  void release() noexcept
+    {
+    clear();
+    if(capacity_ != 0u)
+      alloc_.deallocate(data(), capacity_);
+    data_ = nullptr;
+    capacity_ = 0u;
+    }
+
+public:
+  explicit offset_vector(allocator_type const & alloc) noexcept : alloc_{alloc} {}
+
+  explicit offset_vector(region_arena & arena) noexcept : alloc_{arena} {}
+
+  offset_vector(std::initializer_list<T> values, allocator_type const & alloc) : alloc_{alloc}
+    {
+    assign(values);
+    }
+
+  offset_vector(offset_vector const & other) : alloc_{other.alloc_} { assign(other); }
+
+  offset_vector(offset_vector && other) noexcept :
+      alloc_{other.alloc_},
+      data_{other.data_},
+      size_{std::exchange(other.size_, 0u)},
+      capacity_{std::exchange(other.capacity_, 0u)}
+    {
+    other.data_ = nullptr;
+    }
+
+  ~offset_vector() { release(); }
+
+  auto operator=(offset_vector const & other) -> offset_vector &
+    {
+    if(this != &other)
+      assign(other);
+    return *this;
+    }
+
+  ///\details storage is moved only within same arena, otherwise elements are moved one by one
+  auto operator=(offset_vector && other) -> offset_vector &
+    {
+    if(this == &other)
+      return *this;
+    if(alloc_ == other.alloc_)
+      {
+      release();
+      data_ = other.data_;
+      size_ = std::exchange(other.size_, 0u);
+      capacity_ = std::exchange(other.capacity_, 0u);
+      other.data_ = nullptr;
+      }
+    else
+      {
+      clear();
+      reserve(other.size_);
+      std::uninitialized_move_n(other.data(), other.size_, data());
+      size_ = other.size_;
+      other.release();
+      }
+    return *this;
+    }
+
+  template<std::ranges::input_range range_type>
+    requires std::convertible_to<std::ranges::range_reference_t<range_type>, T>
+  void assign(range_type const & values)
+    {
+    clear();
+    if constexpr(std::ranges::sized_range<range_type>)
+      reserve(static_cast<std::size_t>(std::ranges::size(values)));
+    for(auto const & value: values)
+      emplace_back(value);
+    }
+
+  [[nodiscard]]
+  auto get_allocator() const noexcept -> allocator_type
+    {
+    return alloc_;
+    }
+
+  [[nodiscard]]
+  auto data() noexcept -> T *
+    {
+    return data_.get();
+    }
+
+  [[nodiscard]]
+  auto data() const noexcept -> T const *
+    {
+    return data_.get();
+    }
+
+  [[nodiscard]]
+  auto size() const noexcept -> size_type
+    {
+    return size_;
+    }
+
+  [[nodiscard]]
+  auto capacity() const noexcept -> size_type
+    {
+    return capacity_;
+    }
+
+  [[nodiscard]]
+  auto empty() const noexcept -> bool
+    {
+    return size_ == 0u;
+    }
+
+  [[nodiscard]]
+  auto view() noexcept -> std::span<T>
+    {
+    return {data(), size_};
+    }
+
+  [[nodiscard]]
+  auto view() const noexcept -> std::span<T const>
+    {
+    return {data(), size_};
+    }
+
+  [[nodiscard]]
+  auto begin() noexcept -> iterator
+    {
+    return data();
+    }
+
+  [[nodiscard]]
+  auto begin() const noexcept -> const_iterator
+    {
+    return data();
+    }
+
+  [[nodiscard]]
+  auto end() noexcept -> iterator
+    {
+    small_vectors_clang_unsafe_buffer_usage_begin  //
+      return data() + size_;
+    small_vectors_clang_unsafe_buffer_usage_end  //
+    }
+
+  [[nodiscard]]
+  auto end() const noexcept -> const_iterator
+    {
+    small_vectors_clang_unsafe_buffer_usage_begin  //
+      return data() + size_;
+    small_vectors_clang_unsafe_buffer_usage_end  //
+    }
+
+  [[nodiscard]]
+  auto operator[](size_type index) noexcept -> T &
+    {
+    assert(index < size_);
+    return view()[index];
+    }
+
+  [[nodiscard]]
+  auto operator[](size_type index) const noexcept -> T const &
+    {
+    assert(index < size_);
+    return view()[index];
+    }
+
+  [[nodiscard]]
+  auto front() noexcept -> T &
+    {
+    return (*this)[0u];
+    }
+
+  [[nodiscard]]
+  auto back() noexcept -> T &
+    {
+    return (*this)[static_cast<size_type>(size_ - 1u)];
+    }
+
+  ///\throws std::bad_alloc when arena is exhausted
+  void reserve(std::size_t count)
+    {
+    if(count > capacity_)
+      reallocate(capacity_for(count));
+    }
+
+  template<typename... Args>
+    requires std::constructible_from<T, Args...>
+  auto emplace_back(Args &&... args) -> T &
+    {
+    if(size_ == capacity_)
+      {
+      // argument may refer to element relocated by growth
+      T value(std::forward<Args>(args)...);
+      grow_for(std::size_t{size_} + 1u);
+      T * result{std::construct_at(end(), std::move(value))};
+      ++size_;
+      return *result;
+      }
+    T * result{std::construct_at(end(), std::forward<Args>(args)...)};
+    ++size_;
+    return *result;
+    }
+
+  void push_back(T const & value) { emplace_back(value); }
+
+  void push_back(T && value) { emplace_back(std::move(value)); }
+
+  void pop_back() noexcept
+    {
+    assert(size_ != 0u);
+    --size_;
+    std::destroy_at(end());
+    }
+
+  void resize(size_type count)
+    requires std::default_initializable<T>
+    {
+    if(count > size_)
+      {
+      grow_for(count);
+      std::uninitialized_value_construct_n(end(), count - size_);
+      }
+    else
+      std::destroy_n(std::next(begin(), count), size_ - count);
+    size_ = count;
+    }
+
+  void clear() noexcept
+    {
+    std::destroy_n(data(), size_);
+    size_ = 0u;
+    }
+
+  [[nodiscard]]
+  friend auto operator==(offset_vector const & l, offset_vector const & r) noexcept -> bool
+    requires std::equality_comparable<T>
+    {
+    return std::ranges::equal(l.view(), r.view());
+    }
+  };
+  }  // namespace small_vectors::inline v3_3::ip
@@ -0,0 +1,182 @@
+#pragma once
+#include <small_vectors/version.h>
+#include <small_vectors/interprocess/atomic_mutex.h>
+#include <small_vectors/interprocess/offset_ptr.h>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <new>
+
+namespace small_vectors::inline v3_3::ip
+  {
+///\brief allocator of blocks from mapped region shared between processes
+///\details arena is placed at start of memory it manages, blocks are carved from remaining bytes and all bookkeeping
+/// is kept as offsets from arena address so every process can allocate and release blocks regardless of address
+/// region is mapped at. Block sizes are rounded up to power of two size classes, released blocks are kept on per class
+/// free lists and reused. Concurrent access from processes and threads is serialized with atomic_mutex
+class alignas(16) region_arena
+  {
+public:
+  static constexpr std::size_t block_alignment{16u};
+  static constexpr std::size_t min_block_size{16u};
+
+private:
+  static constexpr unsigned size_classes{std::numeric_limits<std::size_t>::digits - 4u};
+
+  atomic_mutex mutex_;
+  std::size_t size_;
+  std::size_t top_;
+  // offset of first free block in class, 0 when list is empty
+  std::array<std::size_t, size_classes> free_{};
+
+  [[nodiscard]]
+  static constexpr auto size_class(std::size_t block_size) noexcept -> unsigned
+    {
+    return static_cast<unsigned>(std::countr_zero(block_size) - std::countr_zero(min_block_size));
+    }
+
+  [[nodiscard]]
+  auto at(std::size_t offset) noexcept -> std::byte *
+    {
+    return std::next(reinterpret_cast<std::byte *>(this), static_cast<std::ptrdiff_t>(offset));
+    }
+
+  [[nodiscard]]
+  auto offset_of(void const * block) const noexcept -> std::size_t
+    {
+    return reinterpret_cast<std::uintptr_t>(block) - reinterpret_cast<std::uintptr_t>(this);
+    }
+
+public:
+  ///\param size number of bytes available at address of arena including arena itself
+  explicit region_arena(std::size_t size) noexcept : size_{size}, top_{sizeof(region_arena)} {}
+
+  region_arena(region_arena const &) = delete;
+  auto operator=(region_arena const &) -> region_arena & = delete;
+
+  ///\returns number of bytes reserved for request of \p bytes
+  [[nodiscard]]
+  static constexpr auto block_size(std::size_t bytes) noexcept -> std::size_t
+    {
+    return std::bit_ceil(std::max(bytes, min_block_size));
+    }
+
+  [[nodiscard]]
+  auto size() const noexcept -> std::size_t
+    {
+    return size_;
+    }
+
+  ///\returns number of bytes never allocated yet, released blocks are not included
+  [[nodiscard]]
+  auto unused() noexcept -> std::size_t
+    {
+    std::lock_guard lock{mutex_};
+    return size_ - top_;
+    }
+
+  ///\returns block of at least \p bytes aligned to \p alignment or nullptr when region is exhausted
+  [[nodiscard]]
+  auto allocate(std::size_t bytes, std::size_t alignment = block_alignment) noexcept -> void *
+    {
+    if(alignment > block_alignment || bytes > size_) [[unlikely]]
+      return nullptr;
+    std::size_t const block{block_size(bytes)};
+    std::size_t & free_head{free_[size_class(block)]};
+    std::lock_guard lock{mutex_};
+    if(free_head != 0u)
+      {
+      std::byte * result{at(free_head)};
+      std::memcpy(&free_head, result, sizeof(std::size_t));
+      return result;
+      }
+    if(block > size_ - top_) [[unlikely]]
+      return nullptr;
+    std::byte * result{at(top_)};
+    top_ += block;
+    return result;
+    }
+
+  ///\brief returns block allocated with \p bytes to its size class free list
+  void deallocate(void * block, std::size_t bytes) noexcept
+    {
+    if(block == nullptr)
+      return;
+    std::size_t & free_head{free_[size_class(block_size(bytes))]};
+    std::lock_guard lock{mutex_};
+    std::memcpy(block, &free_head, sizeof(std::size_t));
+    free_head = offset_of(block);
+    }
+
+  [[nodiscard]]
+  auto contains(void const * ptr) const noexcept -> bool
+    {
+    auto const address{reinterpret_cast<std::uintptr_t>(ptr)};
+    auto const first{reinterpret_cast<std::uintptr_t>(this)};
+    return address >= first + sizeof(region_arena) && address < first + size_;
+    }
+  };
+
+///\brief standard allocator handing out blocks of region_arena
+///\details holds offset_ptr to arena so allocator and containers using it may themselves be placed in mapped region
+template<typename T>
+class region_allocator
+  {
+  template<typename U>
+  friend class region_allocator;
+
+  offset_ptr<region_arena> arena_;
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  explicit region_allocator(region_arena & arena) noexcept : arena_{&arena} {}
+
+  region_allocator(region_allocator const &) noexcept = default;
+
+  template<typename U>
+  region_allocator(region_allocator<U> const & other) noexcept : arena_{other.arena_}
+    {
+    }
+
+  auto operator=(region_allocator const &) noexcept -> region_allocator & = default;
+
+  [[nodiscard]]
+  auto arena() const noexcept -> region_arena &
+    {
+    return *arena_;
+    }
+
+  ///\throws std::bad_alloc when arena is exhausted
+  [[nodiscard]]
+  auto allocate(std::size_t count) -> T *
+    {
+    if(count > std::numeric_limits<std::size_t>::max() / sizeof(T)) [[unlikely]]
+      throw std::bad_array_new_length{};
+    void * block{arena_->allocate(count * sizeof(T), alignof(T))};
+    if(block == nullptr) [[unlikely]]
+      throw std::bad_alloc{};
+    return static_cast<T *>(block);
+    }
+
+  void deallocate(T * ptr, std::size_t count) noexcept { arena_->deallocate(ptr, count * sizeof(T)); }
+
+  template<typename U>
+  [[nodiscard]]
+  friend auto operator==(region_allocator const & l, region_allocator<U> const & r) noexcept -> bool
+    {
+    return l.arena_.get() == r.arena_.get();
+    }
+  };
+  }  // namespace small_vectors::inline v3_3::ip
@@ -0,0 +1,147 @@
+#pragma once
+#include <small_vectors/version.h>
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <thread>
+#include <type_traits>
+
+namespace small_vectors::inline v3_3::ip
+  {
+///\brief sequence lock publishing snapshot of \p T to many readers
+///\details readers never write shared memory, they copy snapshot optimistically and retry when sequence changed
+/// meanwhile, so any number of processes can poll it without contending on cache lines. Sequence is odd while write
+/// is in progress, writers serialize on it with compare exchange. Snapshot is kept as array of relaxed atomic words
+/// so racing reads are well defined, torn copies are always discarded by sequence check. Place with
+/// shared_type_decl / ip::construct_at
+template<typename T>
+  requires std::is_trivially_copyable_v<T> && std::default_initializable<T>
+class alignas(64) seqlock
+  {
+  using word_type = uint64_t;
+  static constexpr std::size_t word_count{(sizeof(T) + sizeof(word_type) - 1u) / sizeof(word_type)};
+  using words_type = std::array<word_type, word_count>;
+  static_assert(std::atomic<word_type>::is_always_lock_free);
+
+  std::atomic<uint64_t> sequence_;
+  std::array<std::atomic<word_type>, word_count> words_;
+
+  [[nodiscard]]
+  static auto to_words(T const & value) noexcept -> words_type
+    {
+    words_type words{};
+    std::memcpy(words.data(), &value, sizeof(T));
+    return words;
+    }
+
+  [[nodiscard]]
+  static auto from_words(words_type const & words) noexcept -> T
+    {
+    T value;
+    std::memcpy(&value, words.data(), sizeof(T));
+    return value;
+    }
+
+  ///\returns even sequence observed before write began
+  auto begin_write() noexcept -> uint64_t
+    {
+    uint64_t sequence{sequence_.load(std::memory_order_relaxed)};
+    for(;;)
+      {
+      if((sequence & 1u) == 0u
+         && sequence_.compare_exchange_weak(
+           sequence, sequence + 1u, std::memory_order_acquire, std::memory_order_relaxed
+         ))
+        break;
+      std::this_thread::yield();
+      sequence = sequence_.load(std::memory_order_relaxed);
+      }
+    // snapshot stores must not become visible before odd sequence
+    std::atomic_thread_fence(std::memory_order_release);
+    return sequence;
+    }
+
+  void store_words(words_type const & words) noexcept
+    {
+    for(std::size_t ix{}; ix != word_count; ++ix)
+      words_[ix].store(words[ix], std::memory_order_relaxed);
+    }
+
+  [[nodiscard]]
+  auto load_words() const noexcept -> words_type
+    {
+    words_type words;
+    for(std::size_t ix{}; ix != word_count; ++ix)
+      words[ix] = words_[ix].load(std::memory_order_relaxed);
+    return words;
+    }
+
+public:
+  using value_type = T;
+
+  explicit seqlock(T const & value = T{}) noexcept : sequence_{}
+    {
+    store_words(to_words(value));
+    }
+
+  seqlock(seqlock const &) = delete;
+  auto operator=(seqlock const &) -> seqlock & = delete;
+
+  ///\returns number of completed writes
+  [[nodiscard]]
+  auto version() const noexcept -> uint64_t
+    {
+    return sequence_.load(std::memory_order_acquire) / 2u;
+    }
+
+  void store(T const & value) noexcept
+    {
+    words_type const words{to_words(value)};
+    uint64_t const sequence{begin_write()};
+    store_words(words);
+    sequence_.store(sequence + 2u, std::memory_order_release);
+    }
+
+  ///\brief replaces snapshot with result of \p fn applied to current one, exclusive to other writers
+  template<typename function>
+    requires std::is_nothrow_invocable_v<function, T &>
+  void modify(function const & fn) noexcept
+    {
+    uint64_t const sequence{begin_write()};
+    T value{from_words(load_words())};
+    fn(value);
+    store_words(to_words(value));
+    sequence_.store(sequence + 2u, std::memory_order_release);
+    }
+
+  ///\returns snapshot or nullopt when it was being written during copy
+  [[nodiscard]]
+  auto try_load() const noexcept -> std::optional<T>
+    {
+    uint64_t const before{sequence_.load(std::memory_order_acquire)};
+    if((before & 1u) != 0u)
+      return std::nullopt;
+    words_type const words{load_words()};
+    // snapshot loads must complete before sequence is checked again
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if(sequence_.load(std::memory_order_relaxed) != before)
+      return std::nullopt;
+    return from_words(words);
+    }
+
+  ///\returns consistent snapshot retrying while writers are active
+  [[nodiscard]]
+  auto load() const noexcept -> T
+    {
+    for(;;)
+      {
+      if(auto value{try_load()}; value)
+        return *value;
+      std::this_thread::yield();
+      }
+    }
+  };
+  }  // namespace small_vectors::inline v3_3::ip
@@ -0,0 +1,348 @@
+#pragma once
+
+#include <small_vectors/small_vector.h>
+#include <small_vectors/utils/meta_packed_struct.h>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace small_vectors::inline v3_3
+  {
+namespace detail::packed
+  {
+  template<unsigned bits, bool is_signed>
+  using value_type_for_t = std::conditional_t<
+    bits <= 32u,
+    std::conditional_t<is_signed, int32_t, uint32_t>,
+    std::conditional_t<is_signed, int64_t, uint64_t>>;
+
+  /// values up to this width fit 32 bit window starting at any bit of a byte
+  inline constexpr unsigned simd_max_bits{25u};
+
+  ///\brief pshufb control and shifts gathering 4 values of each 128 bit lane into 32 bit elements
+  ///\details group of 8 values spans exactly \p bits bytes, low lane starts at group start, high lane at byte
+  /// 4 * bits / 8 with remaining 4 * bits % 8 bit offset
+  template<unsigned bits>
+  struct simd_layout
+    {
+    std::array<uint8_t, 32> shuffle{};
+    std::array<uint32_t, 8> shifts{};
+    };
+
+  template<unsigned bits>
+  consteval auto make_simd_layout() noexcept -> simd_layout<bits>
+    {
+    simd_layout<bits> result{};
+    for(unsigned lane{}; lane != 2u; ++lane)
+      {
+      unsigned const lane_shift{lane * ((4u * bits) % 8u)};
+      for(unsigned k{}; k != 4u; ++k)
+        {
+        unsigned const bit{k * bits + lane_shift};
+        for(unsigned b{}; b != 4u; ++b)
+          result.shuffle[lane * 16u + k * 4u + b] = static_cast<uint8_t>(bit / 8u + b);
+        result.shifts[lane * 4u + k] = bit % 8u;
+        }
+      }
+    return result;
+    }
+  }  // namespace detail::packed
+
+///\brief vector of \p Bits wide integers packed lsb first into 64 bit words
+///\details words are kept in small_vector so short vectors stay inline, one spare word after last value lets
+/// get and set use single unaligned 64 bit window at byte bit_position / 8 on little endian targets. Bits of words
+/// past last value are always zero. Signed values are stored in two's complement truncated to \p Bits and sign
+/// extended on read. unpack decodes consecutive values 8 at a time with AVX2 for widths up to 25 bits
+template<
+  unsigned Bits,
+  bool Signed = false,
+  std::unsigned_integral SizeType = uint32_t,
+  uint64_t InlineWords = union_min_number_of_elements<uint64_t, SizeType>()>
+  requires(Bits >= 1u && Bits <= 57u)
+class packed_vector
+  {
+public:
+  using value_type = detail::packed::value_type_for_t<Bits, Signed>;
+  using unsigned_type = std::make_unsigned_t<value_type>;
+  using size_type = SizeType;
+  using storage_type = small_vector<uint64_t, size_type, InlineWords>;
+
+  static constexpr unsigned bit_width{Bits};
+  static constexpr bool is_signed{Signed};
+  static constexpr uint64_t value_mask{utils::bitmask_v<uint64_t, Bits>};
+
+private:
+  storage_type words_;
+  size_type size_{};
+
+  static constexpr bool use_window{std::endian::native == std::endian::little};
+
+  [[nodiscard]]
+  static constexpr auto words_for(size_type count) noexcept -> size_type
+    {
+    if(count == 0u)
+      return 0u;
+    return static_cast<size_type>((uint64_t{count} * Bits + 63u) / 64u + 1u);
+    }
+
+  [[nodiscard]]
+  static constexpr auto decode(uint64_t raw) noexcept -> value_type
+    {
+    return utils::detail::uncompress_value<Bits, value_type>(raw);
+    }
+
+  [[nodiscard]]
+  static constexpr auto encode(value_type value) noexcept -> uint64_t
+    {
+    return uint64_t{utils::detail::compress_value<Bits>(value)};
+    }
+
+  [[nodiscard]]
+  constexpr auto load(size_type index) const noexcept -> uint64_t
+    {
+    uint64_t const bit{uint64_t{index} * Bits};
+    if constexpr(use_window)
+      if(!std::is_constant_evaluated())
+        {
+        uint64_t window;
+        small_vectors_clang_unsafe_buffer_usage_begin  //
+          std::memcpy(&window, reinterpret_cast<unsigned char const *>(words_.data()) + bit / 8u, sizeof(window));
+        small_vectors_clang_unsafe_buffer_usage_end  //
+          return (window >> (bit % 8u)) & value_mask;
+        }
+    auto const word{static_cast<size_type>(bit / 64u)};
+    auto const shift{static_cast<unsigned>(bit % 64u)};
+    uint64_t raw{words_[word] >> shift};
+    if(shift + Bits > 64u)
+      raw |= words_[word + 1u] << (64u - shift);
+    return raw & value_mask;
+    }
+
+  constexpr void store(size_type index, uint64_t raw) noexcept
+    {
+    uint64_t const bit{uint64_t{index} * Bits};
+    if constexpr(use_window)
+      if(!std::is_constant_evaluated())
+        {
+        small_vectors_clang_unsafe_buffer_usage_begin  //
+          unsigned char * const at{reinterpret_cast<unsigned char *>(words_.data()) + bit / 8u};
+        small_vectors_clang_unsafe_buffer_usage_end  //
+          uint64_t window;
+        std::memcpy(&window, at, sizeof(window));
+        auto const shift{static_cast<unsigned>(bit % 8u)};
+        window = (window & ~(value_mask << shift)) | (raw << shift);
+        std::memcpy(at, &window, sizeof(window));
+        return;
+        }
+    auto const word{static_cast<size_type>(bit / 64u)};
+    auto const shift{static_cast<unsigned>(bit % 64u)};
+    words_[word] = (words_[word] & ~(value_mask << shift)) | (raw << shift);
+    if(shift + Bits > 64u)
+      {
+      unsigned const spill{64u - shift};
+      words_[word + 1u] = (words_[word + 1u] & ~(value_mask >> spill)) | (raw >> spill);
+      }
+    }
+
+  ///\brief zeroes bits past last value after shrinking
+  constexpr void clear_tail() noexcept
+    {
+    uint64_t const used_bits{uint64_t{size_} * Bits};
+    auto const used_words{static_cast<size_type>((used_bits + 63u) / 64u)};
+    if(used_bits % 64u != 0u)
+      words_[used_words - 1u] &= utils::bitmask_v<uint64_t, 64u> >> (64u - used_bits % 64u);
+    for(size_type ix{used_words}; ix != words_.size(); ++ix)
+      words_[ix] = 0u;
+    }
+
+public:
+  constexpr packed_vector() noexcept = default;
+
+  constexpr explicit packed_vector(size_type count, value_type value = {}) { resize(count, value); }
+
+  constexpr packed_vector(std::initializer_list<value_type> init) { append(std::span{init.begin(), init.size()}); }
+
+  [[nodiscard]]
+  constexpr auto size() const noexcept -> size_type
+    {
+    return size_;
+    }
+
+  [[nodiscard]]
+  constexpr auto empty() const noexcept -> bool
+    {
+    return size_ == 0u;
+    }
+
+  ///\returns packed words, last one is spare and always zero
+  [[nodiscard]]
+  constexpr auto words() const noexcept -> std::span<uint64_t const>
+    {
+    return std::span{words_.data(), words_.size()};
+    }
+
+  ///\returns number of bytes used by packed words
+  [[nodiscard]]
+  constexpr auto memory_size() const noexcept -> std::size_t
+    {
+    return std::size_t{words_.capacity()} * sizeof(uint64_t);
+    }
+
+  constexpr void reserve(size_type count) { words_.reserve(words_for(count)); }
+
+  constexpr void clear() noexcept
+    {
+    words_.clear();
+    size_ = 0u;
+    }
+
+  [[nodiscard]]
+  constexpr auto operator[](size_type index) const noexcept -> value_type
+    {
+    assert(index < size_);
+    return decode(load(index));
+    }
+
+  [[nodiscard]]
+  constexpr auto get(size_type index) const noexcept -> value_type
+    {
+    return (*this)[index];
+    }
+
+  ///\brief stores \p value truncated to Bits
+  constexpr void set(size_type index, value_type value) noexcept
+    {
+    assert(index < size_);
+    store(index, encode(value));
+    }
+
+  [[nodiscard]]
+  constexpr auto back() const noexcept -> value_type
+    {
+    return (*this)[size_ - 1u];
+    }
+
+  ///\brief appends \p value, storage grows geometrically
+  constexpr void push_back(value_type value)
+    {
+    size_type const required{words_for(static_cast<size_type>(size_ + 1u))};
+    // single value is narrower than word so at most one word is added
+    while(words_.size() < required)
+      words_.push_back(0u);
+    store(size_, encode(value));
+    ++size_;
+    }
+
+  constexpr void pop_back() noexcept
+    {
+    assert(size_ != 0u);
+    --size_;
+    store(size_, 0u);
+    if(size_ == 0u)
+      words_.clear();
+    else
+      words_.resize(words_for(size_));
+    }
+
+  constexpr void append(std::span<value_type const> values)
+    {
+    auto const first{size_};
+    resize(static_cast<size_type>(size_ + values.size()));
+    for(std::size_t ix{}; ix != values.size(); ++ix)
+      store(static_cast<size_type>(first + ix), encode(values[ix]));
+    }
+
+  constexpr void resize(size_type count, value_type value = {})
+    {
+    auto const old_size{size_};
+    if(count < old_size)
+      {
+      size_ = count;
+      clear_tail();
+      words_.resize(words_for(count));
+      return;
+      }
+    words_.resize(words_for(count));
+    size_ = count;
+    if(uint64_t const raw{encode(value)}; raw != 0u)
+      for(size_type ix{old_size}; ix != count; ++ix)
+        store(ix, raw);
+    }
+
+  ///\brief decodes \p out.size() consecutive values starting at \p first
+  constexpr void unpack(size_type first, std::span<value_type> out) const noexcept
+    {
+    assert(uint64_t{first} + out.size() <= size_);
+    std::size_t ix{};
+#if defined(__AVX2__)
+    if constexpr(use_window && Bits <= detail::packed::simd_max_bits)
+      if(!std::is_constant_evaluated())
+        ix = unpack_simd(first, out);
+#endif
+    for(; ix != out.size(); ++ix)
+      out[ix] = decode(load(static_cast<size_type>(first + ix)));
+    }
+
+  ///\returns view of all values in order
+  [[nodiscard]]
+  constexpr auto values() const noexcept
+    {
+    return std::views::iota(size_type{}, size_)
+           | std::views::transform([this](size_type index) noexcept -> value_type { return (*this)[index]; });
+    }
+
+  [[nodiscard]]
+  constexpr auto operator==(packed_vector const & r) const noexcept -> bool
+    {
+    return size_ == r.size_ && std::ranges::equal(words_, r.words_);
+    }
+
+private:
+#if defined(__AVX2__)
+  ///\returns number of values decoded, remaining ones are left for scalar path
+  auto unpack_simd(size_type first, std::span<value_type> out) const noexcept -> std::size_t
+    {
+    static constexpr auto layout{detail::packed::make_simd_layout<Bits>()};
+    static constexpr std::size_t high_lane_offset{4u * Bits / 8u};
+    std::size_t ix{};
+    // scalar values until group of 8 starts at byte boundary
+    for(; ix != out.size() && (uint64_t{first} + ix) % 8u != 0u; ++ix)
+      out[ix] = decode(load(static_cast<size_type>(first + ix)));
+
+    auto const * const bytes{reinterpret_cast<unsigned char const *>(words_.data())};
+    std::size_t const byte_count{std::size_t{words_.size()} * sizeof(uint64_t)};
+    __m256i const shuffle{_mm256_loadu_si256(reinterpret_cast<__m256i const *>(layout.shuffle.data()))};
+    __m256i const shifts{_mm256_loadu_si256(reinterpret_cast<__m256i const *>(layout.shifts.data()))};
+    __m256i const mask{_mm256_set1_epi32(static_cast<int>(utils::bitmask_v<uint32_t, Bits>))};
+    for(; out.size() - ix >= 8u; ix += 8u)
+      {
+      std::size_t const group_byte{(uint64_t{first} + ix) / 8u * Bits};
+      if(group_byte + high_lane_offset + 16u > byte_count)
+        break;
+      small_vectors_clang_unsafe_buffer_usage_begin  //
+        __m256i packed{_mm256_loadu2_m128i(
+          reinterpret_cast<__m128i const *>(bytes + group_byte + high_lane_offset),
+          reinterpret_cast<__m128i const *>(bytes + group_byte)
+        )};
+      small_vectors_clang_unsafe_buffer_usage_end  //
+        packed = _mm256_and_si256(_mm256_srlv_epi32(_mm256_shuffle_epi8(packed, shuffle), shifts), mask);
+      if constexpr(Signed && Bits < 32u)
+        packed = _mm256_srai_epi32(_mm256_slli_epi32(packed, 32 - int{Bits}), 32 - int{Bits});
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(out.subspan(ix, 8u).data()), packed);
+      }
+    return ix;
+    }
+#endif
+  };
+  }  // namespace small_vectors::inline v3_3
@@ -0,0 +1,361 @@
+#pragma once
+
+#include <small_vectors/basic_string.h>
+#include <small_vectors/detail/string_search.h>
+#include <small_vectors/utils/hash.h>
+#include <small_vectors/utils/static_call_operator.h>
+#include <atomic>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+namespace small_vectors::inline v3_3
+  {
+///\brief immutable string with O(1) copies
+///\details text fitting in-class buffer is stored inline exactly like in basic_string, longer text lives in heap block
+/// prefixed with atomic reference count shared by all copies, so copy is one relaxed increment and destruction of last
+/// copy frees the block. Content never changes after construction so sharing needs no further synchronization.
+/// Atomics are not usable in constant evaluation so this class is not constexpr
+template<typename CharType, uint64_t N = detail::buffer_traits<CharType>::capacity>
+class [[clang::trivial_abi]] basic_shared_string
+  {
+public:
+  using value_type = CharType;
+  using char_type = value_type;
+  using size_type = uint32_t;
+  using view_type = std::basic_string_view<char_type>;
+  using traits_type = std::char_traits<char_type>;
+  using const_iterator = detail::adapter_iterator<char_type const *>;
+  using iterator = const_iterator;
+
+  static constexpr size_type npos{std::numeric_limits<size_type>::max()};
+
+private:
+  struct block_t
+    {
+    std::atomic<std::size_t> references;
+    };
+
+  size_type size_{};
+
+  union
+    {
+    char_type buffered_[N]{};
+    block_t * block_;
+    };
+
+public:
+  /// \returns the number of characters that are stored inline without allocation
+  [[nodiscard]]
+  static constexpr auto buffered_capacity() noexcept -> size_type
+    {
+    return static_cast<size_type>(N - 1u);
+    }
+
+  /// \returns The largest possible number of characters, one less than size_type range for null termination
+  [[nodiscard]]
+  static constexpr auto max_size() noexcept -> size_type
+    {
+    return std::numeric_limits<size_type>::max() - 1u;
+    }
+
+  basic_shared_string() noexcept {}
+
+  ///\brief copies text of \p s, allocates when it does not fit in-class buffer
+  ///\warning throws std::length_error when \p s is longer than max_size()
+  template<std::convertible_to<view_type> source_type>
+  explicit basic_shared_string(source_type const & s)
+    {
+    view_type const text{static_cast<view_type>(s)};
+    if(text.size() > max_size()) [[unlikely]]
+      throw std::length_error{"Out of buffer space"};
+    size_ = static_cast<size_type>(text.size());
+    char_type * target;
+    if(is_buffered())
+      target = &buffered_[0];
+    else
+      {
+      block_ = allocate(size_);
+      target = heap_chars(block_);
+      }
+    traits_type::copy(target, text.data(), text.size());
+    small_vectors_clang_unsafe_buffer_usage_begin  //
+      target[size_] = char_type{};
+    small_vectors_clang_unsafe_buffer_usage_end  //
+    }
+
+  basic_shared_string(basic_shared_string const & rh) noexcept : size_{rh.size_}
+    {
+    if(is_buffered())
+      traits_type::copy(&buffered_[0], &rh.buffered_[0], N);
+    else
+      {
+      block_ = rh.block_;
+      block_->references.fetch_add(1u, std::memory_order_relaxed);
+      }
+    }
+
+  basic_shared_string(basic_shared_string && rh) noexcept : size_{rh.size_}
+    {
+    if(is_buffered())
+      traits_type::copy(&buffered_[0], &rh.buffered_[0], N);
+    else
+      {
+      block_ = rh.block_;
+      rh.reset();
+      }
+    }
+
+  ~basic_shared_string() { release(); }
+
+  auto operator=(basic_shared_string const & rh) noexcept -> basic_shared_string &
+    {
+    basic_shared_string copy{rh};
+    swap(copy);
+    return *this;
+    }
+
+  auto operator=(basic_shared_string && rh) noexcept -> basic_shared_string &
+    {
+    basic_shared_string moved{std::move(rh)};
+    swap(moved);
+    return *this;
+    }
+
+  void swap(basic_shared_string & other) noexcept
+    {
+    basic_shared_string * l{this};
+    basic_shared_string * r{&other};
+    if(l->is_buffered() && r->is_buffered())
+      {
+      std::swap(l->size_, r->size_);
+      std::swap(l->buffered_, r->buffered_);
+      return;
+      }
+    // one of strings is heap, swap through block pointer without touching reference count
+    if(l->is_buffered())
+      std::swap(l, r);
+    block_t * const block{l->block_};
+    size_type const size{l->size_};
+    l->size_ = r->size_;
+    if(r->is_buffered())
+      traits_type::copy(&l->buffered_[0], &r->buffered_[0], N);
+    else
+      l->block_ = r->block_;
+    r->size_ = size;
+    r->block_ = block;
+    }
+
+  [[nodiscard]]
+  auto is_buffered() const noexcept -> bool
+    {
+    return size_ <= buffered_capacity();
+    }
+
+  ///\returns number of strings sharing heap block, 0 when text is stored in-class
+  [[nodiscard]]
+  auto use_count() const noexcept -> std::size_t
+    {
+    return is_buffered() ? 0u : block_->references.load(std::memory_order_relaxed);
+    }
+
+  [[nodiscard]]
+  auto size() const noexcept -> size_type
+    {
+    return size_;
+    }
+
+  [[nodiscard]]
+  auto length() const noexcept -> size_type
+    {
+    return size_;
+    }
+
+  [[nodiscard]]
+  auto empty() const noexcept -> bool
+    {
+    return size_ == 0u;
+    }
+
+  [[nodiscard]]
+  auto data() const noexcept -> char_type const *
+    {
+    return is_buffered() ? &buffered_[0] : heap_chars(block_);
+    }
+
+  [[nodiscard]]
+  auto c_str() const noexcept -> char_type const *
+    {
+    return data();
+    }
+
+  [[nodiscard]]
+  auto view() const noexcept -> view_type
+    {
+    return view_type{data(), size_};
+    }
+
+  operator view_type() const noexcept { return view(); }
+
+  [[nodiscard]]
+  auto begin() const noexcept -> const_iterator
+    {
+    return const_iterator{data()};
+    }
+
+  [[nodiscard]]
+  auto end() const noexcept -> const_iterator
+    {
+    small_vectors_clang_unsafe_buffer_usage_begin  //
+      return const_iterator{data() + size_};
+    small_vectors_clang_unsafe_buffer_usage_end  //
+    }
+
+  [[nodiscard]]
+  auto operator[](concepts::unsigned_arithmetic_integral auto index) const noexcept -> char_type const &
+    {
+    small_vectors_clang_unsafe_buffer_usage_begin  //
+      return data()[index];
+    small_vectors_clang_unsafe_buffer_usage_end  //
+    }
+
+  ///\returns view of at most \p count characters from \p pos, empty view when \p pos is past end
+  [[nodiscard]]
+  auto substr(size_type pos, size_type count = npos) const noexcept -> view_type
+    {
+    view_type const text{view()};
+    if(pos >= text.size())
+      return {};
+    return text.substr(pos, count);
+    }
+
+  [[nodiscard]]
+  auto find(view_type s, size_type pos = 0u) const noexcept -> size_type
+    {
+    return static_cast<size_type>(detail::string::search(view(), s, pos));
+    }
+
+  [[nodiscard]]
+  auto contains(view_type s) const noexcept -> bool
+    {
+    return find(s) != npos;
+    }
+
+  [[nodiscard]]
+  auto starts_with(view_type s) const noexcept -> bool
+    {
+    return view().starts_with(s);
+    }
+
+  [[nodiscard]]
+  auto ends_with(view_type s) const noexcept -> bool
+    {
+    return view().ends_with(s);
+    }
+
+  ///\brief mutable copy as basic_string_t
+  template<typename string_type = basic_string<char_type>>
+    requires std::constructible_from<string_type, view_type>
+  [[nodiscard]]
+  auto to_string() const -> string_type
+    {
+    return string_type{view()};
+    }
+
+  [[nodiscard]]
+  friend auto operator==(basic_shared_string const & l, basic_shared_string const & r) noexcept -> bool
+    {
+    // copies share block so equality of blocks is answered without comparing text
+    if(!l.is_buffered() && !r.is_buffered() && l.block_ == r.block_)
+      return true;
+    return l.view() == r.view();
+    }
+
+  [[nodiscard]]
+  friend auto operator==(basic_shared_string const & l, std::convertible_to<view_type> auto const & r) noexcept -> bool
+    {
+    return l.view() == static_cast<view_type>(r);
+    }
+
+  [[nodiscard]]
+  friend auto operator<=>(basic_shared_string const & l, basic_shared_string const & r) noexcept
+    {
+    return l.view() <=> r.view();
+    }
+
+  [[nodiscard]]
+  friend auto operator<=>(basic_shared_string const & l, std::convertible_to<view_type> auto const & r) noexcept
+    {
+    return l.view() <=> static_cast<view_type>(r);
+    }
+
+private:
+  ///\returns number of block_t sized units holding reference count, \p size characters and null terminator
+  static constexpr auto block_units(size_type size) noexcept -> std::size_t
+    {
+    return 1u + ((std::size_t{size} + 1u) * sizeof(char_type) + sizeof(block_t) - 1u) / sizeof(block_t);
+    }
+
+  static auto allocate(size_type size) -> block_t *
+    {
+    block_t * const block{std::allocator<block_t>{}.allocate(block_units(size))};
+    std::construct_at(block);
+    block->references.store(1u, std::memory_order_relaxed);
+    return block;
+    }
+
+  static auto heap_chars(block_t * block) noexcept -> char_type *
+    {
+    small_vectors_clang_unsafe_buffer_usage_begin  //
+      return reinterpret_cast<char_type *>(block + 1);
+    small_vectors_clang_unsafe_buffer_usage_end  //
+    }
+
+  void reset() noexcept
+    {
+    size_ = 0u;
+    buffered_[0] = char_type{};
+    }
+
+  void release() noexcept
+    {
+    if(!is_buffered() && block_->references.fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+      {
+      std::destroy_at(block_);
+      std::allocator<block_t>{}.deallocate(block_, block_units(size_));
+      }
+    }
+  };
+
+using shared_string = basic_shared_string<char>;
+using shared_u8string = basic_shared_string<char8_t>;
+using shared_u16string = basic_shared_string<char16_t>;
+using shared_u32string = basic_shared_string<char32_t>;
+using shared_wstring = basic_shared_string<wchar_t>;
+
+template<typename char_type, uint64_t N>
+inline void swap(basic_shared_string<char_type, N> & l, basic_shared_string<char_type, N> & r) noexcept
+  {
+  l.swap(r);
+  }
+  }  // namespace small_vectors::inline v3_3
+
+namespace std
+  {
+template<typename char_type, uint64_t N>
+struct hash<small_vectors::basic_shared_string<char_type, N>>
+  {
+  small_vector_static_call_operator inline auto operator()(small_vectors::basic_shared_string<char_type, N> const & str
+  ) small_vector_static_call_operator_const noexcept -> std::size_t
+    {
+    return static_cast<std::size_t>(small_vectors::utils::wyhash(str.view()));
+    }
+  };
+  }  // namespace std
@@ -0,0 +1,348 @@
+#pragma once
+
+#include <small_vectors/basic_fixed_string.h>
+#include <small_vectors/small_vector.h>
+#include <small_vectors/utils/hash.h>
+#include <small_vectors/utils/static_call_operator.h>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+
+namespace small_vectors::inline v3_3
+  {
+namespace detail::string_pool
+  {
+  ///\brief immutable interned string, for pool entries characters and null terminator follow header in arena
+  template<typename char_type>
+  struct entry_header
+    {
+    uint64_t hash;
+    uint64_t size;
+    char_type const * data;
+    };
+
+  /// characters of compile time entries are the template parameter object of key itself
+  template<basic_fixed_string key>
+  inline constexpr entry_header<typename decltype(key)::char_type> static_entry_v{
+    utils::wyhash(key.view()), key.size(), key.data()
+  };
+
+  template<typename char_type>
+  inline constexpr char_type empty_chars_v[1]{};
+
+  template<typename char_type>
+  inline constexpr entry_header<char_type> empty_entry_v{
+    utils::wyhash(std::basic_string_view<char_type>{}), 0u, &empty_chars_v<char_type>[0]
+  };
+
+  struct no_lock
+    {
+    static constexpr void lock() noexcept {}
+
+    static constexpr void unlock() noexcept {}
+    };
+  }  // namespace detail::string_pool
+
+///\brief handle to string interned in basic_string_pool or at compile time with interned<"text">
+///\details handle is single pointer to immutable entry so equality is pointer comparison and hash is read from entry,
+/// strings interned in the same pool are equal only when their content is equal. Handles stay valid as long as pool
+/// that produced them, compile time handles are valid forever
+template<typename CharType>
+class basic_interned_string
+  {
+public:
+  using char_type = CharType;
+  using view_type = std::basic_string_view<char_type>;
+  using size_type = std::size_t;
+
+private:
+  using entry_header = detail::string_pool::entry_header<char_type>;
+
+  entry_header const * entry_{&detail::string_pool::empty_entry_v<char_type>};
+
+public:
+  constexpr basic_interned_string() noexcept = default;
+
+  explicit constexpr basic_interned_string(entry_header const * entry) noexcept : entry_{entry} {}
+
+  [[nodiscard]]
+  constexpr auto size() const noexcept -> size_type
+    {
+    return static_cast<size_type>(entry_->size);
+    }
+
+  [[nodiscard]]
+  constexpr auto empty() const noexcept -> bool
+    {
+    return entry_->size == 0u;
+    }
+
+  ///\returns wyhash of content, same as basic_string_hash of the text
+  [[nodiscard]]
+  constexpr auto hash() const noexcept -> std::size_t
+    {
+    return static_cast<std::size_t>(entry_->hash);
+    }
+
+  [[nodiscard]]
+  constexpr auto data() const noexcept -> char_type const *
+    {
+    return entry_->data;
+    }
+
+  [[nodiscard]]
+  constexpr auto c_str() const noexcept -> char_type const *
+    {
+    return entry_->data;
+    }
+
+  [[nodiscard]]
+  constexpr auto view() const noexcept -> view_type
+    {
+    return view_type{data(), size()};
+    }
+
+  constexpr operator view_type() const noexcept { return view(); }
+
+  [[nodiscard]]
+  constexpr auto entry() const noexcept -> entry_header const *
+    {
+    return entry_;
+    }
+
+  [[nodiscard]]
+  constexpr auto operator==(basic_interned_string const &) const noexcept -> bool = default;
+  };
+
+using interned_string = basic_interned_string<char>;
+using interned_u8string = basic_interned_string<char8_t>;
+using interned_wstring = basic_interned_string<wchar_t>;
+
+///\brief handle of \p key interned at compile time, pools seeded with it return this same handle for the text
+template<basic_fixed_string key>
+inline constexpr basic_interned_string<typename decltype(key)::char_type> interned{
+  &detail::string_pool::static_entry_v<key>
+};
+
+enum struct string_pool_locking_e : uint8_t
+  {
+    /// pool is used by single thread at a time
+    none,
+    /// every operation locks one of shard_count shards selected by hash
+    sharded
+  };
+
+///\brief interning pool storing every distinct string once
+///\details text is copied into arena chunks next to its hash and length, index is open addressing table of entry
+/// pointers with linear probing. With sharded locking hash selects one of shards each with own mutex, arena and index
+/// so threads interning different strings rarely contend. Pool can be seeded with compile time interned<"key">
+/// handles which are indexed without copying and returned for matching text
+template<typename CharType, string_pool_locking_e Locking = string_pool_locking_e::none>
+class basic_string_pool
+  {
+public:
+  using char_type = CharType;
+  using view_type = std::basic_string_view<char_type>;
+  using handle_type = basic_interned_string<char_type>;
+  using size_type = std::size_t;
+
+  static constexpr size_type shard_count{Locking == string_pool_locking_e::sharded ? 16u : 1u};
+  static constexpr size_type chunk_size{16u * 1024u};
+
+private:
+  using entry_header = detail::string_pool::entry_header<char_type>;
+  using mutex_type
+    = std::conditional_t<Locking == string_pool_locking_e::sharded, std::mutex, detail::string_pool::no_lock>;
+
+  struct shard_t
+    {
+    mutable mutex_type mutex;
+    small_vector<std::unique_ptr<std::byte[]>, uint32_t, 0> chunks;
+    std::byte * cursor{};
+    size_type remaining{};
+    /// power of two sized, nullptr marks free slot
+    small_vector<entry_header const *, uint32_t, 0> slots;
+    size_type count{};
+
+    [[nodiscard]]
+    auto find(view_type text, uint64_t hash) const noexcept -> entry_header const *
+      {
+      if(slots.empty())
+        return nullptr;
+      size_type const mask{slots.size() - 1u};
+      for(size_type ix{static_cast<size_type>(hash) & mask};; ix = (ix + 1u) & mask)
+        {
+        entry_header const * entry{slots[ix]};
+        if(entry == nullptr)
+          return nullptr;
+        if(entry->hash == hash && entry->size == text.size()
+           && view_type{entry->data, text.size()} == text)
+          return entry;
+        }
+      }
+
+    void insert(entry_header const * entry)
+      {
+      if((count + 1u) * 8u > slots.size() * 7u)
+        rehash(std::max<size_type>(16u, slots.size() * 2u));
+      place(entry);
+      ++count;
+      }
+
+    auto allocate(view_type text, uint64_t hash) -> entry_header const *
+      {
+      constexpr size_type alignment{alignof(entry_header)};
+      size_type const bytes{
+        (sizeof(entry_header) + (text.size() + 1u) * sizeof(char_type) + alignment - 1u) & ~(alignment - 1u)
+      };
+      if(bytes > remaining)
+        {
+        // large strings get dedicated chunk so current chunk is not abandoned
+        size_type const size{std::max(bytes, chunk_size)};
+        chunks.emplace_back(std::make_unique_for_overwrite<std::byte[]>(size));
+        if(size != chunk_size)
+          return construct(chunks.back().get(), text, hash);
+        cursor = chunks.back().get();
+        remaining = size;
+        }
+      entry_header const * entry{construct(cursor, text, hash)};
+      small_vectors_clang_unsafe_buffer_usage_begin  //
+        cursor += bytes;
+      small_vectors_clang_unsafe_buffer_usage_end  //
+        remaining -= bytes;
+      return entry;
+      }
+
+  private:
+    static auto construct(std::byte * memory, view_type text, uint64_t hash) noexcept -> entry_header const *
+      {
+      small_vectors_clang_unsafe_buffer_usage_begin  //
+        auto * chars{reinterpret_cast<char_type *>(memory + sizeof(entry_header))};
+      std::char_traits<char_type>::copy(chars, text.data(), text.size());
+      chars[text.size()] = char_type{};
+      small_vectors_clang_unsafe_buffer_usage_end  //
+        return std::construct_at(reinterpret_cast<entry_header *>(memory), hash, uint64_t{text.size()}, chars);
+      }
+
+    void place(entry_header const * entry) noexcept
+      {
+      size_type const mask{slots.size() - 1u};
+      size_type ix{static_cast<size_type>(entry->hash) & mask};
+      while(slots[ix] != nullptr)
+        ix = (ix + 1u) & mask;
+      slots[ix] = entry;
+      }
+
+    void rehash(size_type new_size)
+      {
+      small_vector<entry_header const *, uint32_t, 0> old(static_cast<uint32_t>(new_size));
+      old.swap(slots);
+      for(entry_header const * entry: old)
+        if(entry != nullptr)
+          place(entry);
+      }
+    };
+
+  std::array<shard_t, shard_count> shards_;
+
+  [[nodiscard]]
+  static constexpr auto shard_index(uint64_t hash) noexcept -> size_type
+    {
+    if constexpr(shard_count == 1u)
+      return 0u;
+    else
+      return static_cast<size_type>(hash >> (64 - std::countr_zero(shard_count)));
+    }
+
+public:
+  basic_string_pool() = default;
+
+  ///\brief pool seeded with compile time interned handles, text of seeds is not copied
+  basic_string_pool(std::initializer_list<handle_type> seeds)
+    {
+    for(handle_type seed: seeds)
+      this->seed(seed);
+    }
+
+  basic_string_pool(basic_string_pool const &) = delete;
+  auto operator=(basic_string_pool const &) -> basic_string_pool & = delete;
+
+  ///\brief adds handle with static lifetime to index, returns already interned handle when text is present
+  auto seed(handle_type handle) -> handle_type
+    {
+    shard_t & shard{shards_[shard_index(handle.entry()->hash)]};
+    std::lock_guard lock{shard.mutex};
+    if(entry_header const * existing{shard.find(handle.view(), handle.entry()->hash)}; existing != nullptr)
+      return handle_type{existing};
+    shard.insert(handle.entry());
+    return handle;
+    }
+
+  ///\returns handle of \p text interning it on first use
+  auto intern(view_type text) -> handle_type
+    {
+    uint64_t const hash{utils::wyhash(text)};
+    shard_t & shard{shards_[shard_index(hash)]};
+    std::lock_guard lock{shard.mutex};
+    entry_header const * entry{shard.find(text, hash)};
+    if(entry == nullptr)
+      {
+      entry = shard.allocate(text, hash);
+      shard.insert(entry);
+      }
+    return handle_type{entry};
+    }
+
+  ///\returns handle of \p text when it was interned before
+  [[nodiscard]]
+  auto find(view_type text) const -> std::optional<handle_type>
+    {
+    uint64_t const hash{utils::wyhash(text)};
+    shard_t const & shard{shards_[shard_index(hash)]};
+    std::lock_guard lock{shard.mutex};
+    if(entry_header const * entry{shard.find(text, hash)}; entry != nullptr)
+      return handle_type{entry};
+    return std::nullopt;
+    }
+
+  ///\returns number of distinct strings in pool
+  [[nodiscard]]
+  auto size() const -> size_type
+    {
+    size_type result{};
+    for(shard_t const & shard: shards_)
+      {
+      std::lock_guard lock{shard.mutex};
+      result += shard.count;
+      }
+    return result;
+    }
+  };
+
+using string_pool = basic_string_pool<char>;
+using concurrent_string_pool = basic_string_pool<char, string_pool_locking_e::sharded>;
+  }  // namespace small_vectors::inline v3_3
+
+namespace std
+  {
+template<typename char_type>
+struct hash<small_vectors::basic_interned_string<char_type>>
+  {
+  small_vector_static_call_operator constexpr auto operator()(small_vectors::basic_interned_string<char_type> str
+  ) small_vector_static_call_operator_const noexcept -> std::size_t
+    {
+    return str.hash();
+    }
+  };
+  }  // namespace std
@@ -0,0 +1,272 @@
+#pragma once
+
+#include <small_vectors/utils/unaligned.h>
+#include <small_vectors/utils/endian.h>
+#include <small_vectors/utils/expected.h>
+#include <small_vectors/small_vector.h>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <ranges>
+#include <span>
+
+namespace small_vectors::inline v3_3::memutil
+  {
+enum struct cursor_error_e : uint8_t
+  {
+    /// input has fewer bytes than requested
+    short_input
+  };
+
+///\brief unchecked cursor over bytes reserved with byte_reader::require
+///\details bounds were verified once for whole record so individual fields are read without checks, overrun is only
+/// asserted
+class byte_record_reader
+  {
+  std::span<std::byte const> data_;
+  std::size_t pos_{};
+
+public:
+  constexpr byte_record_reader() noexcept = default;
+
+  explicit constexpr byte_record_reader(std::span<std::byte const> data) noexcept : data_{data} {}
+
+  [[nodiscard]]
+  constexpr auto remaining() const noexcept -> std::size_t
+    {
+    return data_.size() - pos_;
+    }
+
+  ///\returns value stored with byte order \p stored_endian, byte order comes first like in write, read_n and write_n
+  template<utils::endian stored_endian, detail::byte_swappable value_type>
+  [[nodiscard]]
+  constexpr auto read() noexcept -> value_type
+    {
+    assert(remaining() >= sizeof(value_type));
+    auto value{unaligned_load<value_type>(std::ranges::next(data_.begin(), static_cast<std::ptrdiff_t>(pos_)))};
+    pos_ += sizeof(value_type);
+    if constexpr(stored_endian != utils::endian::native)
+      value = detail::byteswap_value(value);
+    return value;
+    }
+
+  ///\returns value stored little endian
+  template<detail::byte_swappable value_type>
+  [[nodiscard]]
+  constexpr auto read() noexcept -> value_type
+    {
+    return read<utils::endian::little, value_type>();
+    }
+
+  ///\brief fills contiguous range \p out with values stored with byte order \p stored_endian
+  template<utils::endian stored_endian = utils::endian::little, std::ranges::contiguous_range range_type>
+  constexpr void read_n(range_type && out) noexcept
+    {
+    auto const size{std::ranges::size(out) * sizeof(std::ranges::range_value_t<range_type>)};
+    assert(remaining() >= size);
+    unaligned_load_n<stored_endian>(data_.subspan(pos_).data(), out);
+    pos_ += size;
+    }
+
+  ///\returns next \p count raw bytes
+  [[nodiscard]]
+  constexpr auto bytes(std::size_t count) noexcept -> std::span<std::byte const>
+    {
+    assert(remaining() >= count);
+    auto const result{data_.subspan(pos_, count)};
+    pos_ += count;
+    return result;
+    }
+
+  constexpr void skip(std::size_t count) noexcept
+    {
+    assert(remaining() >= count);
+    pos_ += count;
+    }
+  };
+
+///\brief bounds checked cursor reading typed fields from byte span
+///\details reading whole record starts with require(n) which checks remaining size once and returns unchecked
+/// byte_record_reader over next n bytes, single field reads check bounds individually. Short input is reported
+/// with cursor_error_e::short_input and leaves position unchanged
+class byte_reader
+  {
+  std::span<std::byte const> data_;
+  std::size_t pos_{};
+
+public:
+  constexpr byte_reader() noexcept = default;
+
+  explicit constexpr byte_reader(std::span<std::byte const> data) noexcept : data_{data} {}
+
+  [[nodiscard]]
+  constexpr auto position() const noexcept -> std::size_t
+    {
+    return pos_;
+    }
+
+  [[nodiscard]]
+  constexpr auto remaining() const noexcept -> std::size_t
+    {
+    return data_.size() - pos_;
+    }
+
+  [[nodiscard]]
+  constexpr auto at_end() const noexcept -> bool
+    {
+    return pos_ == data_.size();
+    }
+
+  ///\brief reserves next \p count bytes for record read without further bounds checks
+  [[nodiscard]]
+  constexpr auto require(std::size_t count) noexcept -> cxx23::expected<byte_record_reader, cursor_error_e>
+    {
+    if(count > remaining()) [[unlikely]]
+      return cxx23::unexpected{cursor_error_e::short_input};
+    byte_record_reader const record{data_.subspan(pos_, count)};
+    pos_ += count;
+    return record;
+    }
+
+  ///\returns value stored with byte order \p stored_endian or cursor_error_e::short_input
+  template<utils::endian stored_endian, detail::byte_swappable value_type>
+  [[nodiscard]]
+  constexpr auto read() noexcept -> cxx23::expected<value_type, cursor_error_e>
+    {
+    return require(sizeof(value_type))
+      .transform([](byte_record_reader record) noexcept
+                 { return record.template read<stored_endian, value_type>(); });
+    }
+
+  ///\returns value stored little endian or cursor_error_e::short_input
+  template<detail::byte_swappable value_type>
+  [[nodiscard]]
+  constexpr auto read() noexcept -> cxx23::expected<value_type, cursor_error_e>
+    {
+    return read<utils::endian::little, value_type>();
+    }
+
+  template<utils::endian stored_endian = utils::endian::little, std::ranges::contiguous_range range_type>
+  [[nodiscard]]
+  constexpr auto read_n(range_type && out) noexcept -> cxx23::expected<void, cursor_error_e>
+    {
+    auto record{require(std::ranges::size(out) * sizeof(std::ranges::range_value_t<range_type>))};
+    if(!record) [[unlikely]]
+      return cxx23::unexpected{record.error()};
+    record->template read_n<stored_endian>(std::forward<range_type>(out));
+    return {};
+    }
+
+  [[nodiscard]]
+  constexpr auto bytes(std::size_t count) noexcept -> cxx23::expected<std::span<std::byte const>, cursor_error_e>
+    {
+    return require(count).transform([count](byte_record_reader record) noexcept { return record.bytes(count); });
+    }
+
+  [[nodiscard]]
+  constexpr auto skip(std::size_t count) noexcept -> cxx23::expected<void, cursor_error_e>
+    {
+    if(count > remaining()) [[unlikely]]
+      return cxx23::unexpected{cursor_error_e::short_input};
+    pos_ += count;
+    return {};
+    }
+  };
+
+///\brief unchecked cursor over bytes appended with byte_writer::require, valid until next call on writer
+class byte_record_writer
+  {
+  std::span<std::byte> data_;
+  std::size_t pos_{};
+
+public:
+  constexpr byte_record_writer() noexcept = default;
+
+  explicit constexpr byte_record_writer(std::span<std::byte> data) noexcept : data_{data} {}
+
+  [[nodiscard]]
+  constexpr auto remaining() const noexcept -> std::size_t
+    {
+    return data_.size() - pos_;
+    }
+
+  template<utils::endian stored_endian = utils::endian::little, detail::byte_swappable value_type>
+  constexpr auto write(value_type value) noexcept -> byte_record_writer &
+    {
+    assert(remaining() >= sizeof(value_type));
+    if constexpr(stored_endian != utils::endian::native)
+      value = detail::byteswap_value(value);
+    unaligned_store<value_type>(std::ranges::next(data_.begin(), static_cast<std::ptrdiff_t>(pos_)), value);
+    pos_ += sizeof(value_type);
+    return *this;
+    }
+
+  template<utils::endian stored_endian = utils::endian::little, std::ranges::contiguous_range range_type>
+  constexpr auto write_n(range_type const & values) noexcept -> byte_record_writer &
+    {
+    auto const size{std::ranges::size(values) * sizeof(std::ranges::range_value_t<range_type>)};
+    assert(remaining() >= size);
+    unaligned_store_n<stored_endian>(data_.subspan(pos_).data(), values);
+    pos_ += size;
+    return *this;
+    }
+
+  constexpr auto bytes(std::span<std::byte const> source) noexcept -> byte_record_writer &
+    {
+    assert(remaining() >= source.size());
+    std::ranges::copy(source, std::ranges::next(data_.begin(), static_cast<std::ptrdiff_t>(pos_)));
+    pos_ += source.size();
+    return *this;
+    }
+  };
+
+///\brief cursor appending typed fields to byte vector
+///\details backing vector grows geometrically, require(n) grows it once for whole record and returns unchecked
+/// byte_record_writer over appended bytes. Source of bytes() must not point into backing vector
+template<typename byte_vector = small_vector<std::byte, uint64_t, 0>>
+  requires std::same_as<typename byte_vector::value_type, std::byte>
+class byte_writer
+  {
+  byte_vector & out_;
+
+public:
+  explicit constexpr byte_writer(byte_vector & out) noexcept : out_{out} {}
+
+  [[nodiscard]]
+  constexpr auto size() const noexcept -> std::size_t
+    {
+    return static_cast<std::size_t>(out_.size());
+    }
+
+  ///\brief appends \p count bytes for record written without further growth
+  [[nodiscard]]
+  constexpr auto require(std::size_t count) -> byte_record_writer
+    {
+    auto const pos{out_.size()};
+    out_.resize(static_cast<typename byte_vector::size_type>(pos + count));
+    return byte_record_writer{std::span<std::byte>{out_.data(), size()}.subspan(static_cast<std::size_t>(pos), count)};
+    }
+
+  template<utils::endian stored_endian = utils::endian::little, detail::byte_swappable value_type>
+  constexpr auto write(value_type value) -> byte_writer &
+    {
+    require(sizeof(value_type)).template write<stored_endian>(value);
+    return *this;
+    }
+
+  template<utils::endian stored_endian = utils::endian::little, std::ranges::contiguous_range range_type>
+  constexpr auto write_n(range_type const & values) -> byte_writer &
+    {
+    require(std::ranges::size(values) * sizeof(std::ranges::range_value_t<range_type>))
+      .template write_n<stored_endian>(values);
+    return *this;
+    }
+
+  constexpr auto bytes(std::span<std::byte const> source) -> byte_writer &
+    {
+    require(source.size()).bytes(source);
+    return *this;
+    }
+  };
+  }  // namespace small_vectors::inline v3_3::memutil
@@ -13,6 +13,81 @@
 #define SMALL_VECTORS_EXPECTED_API 2
 
 #include <version>
+#include <concepts>
+#include <type_traits>
+#include <utility>
+#include <cassert>
+
+namespace cxx23
+  {
+///\brief customization point moving discriminator of expected<T, E> into value representation of T
+///\details specialization declares that some bit patterns of T are never valid values and encodes every error into
+/// them with static constexpr member functions
+///   is_error(T const & stored) -> bool
+///   encode_error(E const & error) -> T
+///   decode_error(T const & stored) -> E
+/// expected<T, E> then holds single T without separate bool, has size and alignment of T and error() returns E by
+/// value. Both types must be trivially copyable. Specializations are ignored when std::expected is used
+template<typename T, typename E>
+struct expected_niche
+  {
+  };
+
+///\brief niche for values never equal to \p sentinel, the only error \p error is stored as sentinel
+///\details suits lookups returning non null pointer or valid index with single failure reason
+template<typename T, T sentinel, typename E, E error>
+struct sentinel_niche
+  {
+  [[nodiscard]]
+  static constexpr auto is_error(T const & stored) noexcept -> bool
+    {
+    return stored == sentinel;
+    }
+
+  [[nodiscard]]
+  static constexpr auto encode_error(E const & value) noexcept -> T
+    {
+    assert(value == error);
+    return sentinel;
+    }
+
+  [[nodiscard]]
+  static constexpr auto decode_error(T const &) noexcept -> E
+    {
+    return error;
+    }
+  };
+
+///\brief niche for non negative signed values with positive error codes stored negated like -errno
+template<std::signed_integral T, typename E>
+  requires std::is_enum_v<E> || std::integral<E>
+struct negative_error_niche
+  {
+  [[nodiscard]]
+  static constexpr auto is_error(T const & stored) noexcept -> bool
+    {
+    return stored < T{};
+    }
+
+  [[nodiscard]]
+  static constexpr auto encode_error(E const & error) noexcept -> T
+    {
+    T code;
+    if constexpr(std::is_enum_v<E>)
+      code = static_cast<T>(static_cast<std::underlying_type_t<E>>(error));
+    else
+      code = static_cast<T>(error);
+    assert(code > T{});
+    return static_cast<T>(-code);
+    }
+
+  [[nodiscard]]
+  static constexpr auto decode_error(T const & stored) noexcept -> E
+    {
+    return static_cast<E>(-stored);
+    }
+  };
+  }  // namespace cxx23
 
 #if !defined(SMALL_VECTORS_ENABLE_CUSTOM_EXCPECTED) && defined(__cpp_lib_expected) && __cpp_lib_expected >= 202211L
 #include <expected>
@@ -96,6 +171,22 @@ namespace concepts
     requires !std::same_as<T, unexpect_t>;
   };
 
+  ///\brief expected_niche<T, E> is specialized and both types are trivially copyable
+  template<typename T, typename E>
+  concept niche_expected = requires(T const & stored, E const & error) {
+    requires std::is_trivially_copyable_v<T> && std::is_trivially_copyable_v<E>;
+    { expected_niche<T, E>::is_error(stored) } -> std::same_as<bool>;
+    { expected_niche<T, E>::encode_error(error) } -> std::same_as<T>;
+    { expected_niche<T, E>::decode_error(stored) } -> std::same_as<E>;
+  };
+
+  ///\brief value initialized T is value state of niche, false also when is_error is not usable in constant expression
+  template<typename T, typename E>
+  concept niche_default_value = requires {
+    requires std::is_default_constructible_v<T>;
+    typename std::bool_constant<expected_niche<T, E>::is_error(T{})>;
+  } && (!expected_niche<T, E>::is_error(T{}));
+
   template<typename T, typename E>
   concept swap_constraints = requires {
     requires std::is_swappable_v<T> || std::is_void_v<T>;
@@ -1398,6 +1489,396 @@ public:
   friend constexpr void swap(expected & lhs, expected & rhs) noexcept(noexcept(lhs.swap(rhs))) { lhs.swap(rhs); }
   };
 
+///\brief expected with discriminator stored in niche of value representation declared by expected_niche<T, E>
+///\details holds single T, value state is any T for which expected_niche<T, E>::is_error is false and error state
+/// is encoded error. Instantiation is as large as T and trivially copyable so it is passed and returned in registers
+/// like T itself. error() returns decoded error by value
+template<typename T, typename E>
+  requires concepts::niche_expected<T, E>
+class [[nodiscard, clang::trivial_abi]] expected<T, E>
+  {
+public:
+  static_assert(concepts::unexpected_constraint<E>, "not a valid type for expected error type");
+  static_assert(concepts::expected_constraint<T>, "not a valid type for expected value type");
+  using value_type = T;
+  using error_type = E;
+  using unexpected_type = unexpected<E>;
+  template<typename U>
+  using rebind = expected<U, error_type>;
+
+private:
+  using niche_type = expected_niche<T, E>;
+  using bad_access_exception = bad_expected_access<std::decay_t<error_type>>;
+
+  value_type stored_;
+
+  [[nodiscard]]
+  static constexpr auto checked_value(value_type value) noexcept -> value_type
+    {
+    assert(!niche_type::is_error(value));
+    return value;
+    }
+
+public:
+  ///\brief value initialized value, unavailable when it is error of niche like nullptr of sentinel_niche<T *, nullptr>
+  constexpr expected() noexcept(std::is_nothrow_default_constructible_v<value_type>)
+    requires concepts::niche_default_value<T, E>
+      : stored_{value_type{}}
+    {
+    }
+
+  constexpr expected(expected const &) noexcept = default;
+  constexpr expected(expected &&) noexcept = default;
+
+  template<typename U, typename G>
+    requires requires {
+      requires std::is_constructible_v<T, std::add_lvalue_reference_t<U const>>;
+      requires std::is_constructible_v<E, G const &>;
+      requires concepts::expected_conv_constr<T, E, U, G>;
+    }
+  constexpr explicit(!std::is_convertible_v<std::add_lvalue_reference_t<U const>, T> || !std::is_convertible_v<G const &, E>) expected(expected<U, G> const & rh) :
+      stored_{
+        rh.has_value() ? checked_value(value_type(rh.value())) : niche_type::encode_error(error_type(rh.error()))
+      }
+    {
+    }
+
+  template<typename U, typename G>
+    requires requires {
+      requires std::is_constructible_v<T, U>;
+      requires std::is_constructible_v<E, G>;
+      requires concepts::expected_conv_constr<T, E, U, G>;
+    }
+  constexpr explicit(!std::is_convertible_v<U, T> || !std::is_convertible_v<G, E>) expected(expected<U, G> && rh) :
+      stored_{
+        rh.has_value() ? checked_value(value_type(std::move(rh).value()))
+                       : niche_type::encode_error(error_type(std::move(rh).error()))
+      }
+    {
+    }
+
+  template<typename U = T>
+    requires requires {
+      requires !std::same_as<std::remove_cvref_t<U>, std::in_place_t>;
+      requires !std::same_as<expected, std::remove_cvref_t<U>>;
+      requires std::is_constructible_v<T, U>;
+      requires !concepts::is_unexpected<std::remove_cvref_t<U>>;
+      requires !std::same_as<bool, T> || !concepts::is_expected<std::remove_cvref_t<U>>;
+    }
+  constexpr explicit(!std::is_convertible_v<U, T>
+  ) expected(U && v) noexcept(std::is_nothrow_constructible_v<value_type, decltype(std::forward<U>(v))>) :
+      stored_{checked_value(value_type(std::forward<U>(v)))}
+    {
+    }
+
+  template<typename... Args>
+    requires std::constructible_from<value_type, Args...>
+  constexpr explicit expected(std::in_place_t, Args &&... args) noexcept(
+    std::is_nothrow_constructible_v<value_type, Args...>
+  ) : stored_{checked_value(value_type(std::forward<Args>(args)...))}
+    {
+    }
+
+  template<typename... Args>
+    requires std::constructible_from<error_type, Args...>
+  constexpr explicit expected(unexpect_t, Args &&... args) noexcept(
+    std::is_nothrow_constructible_v<error_type, Args...>
+  ) : stored_{niche_type::encode_error(error_type(std::forward<Args>(args)...))}
+    {
+    }
+
+  template<typename G>
+    requires std::is_constructible_v<E, G const &>
+  constexpr explicit(!std::is_convertible_v<G const &, error_type>) expected(unexpected<G> const & e) :
+      stored_{niche_type::encode_error(error_type(e.error()))}
+    {
+    }
+
+  template<typename G>
+    requires std::is_constructible_v<E, G>
+  constexpr explicit(!std::is_convertible_v<G, E>) expected(unexpected<G> && e) :
+      stored_{niche_type::encode_error(error_type(std::move(e).error()))}
+    {
+    }
+
+  constexpr ~expected() = default;
+
+  constexpr auto operator=(expected const &) noexcept -> expected & = default;
+  constexpr auto operator=(expected &&) noexcept -> expected & = default;
+
+  template<typename Up = value_type>
+    requires(
+      not std::is_same_v<expected, std::remove_cvref_t<Up>> && not concepts::is_unexpected<std::remove_cvref_t<Up>>
+      and std::is_constructible_v<value_type, Up>
+    )
+  constexpr auto operator=(Up && v) -> expected &
+    {
+    stored_ = checked_value(value_type(std::forward<Up>(v)));
+    return *this;
+    }
+
+  template<typename G>
+    requires std::is_constructible_v<error_type, G const &>
+  constexpr auto operator=(unexpected<G> const & e) -> expected &
+    {
+    stored_ = niche_type::encode_error(error_type(e.error()));
+    return *this;
+    }
+
+  template<typename G>
+    requires std::is_constructible_v<error_type, G>
+  constexpr auto operator=(unexpected<G> && e) -> expected &
+    {
+    stored_ = niche_type::encode_error(error_type(std::move(e).error()));
+    return *this;
+    }
+
+  [[nodiscard]]
+  constexpr auto operator->() const noexcept -> value_type const *
+    {
+    assert(has_value());
+    return std::addressof(stored_);
+    }
+
+  [[nodiscard]]
+  constexpr auto operator->() noexcept -> value_type *
+    {
+    assert(has_value());
+    return std::addressof(stored_);
+    }
+
+  [[nodiscard]]
+  constexpr auto operator*() const & noexcept -> value_type const &
+    {
+    assert(has_value());
+    return stored_;
+    }
+
+  [[nodiscard]]
+  constexpr auto operator*() & noexcept -> value_type &
+    {
+    assert(has_value());
+    return stored_;
+    }
+
+  [[nodiscard]]
+  constexpr auto operator*() const && noexcept -> value_type const &&
+    {
+    assert(has_value());
+    return std::move(stored_);
+    }
+
+  [[nodiscard]]
+  constexpr auto operator*() && noexcept -> value_type &&
+    {
+    assert(has_value());
+    return std::move(stored_);
+    }
+
+  [[nodiscard]]
+  constexpr explicit operator bool() const noexcept
+    {
+    return has_value();
+    }
+
+  [[nodiscard]]
+  constexpr bool has_value() const noexcept
+    {
+    return !niche_type::is_error(stored_);
+    }
+
+  [[nodiscard]]
+  constexpr auto value() & -> value_type &
+    {
+    if(has_value()) [[likely]]
+      return stored_;
+    else
+      throw bad_access_exception{error()};
+    }
+
+  [[nodiscard]]
+  constexpr auto value() const & -> value_type const &
+    {
+    if(has_value()) [[likely]]
+      return stored_;
+    else
+      throw bad_access_exception{error()};
+    }
+
+  [[nodiscard]]
+  constexpr auto value() && -> value_type &&
+    {
+    if(has_value()) [[likely]]
+      return std::move(stored_);
+    else
+      throw bad_access_exception{error()};
+    }
+
+  [[nodiscard]]
+  constexpr auto value() const && -> value_type const &&
+    {
+    if(has_value()) [[likely]]
+      return std::move(stored_);
+    else
+      throw bad_access_exception{error()};
+    }
+
+  [[nodiscard]]
+  constexpr auto error() const noexcept -> error_type
+    {
+    assert(!has_value());
+    return niche_type::decode_error(stored_);
+    }
+
+  template<typename U>
+    requires std::is_convertible_v<U, value_type>
+  [[nodiscard]]
+  constexpr auto value_or(U && default_value) const noexcept(std::is_nothrow_convertible_v<U, value_type>)
+    -> value_type
+    {
+    return has_value() ? stored_ : static_cast<value_type>(std::forward<U>(default_value));
+    }
+
+  template<typename F>
+  constexpr auto and_then(F && f) &
+    {
+    return detail::and_then(*this, std::forward<F>(f));
+    }
+
+  template<typename F>
+  constexpr auto and_then(F && f) const &
+    {
+    return detail::and_then(*this, std::forward<F>(f));
+    }
+
+  template<typename F>
+  constexpr auto and_then(F && f) &&
+    {
+    return detail::and_then(std::move(*this), std::forward<F>(f));
+    }
+
+  template<typename F>
+  constexpr auto and_then(F && f) const &&
+    {
+    return detail::and_then(std::move(*this), std::forward<F>(f));
+    }
+
+  template<typename F>
+  constexpr auto transform(F && f) &
+    {
+    return detail::transform(*this, std::forward<F>(f));
+    }
+
+  template<typename F>
+  constexpr auto transform(F && f) const &
+    {
+    return detail::transform(*this, std::forward<F>(f));
+    }
+
+  template<typename F>
+  constexpr auto transform(F && f) &&
+    {
+    return detail::transform(std::move(*this), std::forward<F>(f));
+    }
+
+  template<typename F>
+  constexpr auto transform(F && f) const &&
+    {
+    return detail::transform(std::move(*this), std::forward<F>(f));
+    }
+
+  template<typename F>
+  constexpr auto or_else(F && f) &
+    {
+    return detail::or_else(*this, std::forward<F>(f));
+    }
+
+  template<typename F>
+  constexpr auto or_else(F && f) const &
+    {
+    return detail::or_else(*this, std::forward<F>(f));
+    }
+
+  template<typename F>
+  constexpr auto or_else(F && f) &&
+    {
+    return detail::or_else(std::move(*this), std::forward<F>(f));
+    }
+
+  template<typename F>
+  constexpr auto or_else(F && f) const &&
+    {
+    return detail::or_else(std::move(*this), std::forward<F>(f));
+    }
+
+  template<typename F>
+  constexpr auto transform_error(F && f) &
+    {
+    return detail::transform_error(*this, std::forward<F>(f));
+    }
+
+  template<typename F>
+  constexpr auto transform_error(F && f) const &
+    {
+    return detail::transform_error(*this, std::forward<F>(f));
+    }
+
+  template<typename F>
+  constexpr auto transform_error(F && f) &&
+    {
+    return detail::transform_error(std::move(*this), std::forward<F>(f));
+    }
+
+  template<typename F>
+  constexpr auto transform_error(F && f) const &&
+    {
+    return detail::transform_error(std::move(*this), std::forward<F>(f));
+    }
+
+  template<typename... Args>
+    requires std::is_nothrow_constructible_v<value_type, Args...>
+  constexpr auto emplace(Args &&... args) noexcept -> value_type &
+    {
+    stored_ = checked_value(value_type(std::forward<Args>(args)...));
+    return stored_;
+    }
+
+  constexpr void swap(expected & other) noexcept { std::swap(stored_, other.stored_); }
+
+  template<typename T2, typename E2>
+    requires requires {
+      requires(!std::is_void_v<T2>);
+      requires std::equality_comparable_with<value_type, T2>;
+      requires std::equality_comparable_with<error_type, E2>;
+    }
+  friend constexpr bool operator==(expected const & lhs, expected<T2, E2> const & rhs) noexcept
+    {
+    if(lhs.has_value() != rhs.has_value())
+      return false;
+    if(lhs.has_value())
+      return *lhs == *rhs;
+    return lhs.error() == rhs.error();
+    }
+
+  template<typename T2>
+    requires requires {
+      requires concepts::not_expected<T2>;
+      requires std::equality_comparable_with<value_type, T2>;
+    }
+  friend constexpr bool operator==(expected const & x, T2 const & val) noexcept
+    {
+    return x.has_value() && *x == val;
+    }
+
+  template<std::equality_comparable_with<error_type> E2>
+  friend constexpr bool operator==(expected const & x, unexpected<E2> const & e) noexcept
+    {
+    return !x.has_value() && x.error() == e.error();
+    }
+
+  friend constexpr void swap(expected & lhs, expected & rhs) noexcept { lhs.swap(rhs); }
+  };
+
 namespace detail
   {
   template<typename F, typename T>
@@ -1454,8 +1935,13 @@ namespace detail
     if(ex.has_value())
       if constexpr(std::is_void_v<typename expected_type::value_type>)
         {
-        std::invoke(std::forward<F>(f));
-        return expected<U, error_type>{std::in_place};
+        if constexpr(std::is_void_v<U>)
+          {
+          std::invoke(std::forward<F>(f));
+          return expected<U, error_type>{std::in_place};
+          }
+        else
+          return expected<U, error_type>{std::in_place, std::invoke(std::forward<F>(f))};
         }
       else
         return expected<U, error_type>{std::in_place, std::invoke(std::forward<F>(f), std::forward<EX>(ex).value())};
@@ -1466,10 +1952,11 @@ namespace detail
   template<typename EX, typename F>
   constexpr auto or_else(EX && ex, F && f)
     {
+    using expected_type = std::remove_cvref_t<EX>;
     using G = std::remove_cvref_t<std::invoke_result_t<F, decltype(std::forward<EX>(ex).error())>>;
-    static_assert(std::is_same_v<typename G::value_type, typename EX::value_type>);
+    static_assert(std::is_same_v<typename G::value_type, typename expected_type::value_type>);
     if(ex.has_value())
-      if constexpr(std::is_void_v<typename EX::value_type>)
+      if constexpr(std::is_void_v<typename expected_type::value_type>)
         return G();
       else
         return G(std::in_place, std::forward<EX>(ex).value());
@@ -1498,7 +1985,15 @@ namespace detail
   struct swap_expected_t
     {
     template<typename T, typename E>
-    static constexpr void operator()(expected<T, E> & l, expected<T, E> & r) noexcept(detail::swap_no_throw<T, E>)
+#if defined(__cpp_static_call_operator)
+    static
+#endif
+      constexpr void
+      operator()(expected<T, E> & l, expected<T, E> & r)
+#if !defined(__cpp_static_call_operator)
+        const
+#endif
+      noexcept(detail::swap_no_throw<T, E>)
       requires concepts::swap_constraints<T, E>
       {
       if(l.has_value() && r.has_value())
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <small_vectors/version.h>
+#include <small_vectors/utils/static_call_operator.h>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+namespace small_vectors::inline v3_3::utils
+  {
+namespace detail
+  {
+  inline constexpr std::array<uint64_t, 4> wyhash_secret{
+    0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2d4a3ae1a0d9ull
+  };
+
+  ///\brief full 64x64 -> 128 bit multiply, low half is stored in \p a and high in \p b
+  inline constexpr void wymum(uint64_t & a, uint64_t & b) noexcept
+    {
+#if defined(__SIZEOF_INT128__)
+    __extension__ using uint128_t = unsigned __int128;
+    uint128_t const r{static_cast<uint128_t>(a) * b};
+    a = static_cast<uint64_t>(r);
+    b = static_cast<uint64_t>(r >> 64u);
+#else
+    uint64_t const ha{a >> 32u}, hb{b >> 32u}, la{a & 0xffff'ffffu}, lb{b & 0xffff'ffffu};
+    uint64_t const rh{ha * hb}, rm0{ha * lb}, rm1{hb * la}, rl{la * lb};
+    uint64_t const t{rl + (rm0 << 32u)};
+    uint64_t const c0{t < rl ? 1u : 0u};
+    uint64_t const lo{t + (rm1 << 32u)};
+    uint64_t const c1{lo < t ? 1u : 0u};
+    a = lo;
+    b = rh + (rm0 >> 32u) + (rm1 >> 32u) + c0 + c1;
+#endif
+    }
+
+  inline constexpr auto wymix(uint64_t a, uint64_t b) noexcept -> uint64_t
+    {
+    wymum(a, b);
+    return a ^ b;
+    }
+
+  ///\brief little endian byte view of character sequence
+  ///\details code units wider than byte are split into bytes arithmetically in constant evaluation and on big endian
+  /// targets so hash of given text is the same at compile time and run time
+  template<typename char_type>
+  struct byte_source_t
+    {
+    char_type const * data;
+
+    [[nodiscard]]
+    constexpr auto byte(std::size_t index) const noexcept -> uint64_t
+      {
+      small_vectors_clang_unsafe_buffer_usage_begin  //
+        using unsigned_type = std::make_unsigned_t<char_type>;
+      auto const unit{static_cast<unsigned_type>(data[index / sizeof(char_type)])};
+      small_vectors_clang_unsafe_buffer_usage_end  //
+        return (static_cast<uint64_t>(unit) >> (8u * (index % sizeof(char_type)))) & 0xffu;
+      }
+
+    ///\returns \p count <= 8 bytes starting at \p index as little endian integer
+    [[nodiscard]]
+    constexpr auto read(std::size_t index, std::size_t count) const noexcept -> uint64_t
+      {
+      if constexpr(std::endian::native == std::endian::little)
+        if(!std::is_constant_evaluated())
+          {
+          uint64_t result{};
+          small_vectors_clang_unsafe_buffer_usage_begin  //
+            std::memcpy(&result, reinterpret_cast<unsigned char const *>(data) + index, count);
+          small_vectors_clang_unsafe_buffer_usage_end  //
+            return result;
+          }
+      uint64_t result{};
+      for(std::size_t ix{}; ix != count; ++ix)
+        result |= byte(index + ix) << (8u * ix);
+      return result;
+      }
+    };
+  }  // namespace detail
+
+///\brief wyhash (final version 4) of character sequence, 64 bit non cryptographic hash
+///\details short keys are mixed with two 128 bit multiplies, longer consume 48 bytes per round in three independent
+/// lanes so multiplies of one round overlap in pipeline. Text is hashed as its little endian byte representation
+/// and result is identical in constant evaluation and at run time
+struct wyhash_t
+  {
+  template<typename char_type>
+    requires std::is_integral_v<char_type>
+  small_vector_static_call_operator constexpr auto operator()(
+    std::basic_string_view<char_type> text, uint64_t seed = 0u
+  ) small_vector_static_call_operator_const noexcept -> uint64_t
+    {
+    using detail::wymix;
+    using detail::wyhash_secret;
+    detail::byte_source_t<char_type> const src{text.data()};
+    std::size_t const length{text.size() * sizeof(char_type)};
+    seed ^= wymix(seed ^ wyhash_secret[0], wyhash_secret[1]);
+    uint64_t a{}, b{};
+    if(length <= 16u)
+      {
+      if(length >= 4u)
+        {
+        std::size_t const step{(length >> 3u) << 2u};
+        a = (src.read(0u, 4u) << 32u) | src.read(step, 4u);
+        b = (src.read(length - 4u, 4u) << 32u) | src.read(length - 4u - step, 4u);
+        }
+      else if(length > 0u)
+        a = (src.byte(0u) << 16u) | (src.byte(length >> 1u) << 8u) | src.byte(length - 1u);
+      }
+    else
+      {
+      std::size_t offset{};
+      std::size_t remaining{length};
+      if(remaining > 48u)
+        {
+        uint64_t see1{seed}, see2{seed};
+        do
+          {
+          seed = wymix(src.read(offset, 8u) ^ wyhash_secret[1], src.read(offset + 8u, 8u) ^ seed);
+          see1 = wymix(src.read(offset + 16u, 8u) ^ wyhash_secret[2], src.read(offset + 24u, 8u) ^ see1);
+          see2 = wymix(src.read(offset + 32u, 8u) ^ wyhash_secret[3], src.read(offset + 40u, 8u) ^ see2);
+          offset += 48u;
+          remaining -= 48u;
+          } while(remaining > 48u);
+        seed ^= see1 ^ see2;
+        }
+      while(remaining > 16u)
+        {
+        seed = wymix(src.read(offset, 8u) ^ wyhash_secret[1], src.read(offset + 8u, 8u) ^ seed);
+        offset += 16u;
+        remaining -= 16u;
+        }
+      a = src.read(offset + remaining - 16u, 8u);
+      b = src.read(offset + remaining - 8u, 8u);
+      }
+    a ^= wyhash_secret[1];
+    b ^= seed;
+    detail::wymum(a, b);
+    return wymix(a ^ wyhash_secret[0] ^ length, b ^ wyhash_secret[1]);
+    }
+  };
+
+inline constexpr wyhash_t wyhash;
+  }  // namespace small_vectors::inline v3_3::utils
@@ -4,9 +4,18 @@
 
 #include <type_traits>
 #include <cstdint>
+#include <cstring>
 #include <utility>
 #include <cassert>
 #include <concepts>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <ranges>
+#include <span>
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
 
 namespace small_vectors::inline v3_3::utils
   {
@@ -180,8 +189,8 @@ namespace detail
     // cast meta to exactly my self inherited type
     member_type const & self = static_cast<member_type const &>(ms);
     constexpr unsigned bit_width = member_type::bit_width();
+    // value is masked to bit_width so narrowing of wide member type to pack_type is lossless
     auto value(compress_value<bit_width>(self.value));
-    static_assert(sizeof(decltype(value)) <= sizeof(pack_type));
     auto my_value_packed = static_cast<pack_type>(value) << offset;
     if constexpr(std::is_same_v<void, next_member_t>)
       return static_cast<pack_type>(my_value_packed);
@@ -207,7 +216,7 @@ namespace detail
       return static_cast<value_type>(v);
     else
       {
-      bool const sign_bit{(v & (1u << (bit_width - 1))) != 0};
+      bool const sign_bit{(v & (U{1} << (bit_width - 1))) != 0};
       if(!sign_bit)
         return static_cast<value_type>(v);
       else
@@ -309,4 +318,308 @@ constexpr decltype(auto) get(meta_packed_struct && s)
   return detail::get<tag_value>(std::forward<meta_packed_struct>(s));
   }
 
+namespace detail
+  {
+  template<typename member_type>
+  consteval auto signed_member() noexcept -> bool
+    {
+    using value_type = typename member_type::value_t;
+    if constexpr(std::is_enum_v<value_type>)
+      return std::is_signed_v<std::underlying_type_t<value_type>>;
+    else
+      return std::is_signed_v<value_type>;
+    }
+
+  [[nodiscard]]
+  inline constexpr auto low_bits(unsigned count) noexcept -> uint64_t
+    {
+    return count >= 64u ? ~uint64_t{} : (uint64_t{1} << count) - 1u;
+    }
+
+  template<unsigned bits>
+  using pack_type_for_t = std::conditional_t<
+    bits <= 8u,
+    uint8_t,
+    std::conditional_t<bits <= 16u, uint16_t, std::conditional_t<bits <= 32u, uint32_t, uint64_t>>>;
+
+  ///\brief loads \p size bytes as little endian word with power of two sized loads
+  ///\details composing word in registers avoids store forwarding stall of narrow memcpy into wide stack variable
+  template<std::size_t size>
+  [[nodiscard]]
+  inline auto load_word(unsigned char const * src) noexcept -> uint64_t
+    {
+    constexpr std::size_t head{std::bit_floor(size)};
+    using head_type = pack_type_for_t<unsigned{head * 8u}>;
+    head_type value;
+    std::memcpy(&value, src, head);
+    if constexpr(head == size)
+      return value;
+    else
+      {
+      small_vectors_clang_unsafe_buffer_usage_begin  //
+        return uint64_t{value} | (load_word<size - head>(src + head) << (head * 8u));
+      small_vectors_clang_unsafe_buffer_usage_end  //
+      }
+    }
+
+  template<std::size_t size>
+  inline void store_word(unsigned char * dst, uint64_t word) noexcept
+    {
+    constexpr std::size_t head{std::bit_floor(size)};
+    using head_type = pack_type_for_t<unsigned{head * 8u}>;
+    auto const value{static_cast<head_type>(word)};
+    std::memcpy(dst, &value, head);
+    if constexpr(head != size)
+      {
+      small_vectors_clang_unsafe_buffer_usage_begin  //
+        store_word<size - head>(dst + head, word >> (head * 8u));
+      small_vectors_clang_unsafe_buffer_usage_end  //
+      }
+    }
+
+  template<typename meta_packed_struct>
+  struct packed_layout;
+
+  ///\brief position of members in object representation used to pack and unpack whole struct as single word
+  ///\details member bases are laid out in declaration order at alignment of their value type, structs up to 8 bytes
+  /// are loaded as little endian word. Pack is then _pext_u64 with mask of value bits of all members and unpack is
+  /// _pdep_u64 followed by branchless sign fill of signed members. Without BMI2 the same constant offsets give fixed
+  /// shift and mask sequence per word which compilers vectorize across elements
+  template<typename... Members>
+  struct packed_layout<meta_packed_struct<Members...>>
+    {
+    using struct_type = meta_packed_struct<Members...>;
+    static constexpr std::size_t count{sizeof...(Members)};
+    static constexpr std::array<unsigned, count> widths{Members::bit_width()...};
+    static constexpr std::array<unsigned, count> sizes{unsigned{sizeof(typename Members::value_t)}...};
+    static constexpr std::array<unsigned, count> alignments{unsigned{alignof(typename Members::value_t)}...};
+    static constexpr std::array<bool, count> is_signed{signed_member<Members>()...};
+
+    struct offsets_t
+      {
+      std::array<unsigned, count> pack{};
+      std::array<unsigned, count> object{};
+      unsigned object_size{};
+      };
+
+    static constexpr offsets_t offsets{[]
+                                       {
+                                         offsets_t result{};
+                                         unsigned pack_offset{};
+                                         unsigned object_offset{};
+                                         unsigned max_alignment{1u};
+                                         for(std::size_t ix{}; ix != count; ++ix)
+                                           {
+                                           result.pack[ix] = pack_offset;
+                                           pack_offset += widths[ix];
+                                           object_offset = (object_offset + alignments[ix] - 1u) / alignments[ix]
+                                                           * alignments[ix];
+                                           result.object[ix] = object_offset * 8u;
+                                           object_offset += sizes[ix];
+                                           max_alignment = std::max(max_alignment, alignments[ix]);
+                                           }
+                                         result.object_size
+                                           = (object_offset + max_alignment - 1u) / max_alignment * max_alignment;
+                                         return result;
+                                       }()};
+
+    /// word path is used only when computed layout agrees with compiler's one
+    static constexpr bool word_eligible{
+      sizeof(struct_type) <= sizeof(uint64_t) && sizeof(struct_type) == offsets.object_size
+      && std::is_trivially_copyable_v<struct_type> && std::endian::native == std::endian::little
+    };
+
+    struct masks_t
+      {
+      /// value bits of all members in object representation
+      uint64_t value{};
+      /// highest value bit of signed members narrower than their type
+      uint64_t sign{};
+      /// bits of signed members above their value bits
+      uint64_t fill{};
+      /// sum of one bit past end of every signed member, wraps for member ending at bit 64
+      uint64_t fill_base{};
+      };
+
+    static constexpr masks_t masks{[]
+                                   {
+                                     masks_t result{};
+                                     if constexpr(word_eligible)
+                                       for(std::size_t ix{}; ix != count; ++ix)
+                                         {
+                                         unsigned const offset{offsets.object[ix]};
+                                         unsigned const size_bits{sizes[ix] * 8u};
+                                         result.value |= low_bits(widths[ix]) << offset;
+                                         if(is_signed[ix] && widths[ix] < size_bits)
+                                           {
+                                           result.sign |= uint64_t{1} << (offset + widths[ix] - 1u);
+                                           result.fill |= (low_bits(size_bits) & ~low_bits(widths[ix])) << offset;
+                                           if(offset + size_bits < 64u)
+                                             result.fill_base += uint64_t{1} << (offset + size_bits);
+                                           }
+                                         }
+                                     return result;
+                                   }()};
+
+    [[nodiscard]]
+    static auto pack_word(uint64_t raw) noexcept -> uint64_t
+      {
+#if defined(__BMI2__)
+      return _pext_u64(raw, masks.value);
+#else
+      return [raw]<std::size_t... ix>(std::index_sequence<ix...>) noexcept
+      {
+        return (
+          uint64_t{} | ...
+          | (((raw >> offsets.object[ix]) & low_bits(widths[ix])) << offsets.pack[ix])
+        );
+      }(std::make_index_sequence<count>{});
+#endif
+      }
+
+    [[nodiscard]]
+    static auto unpack_word(uint64_t pack) noexcept -> uint64_t
+      {
+#if defined(__BMI2__)
+      uint64_t const raw{_pdep_u64(pack, masks.value)};
+#else
+      uint64_t const raw{[pack]<std::size_t... ix>(std::index_sequence<ix...>) noexcept
+                         {
+                           return (
+                             uint64_t{} | ...
+                             | (((pack >> offsets.pack[ix]) & low_bits(widths[ix])) << offsets.object[ix])
+                           );
+                         }(std::make_index_sequence<count>{})};
+#endif
+      // every set sign bit s turns its member part of fill_base - (s << 1) into ones above s, clear signs leave single
+      // bit past member end which is outside fill mask, parts of members do not overlap so there is no carry
+      uint64_t const signs{(raw & masks.sign) << 1u};
+      return raw | ((masks.fill_base - signs) & masks.fill);
+      }
+    };
+
+  }  // namespace detail
+
+///\brief packs every struct of \p in into corresponding element of \p out
+///\details structs fitting 8 bytes are packed with single pext (BMI2) or branchless shifts of their object
+/// representation, constant evaluation uses pack_value
+template<
+  std::unsigned_integral pack_type,
+  std::ranges::contiguous_range in_range,
+  std::ranges::contiguous_range out_range>
+  requires std::same_as<std::ranges::range_value_t<out_range>, pack_type>
+           && (sizeof(pack_type) * 8 >= bit_width<std::ranges::range_value_t<in_range>>())
+constexpr void pack_n(in_range const & in, out_range && out) noexcept
+  {
+  using struct_type = std::ranges::range_value_t<in_range>;
+  using layout_type = detail::packed_layout<struct_type>;
+  std::span<struct_type const> const source{std::ranges::data(in), std::ranges::size(in)};
+  std::span<pack_type> const target{std::ranges::data(out), std::ranges::size(out)};
+  assert(target.size() >= source.size());
+  if constexpr(layout_type::word_eligible)
+    if(!std::is_constant_evaluated())
+      {
+      for(std::size_t ix{}; ix != source.size(); ++ix)
+        {
+        uint64_t const raw{
+          detail::load_word<sizeof(struct_type)>(reinterpret_cast<unsigned char const *>(&source[ix]))
+        };
+        target[ix] = static_cast<pack_type>(layout_type::pack_word(raw));
+        }
+      return;
+      }
+  for(std::size_t ix{}; ix != source.size(); ++ix)
+    target[ix] = pack_value<pack_type>(source[ix]);
+  }
+
+///\brief unpacks every element of \p in into corresponding struct of \p out
+template<std::ranges::contiguous_range in_range, std::ranges::contiguous_range out_range>
+  requires std::unsigned_integral<std::ranges::range_value_t<in_range>>
+constexpr void unpack_n(in_range const & in, out_range && out) noexcept
+  {
+  using pack_type = std::ranges::range_value_t<in_range>;
+  using struct_type = std::ranges::range_value_t<out_range>;
+  using layout_type = detail::packed_layout<struct_type>;
+  std::span<pack_type const> const source{std::ranges::data(in), std::ranges::size(in)};
+  std::span<struct_type> const target{std::ranges::data(out), std::ranges::size(out)};
+  assert(target.size() >= source.size());
+  if constexpr(layout_type::word_eligible)
+    if(!std::is_constant_evaluated())
+      {
+      for(std::size_t ix{}; ix != source.size(); ++ix)
+        {
+        detail::store_word<sizeof(struct_type)>(
+          reinterpret_cast<unsigned char *>(&target[ix]), layout_type::unpack_word(source[ix])
+        );
+        }
+      return;
+      }
+  for(std::size_t ix{}; ix != source.size(); ++ix)
+    target[ix] = unpack_value<struct_type>(source[ix]);
+  }
+
+///\brief fixed size array of meta_packed_struct stored as contiguous packed words of smallest fitting type
+template<typename meta_packed_struct, std::size_t N>
+class packed_array
+  {
+public:
+  using value_type = meta_packed_struct;
+  using pack_type = detail::pack_type_for_t<bit_width<meta_packed_struct>()>;
+  using size_type = std::size_t;
+
+private:
+  std::array<pack_type, N> words_{};
+
+public:
+  constexpr packed_array() noexcept = default;
+
+  [[nodiscard]]
+  static constexpr auto size() noexcept -> size_type
+    {
+    return N;
+    }
+
+  [[nodiscard]]
+  constexpr auto operator[](size_type index) const noexcept -> value_type
+    {
+    return unpack_value<value_type>(words_[index]);
+    }
+
+  constexpr void set(size_type index, value_type const & value) noexcept
+    {
+    words_[index] = pack_value<pack_type>(value);
+    }
+
+  template<auto tag_value>
+    requires detail::enum_struct<decltype(tag_value)>
+  [[nodiscard]]
+  constexpr auto get(size_type index) const noexcept
+    {
+    return detail::get<tag_value>(unpack_value<value_type>(words_[index]));
+    }
+
+  ///\brief packs \p values into first values.size() elements
+  constexpr void assign(std::span<value_type const> values) noexcept
+    {
+    assert(values.size() <= N);
+    pack_n<pack_type>(values, words_);
+    }
+
+  ///\brief unpacks first out.size() elements into \p out
+  constexpr void unpack(std::span<value_type> out) const noexcept
+    {
+    assert(out.size() <= N);
+    unpack_n(std::span<pack_type const>{words_}.first(out.size()), out);
+    }
+
+  [[nodiscard]]
+  constexpr auto words() const noexcept -> std::span<pack_type const, N>
+    {
+    return words_;
+    }
+
+  [[nodiscard]]
+  constexpr auto operator==(packed_array const &) const noexcept -> bool = default;
+  };
+
   }  // namespace small_vectors::inline v3_3::utils
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <small_vectors/utils/utility_cxx20.h>
+#include <small_vectors/utils/endian.h>
 
 #include <cstdint>
 #include <type_traits>
@@ -9,6 +10,12 @@
 #include <concepts>
 #include <algorithm>
 #include <bit>
+#include <array>
+#include <ranges>
+#include <span>
+#if defined(__SSSE3__)
+#include <immintrin.h>
+#endif
 
 // -----------------------------------------------------------------------
 //
@@ -182,6 +189,148 @@ inline constexpr iterator unaligned_store(iterator it, input_type value) noexcep
   return detail::unaligned_store<store_type>(it, value);
   }
 
+//---------------------------------------------------------------------------------------------------
+namespace detail
+  {
+  template<typename type>
+  concept byte_swappable = arithmetic<type> && (sizeof(type) == 1 || sizeof(type) == 2 || sizeof(type) == 4
+                                                || sizeof(type) == 8);
+
+  template<std::size_t size>
+  using unsigned_of_size_t = std::conditional_t<
+    size == 2,
+    uint16_t,
+    std::conditional_t<size == 4, uint32_t, std::conditional_t<size == 8, uint64_t, uint8_t>>>;
+
+  template<byte_swappable value_type>
+  [[nodiscard, gnu::always_inline]]
+  inline constexpr auto byteswap_value(value_type value) noexcept -> value_type
+    {
+    if constexpr(sizeof(value_type) == 1)
+      return value;
+    else
+      {
+      using unsigned_type = unsigned_of_size_t<sizeof(value_type)>;
+      return cxx20::bit_cast<value_type>(cxx23::byteswap(cxx20::bit_cast<unsigned_type>(value)));
+      }
+    }
+
+  ///\brief copies \p count elements of \p element_size bytes reversing byte order of each element
+  ///\details whole registers are permuted with pshufb, 32 bytes per step with AVX2 and 16 with SSSE3, remaining
+  /// elements use bswap
+  template<std::size_t element_size>
+  inline void byteswap_copy(uint8_t const * src, uint8_t * dst, std::size_t count) noexcept
+    {
+    std::size_t const bytes{count * element_size};
+    std::size_t ix{};
+    small_vectors_clang_unsafe_buffer_usage_begin  //
+#if defined(__SSSE3__)
+      static constexpr auto shuffle{[]
+                                    {
+                                      std::array<char, 16> result{};
+                                      for(std::size_t i{}; i != result.size(); ++i)
+                                        result[i] = static_cast<char>(
+                                          (i / element_size) * element_size + element_size - 1u - i % element_size
+                                        );
+                                      return result;
+                                    }()};
+    __m128i const mask{_mm_loadu_si128(reinterpret_cast<__m128i const *>(shuffle.data()))};
+#if defined(__AVX2__)
+    __m256i const mask256{_mm256_broadcastsi128_si256(mask)};
+    for(; ix + 32u <= bytes; ix += 32u)
+      {
+      __m256i const data{_mm256_loadu_si256(reinterpret_cast<__m256i const *>(src + ix))};
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + ix), _mm256_shuffle_epi8(data, mask256));
+      }
+#endif
+    for(; ix + 16u <= bytes; ix += 16u)
+      {
+      __m128i const data{_mm_loadu_si128(reinterpret_cast<__m128i const *>(src + ix))};
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + ix), _mm_shuffle_epi8(data, mask));
+      }
+#endif
+    using unsigned_type = unsigned_of_size_t<element_size>;
+    for(; ix != bytes; ix += element_size)
+      {
+      unsigned_type value;
+      std::memcpy(&value, src + ix, element_size);
+      value = cxx23::byteswap(value);
+      std::memcpy(dst + ix, &value, element_size);
+      }
+    small_vectors_clang_unsafe_buffer_usage_end  //
+    }
+  }  // namespace detail
+
+///\brief fills contiguous range \p out with values stored back to back with byte order \p stored_endian at unaligned
+/// memory \p src
+///\details when byte order differs from native whole range is converted with SIMD byte shuffles, otherwise it is
+/// copied, in constant evaluation values are loaded one by one
+///\returns pointer past consumed bytes
+template<utils::endian stored_endian, std::ranges::contiguous_range range_type, typename byte_type>
+  requires(
+    detail::byte_swappable<std::ranges::range_value_t<range_type>> && sizeof(byte_type) == 1
+    && std::is_trivially_copyable_v<byte_type>
+  )
+[[gnu::always_inline]]
+inline constexpr auto unaligned_load_n(byte_type const * src, range_type && out) noexcept -> byte_type const *
+  {
+  using value_type = std::ranges::range_value_t<range_type>;
+  std::span<value_type> const out_span{std::ranges::data(out), std::ranges::size(out)};
+  constexpr bool swap{stored_endian != utils::endian::native && sizeof(value_type) != 1};
+  small_vectors_clang_unsafe_buffer_usage_begin  //
+    if(std::is_constant_evaluated())
+    {
+    for(value_type & value: out_span)
+      {
+      value = detail::unaligned_load<value_type>(src);
+      if constexpr(swap)
+        value = detail::byteswap_value(value);
+      src += sizeof(value_type);
+      }
+    return src;
+    }
+  auto const * bytes{reinterpret_cast<uint8_t const *>(src)};
+  if constexpr(swap)
+    detail::byteswap_copy<sizeof(value_type)>(bytes, reinterpret_cast<uint8_t *>(out_span.data()), out_span.size());
+  else
+    std::memcpy(out_span.data(), bytes, out_span.size_bytes());
+  return src + out_span.size_bytes();
+  small_vectors_clang_unsafe_buffer_usage_end  //
+  }
+
+///\brief stores values of contiguous range \p in back to back at unaligned memory with byte order \p stored_endian
+///\returns pointer past written bytes
+template<utils::endian stored_endian, std::ranges::contiguous_range range_type, typename byte_type>
+  requires(
+    detail::byte_swappable<std::ranges::range_value_t<range_type>> && sizeof(byte_type) == 1
+    && std::is_trivially_copyable_v<byte_type>
+  )
+[[gnu::always_inline]]
+inline constexpr auto unaligned_store_n(byte_type * dst, range_type const & in_range) noexcept -> byte_type *
+  {
+  using value_type = std::ranges::range_value_t<range_type>;
+  std::span<value_type const> const in{std::ranges::data(in_range), std::ranges::size(in_range)};
+  constexpr bool swap{stored_endian != utils::endian::native && sizeof(value_type) != 1};
+  small_vectors_clang_unsafe_buffer_usage_begin  //
+    if(std::is_constant_evaluated())
+    {
+    for(value_type value: in)
+      {
+      if constexpr(swap)
+        value = detail::byteswap_value(value);
+      dst = detail::unaligned_store<value_type>(dst, value);
+      }
+    return dst;
+    }
+  auto * bytes{reinterpret_cast<uint8_t *>(dst)};
+  if constexpr(swap)
+    detail::byteswap_copy<sizeof(value_type)>(reinterpret_cast<uint8_t const *>(in.data()), bytes, in.size());
+  else
+    std::memcpy(bytes, in.data(), in.size_bytes());
+  return dst + in.size_bytes();
+  small_vectors_clang_unsafe_buffer_usage_end  //
+  }
+
 //---------------------------------------------------------------------------------------------------
 ///\brief cast from void * for working with deprecated software like wxwidgets storing user data as void *
 ///\returns \ref data casted by value to output_type
@@ -0,0 +1,343 @@
+#pragma once
+
+#include <small_vectors/utils/unaligned.h>
+#include <small_vectors/utils/expected.h>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <span>
+#include <type_traits>
+#if defined(__SSSE3__)
+#include <immintrin.h>
+#endif
+
+namespace small_vectors::inline v3_3::utils
+  {
+namespace varint
+  {
+  enum struct error_e : uint8_t
+    {
+      /// input ended inside encoded value
+      truncated_input,
+      /// encoded value does not fit requested type
+      overflow
+    };
+
+  ///\brief maps signed values to unsigned so small magnitudes of both signs get short encodings
+  template<std::signed_integral value_type>
+  [[nodiscard]]
+  inline constexpr auto zigzag_encode(value_type value) noexcept -> std::make_unsigned_t<value_type>
+    {
+    using unsigned_type = std::make_unsigned_t<value_type>;
+    return static_cast<unsigned_type>(
+      static_cast<unsigned_type>(static_cast<unsigned_type>(value) << 1u)
+      ^ static_cast<unsigned_type>(value >> (sizeof(value_type) * 8u - 1u))
+    );
+    }
+
+  template<std::unsigned_integral value_type>
+  [[nodiscard]]
+  inline constexpr auto zigzag_decode(value_type value) noexcept -> std::make_signed_t<value_type>
+    {
+    return static_cast<std::make_signed_t<value_type>>(
+      static_cast<value_type>(value >> 1u) ^ static_cast<value_type>(value_type{} - (value & 1u))
+    );
+    }
+
+  /// maximum number of bytes of LEB128 encoding of \p value_type
+  template<std::integral value_type>
+  inline constexpr std::size_t max_size_v{(sizeof(value_type) * 8u + 6u) / 7u};
+
+  namespace detail
+    {
+    template<std::integral value_type>
+    [[nodiscard]]
+    inline constexpr auto to_unsigned(value_type value) noexcept
+      {
+      if constexpr(std::is_signed_v<value_type>)
+        return zigzag_encode(value);
+      else
+        return value;
+      }
+    }  // namespace detail
+
+  ///\returns number of bytes of LEB128 encoding of \p value, signed values are zigzag encoded
+  template<std::integral value_type>
+  [[nodiscard]]
+  inline constexpr auto encoded_size(value_type value) noexcept -> std::size_t
+    {
+    auto u{detail::to_unsigned(value)};
+    std::size_t size{1u};
+    for(; u >= 0x80u; u = static_cast<decltype(u)>(u >> 7u))
+      ++size;
+    return size;
+    }
+
+  ///\brief writes LEB128 encoding of \p value, signed values are zigzag encoded
+  ///\returns iterator past written bytes
+  template<std::integral value_type, memutil::detail::output_iterator_to_byte iterator>
+  inline constexpr auto encode(value_type value, iterator out) noexcept -> iterator
+    {
+    using byte_type = std::conditional_t<std::output_iterator<iterator, uint8_t>, uint8_t, std::byte>;
+    auto u{detail::to_unsigned(value)};
+    for(; u >= 0x80u; u = static_cast<decltype(u)>(u >> 7u), ++out)
+      *out = static_cast<byte_type>((u & 0x7fu) | 0x80u);
+    *out = static_cast<byte_type>(u);
+    ++out;
+    return out;
+    }
+
+  ///\brief decodes LEB128 value at \p it and forwards \p it past it, signed values are zigzag decoded
+  ///\details on error \p it is left unchanged
+  template<
+    std::integral value_type,
+    memutil::detail::forward_iterator_to_byte iterator,
+    std::sentinel_for<iterator> sentinel>
+  [[nodiscard]]
+  inline constexpr auto decode_fwd(iterator & it, sentinel end) noexcept -> cxx23::expected<value_type, error_e>
+    {
+    using unsigned_type = std::make_unsigned_t<value_type>;
+    constexpr unsigned bits{sizeof(unsigned_type) * 8u};
+    unsigned_type result{};
+    iterator pos{it};
+    for(unsigned shift{};; shift += 7u)
+      {
+      if(pos == end) [[unlikely]]
+        return cxx23::unexpected{error_e::truncated_input};
+      auto const byte{static_cast<uint8_t>(*pos)};
+      ++pos;
+      auto const payload{static_cast<unsigned_type>(byte & 0x7fu)};
+      if(shift >= bits || (shift + 7u > bits && (payload >> (bits - shift)) != 0u)) [[unlikely]]
+        return cxx23::unexpected{error_e::overflow};
+      result = static_cast<unsigned_type>(result | static_cast<unsigned_type>(payload << shift));
+      if((byte & 0x80u) == 0u)
+        break;
+      }
+    it = pos;
+    if constexpr(std::is_signed_v<value_type>)
+      return zigzag_decode(result);
+    else
+      return result;
+    }
+  }  // namespace varint
+
+///\brief Stream VByte codec of uint32_t sequences
+///\details every value is stored in 1 to 4 little endian bytes, 2 bit lengths of four consecutive values form one
+/// control byte. All control bytes precede data so decoder reads lengths of four values at once and expands them with
+/// single pshufb driven by 256 entry table, AVX2 decodes two groups per step
+namespace stream_vbyte
+  {
+  using error_e = varint::error_e;
+
+  ///\returns upper bound of encoded size of \p count values
+  [[nodiscard]]
+  inline constexpr auto max_encoded_size(std::size_t count) noexcept -> std::size_t
+    {
+    return (count + 3u) / 4u + count * sizeof(uint32_t);
+    }
+
+  namespace detail
+    {
+    [[nodiscard]]
+    inline constexpr auto value_length(uint32_t value) noexcept -> uint32_t
+      {
+      return value < (1u << 8u) ? 1u : value < (1u << 16u) ? 2u : value < (1u << 24u) ? 3u : 4u;
+      }
+
+    [[nodiscard]]
+    inline consteval auto make_group_length() noexcept -> std::array<uint8_t, 256>
+      {
+      std::array<uint8_t, 256> result{};
+      for(uint32_t c{}; c != 256u; ++c)
+        result[c] = static_cast<uint8_t>(4u + (c & 3u) + ((c >> 2u) & 3u) + ((c >> 4u) & 3u) + (c >> 6u));
+      return result;
+      }
+
+    [[nodiscard]]
+    inline consteval auto make_shuffle_table() noexcept -> std::array<std::array<int8_t, 16>, 256>
+      {
+      std::array<std::array<int8_t, 16>, 256> result{};
+      for(uint32_t c{}; c != 256u; ++c)
+        {
+        uint32_t offset{};
+        for(uint32_t i{}; i != 4u; ++i)
+          {
+          uint32_t const length{((c >> (2u * i)) & 3u) + 1u};
+          for(uint32_t b{}; b != 4u; ++b)
+            result[c][4u * i + b] = b < length ? static_cast<int8_t>(offset + b) : int8_t{-1};
+          offset += length;
+          }
+        }
+      return result;
+      }
+
+    /// total data bytes of four values described by control byte
+    inline constexpr std::array<uint8_t, 256> group_length{make_group_length()};
+
+    /// pshufb masks moving packed bytes of four values into four uint32_t lanes
+    alignas(16) inline constexpr std::array<std::array<int8_t, 16>, 256> shuffle_table{make_shuffle_table()};
+
+    ///\brief reads little endian value of \p length bytes at \p pos
+    [[nodiscard]]
+    inline constexpr auto read_value(std::span<std::byte const> data, std::size_t pos, uint32_t length) noexcept
+      -> uint32_t
+      {
+      uint32_t value{};
+      if constexpr(std::endian::native == std::endian::little)
+        if(!std::is_constant_evaluated() && data.size() - pos >= sizeof(uint32_t))
+          {
+          // branchless masked load when whole word is readable
+          std::memcpy(&value, data.subspan(pos).data(), sizeof(uint32_t));
+          return value & (0xffff'ffffu >> (32u - 8u * length));
+          }
+      for(uint32_t b{}; b != length; ++b)
+        value |= static_cast<uint32_t>(data[pos + b]) << (8u * b);
+      return value;
+      }
+
+    ///\brief decodes values [first, out.size()) without SIMD, control and data were validated by caller
+    inline constexpr void decode_scalar(
+      std::span<std::byte const> control,
+      std::span<std::byte const> data,
+      std::size_t data_pos,
+      std::span<uint32_t> out,
+      std::size_t first
+    ) noexcept
+      {
+      for(std::size_t ix{first}; ix != out.size(); ++ix)
+        {
+        uint32_t const length{((static_cast<uint32_t>(control[ix / 4u]) >> (2u * (ix % 4u))) & 3u) + 1u};
+        out[ix] = read_value(data, data_pos, length);
+        data_pos += length;
+        }
+      }
+
+    ///\brief decodes whole groups while 16 (32 with AVX2) bytes can be loaded from data
+    ///\returns number of decoded values and advances \p data_pos
+    inline auto decode_simd(
+      std::span<std::byte const> control,
+      std::span<std::byte const> data,
+      std::size_t & data_pos,
+      std::span<uint32_t> out
+    ) noexcept -> std::size_t
+      {
+      std::size_t group{};
+#if defined(__SSSE3__)
+      std::size_t const groups{out.size() / 4u};
+      small_vectors_clang_unsafe_buffer_usage_begin  //
+        auto const * const data_ptr{reinterpret_cast<uint8_t const *>(data.data())};
+      auto * const out_ptr{out.data()};
+#if defined(__AVX2__)
+      for(; group + 2u <= groups && data.size() - data_pos >= 32u; group += 2u)
+        {
+        auto const c0{static_cast<uint8_t>(control[group])};
+        auto const c1{static_cast<uint8_t>(control[group + 1u])};
+        __m128i const lo{_mm_loadu_si128(reinterpret_cast<__m128i const *>(data_ptr + data_pos))};
+        __m128i const hi{_mm_loadu_si128(reinterpret_cast<__m128i const *>(data_ptr + data_pos + group_length[c0]))};
+        __m256i const mask{_mm256_inserti128_si256(
+          _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<__m128i const *>(shuffle_table[c0].data()))),
+          _mm_loadu_si128(reinterpret_cast<__m128i const *>(shuffle_table[c1].data())),
+          1
+        )};
+        __m256i const bytes{_mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1)};
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out_ptr + group * 4u), _mm256_shuffle_epi8(bytes, mask));
+        data_pos += std::size_t{group_length[c0]} + group_length[c1];
+        }
+#endif
+      for(; group != groups && data.size() - data_pos >= 16u; ++group)
+        {
+        auto const c{static_cast<uint8_t>(control[group])};
+        __m128i const bytes{_mm_loadu_si128(reinterpret_cast<__m128i const *>(data_ptr + data_pos))};
+        __m128i const mask{_mm_loadu_si128(reinterpret_cast<__m128i const *>(shuffle_table[c].data()))};
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out_ptr + group * 4u), _mm_shuffle_epi8(bytes, mask));
+        data_pos += group_length[c];
+        }
+      small_vectors_clang_unsafe_buffer_usage_end  //
+#else
+      static_cast<void>(control);
+      static_cast<void>(data);
+      static_cast<void>(data_pos);
+      static_cast<void>(out);
+#endif
+      return group * 4u;
+      }
+    }  // namespace detail
+
+  ///\brief encodes \p values into \p out which must hold at least max_encoded_size(values.size()) bytes
+  ///\returns number of bytes written
+  inline constexpr auto encode(std::span<uint32_t const> values, std::span<std::byte> out) noexcept -> std::size_t
+    {
+    std::size_t const control_size{(values.size() + 3u) / 4u};
+    std::size_t data_pos{control_size};
+    for(std::size_t ix{}; ix != values.size(); ++ix)
+      {
+      uint32_t const value{values[ix]};
+      uint32_t const length{detail::value_length(value)};
+      if(ix % 4u == 0u)
+        out[ix / 4u] = std::byte{};
+      out[ix / 4u] |= static_cast<std::byte>((length - 1u) << (2u * (ix % 4u)));
+      for(uint32_t b{}; b != length; ++b)
+        out[data_pos++] = static_cast<std::byte>(value >> (8u * b));
+      }
+    return data_pos;
+    }
+
+  ///\brief appends encoding of \p values to byte vector \p out growing it once
+  template<typename byte_vector>
+    requires std::same_as<typename byte_vector::value_type, std::byte>
+  inline constexpr void encode_append(std::span<uint32_t const> values, byte_vector & out)
+    {
+    auto const pos{static_cast<std::size_t>(out.size())};
+    out.resize(static_cast<typename byte_vector::size_type>(pos + max_encoded_size(values.size())));
+    std::span<std::byte> const target{out.data(), static_cast<std::size_t>(out.size())};
+    std::size_t const written{encode(values, target.subspan(pos))};
+    out.resize(static_cast<typename byte_vector::size_type>(pos + written));
+    }
+
+  ///\brief decodes out.size() values from \p in
+  ///\returns number of consumed bytes or error_e::truncated_input when \p in is shorter than encoding
+  inline constexpr auto decode(std::span<std::byte const> in, std::span<uint32_t> out) noexcept
+    -> cxx23::expected<std::size_t, error_e>
+    {
+    std::size_t const count{out.size()};
+    std::size_t const control_size{(count + 3u) / 4u};
+    if(in.size() < control_size) [[unlikely]]
+      return cxx23::unexpected{error_e::truncated_input};
+    std::span<std::byte const> const control{in.first(control_size)};
+    std::span<std::byte const> const data{in.subspan(control_size)};
+    // validate once so groups are decoded without bounds checks
+    std::size_t data_size{};
+    for(std::size_t group{}; group != count / 4u; ++group)
+      data_size += detail::group_length[static_cast<uint8_t>(control[group])];
+    for(std::size_t ix{count & ~std::size_t{3u}}; ix != count; ++ix)
+      data_size += ((static_cast<uint32_t>(control[ix / 4u]) >> (2u * (ix % 4u))) & 3u) + 1u;
+    if(data.size() < data_size) [[unlikely]]
+      return cxx23::unexpected{error_e::truncated_input};
+    std::span<std::byte const> const payload{data.first(data_size)};
+    std::size_t data_pos{};
+    std::size_t first{};
+    if(!std::is_constant_evaluated())
+      first = detail::decode_simd(control, payload, data_pos, out);
+    detail::decode_scalar(control, payload, data_pos, out, first);
+    return control_size + data_size;
+    }
+
+  ///\brief decodes \p count values from \p in appending them to \p out
+  template<typename value_vector>
+    requires std::same_as<typename value_vector::value_type, uint32_t>
+  inline constexpr auto decode_append(std::span<std::byte const> in, std::size_t count, value_vector & out)
+    -> cxx23::expected<std::size_t, error_e>
+    {
+    auto const pos{static_cast<std::size_t>(out.size())};
+    out.resize(static_cast<typename value_vector::size_type>(pos + count));
+    auto result{decode(in, std::span<uint32_t>{out.data(), static_cast<std::size_t>(out.size())}.subspan(pos))};
+    if(!result) [[unlikely]]
+      out.resize(static_cast<typename value_vector::size_type>(pos));
+    return result;
+    }
+  }  // namespace stream_vbyte
+  }  // namespace small_vectors::inline v3_3::utils
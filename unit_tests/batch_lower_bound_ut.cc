@@ -0,0 +1,89 @@
+#include <small_vectors/algo/batch_lower_bound.h>
+#include <small_vectors/small_vector.h>
+#include <unit_test_core.h>
+#include <algorithm>
+
+namespace ut = boost::ut;
+using ut::expect;
+using ut::operator""_test;
+using namespace ut::operators::terse;
+namespace lb = small_vectors::algo::lower_bound;
+
+namespace
+  {
+auto random_values(uint32_t count, uint64_t seed, uint32_t modulo) -> small_vectors::vector<int32_t>
+  {
+  small_vectors::vector<int32_t> result(count);
+  for(int32_t & v: result)
+    {
+    seed ^= seed << 13u;
+    seed ^= seed >> 7u;
+    seed ^= seed << 17u;
+    v = static_cast<int32_t>(seed % modulo);
+    }
+  return result;
+  }
+
+template<typename compare_type = std::ranges::less>
+auto batch_matches(
+  small_vectors::vector<int32_t> const & data, small_vectors::vector<int32_t> const & keys, compare_type less = {}
+) -> bool
+  {
+  small_vectors::small_vector<std::size_t, uint32_t> positions(keys.size());
+  auto const end{lb::batch_lower_bound(data.begin(), data.end(), keys, positions.begin(), less)};
+  if(end != positions.end())
+    return false;
+  for(uint32_t ix{}; ix != keys.size(); ++ix)
+    {
+    auto const expected{std::lower_bound(data.begin(), data.end(), keys[ix], less)};
+    if(positions[ix] != static_cast<std::size_t>(expected - data.begin()))
+      return false;
+    }
+  return true;
+  }
+
+consteval auto constexpr_batch() -> bool
+  {
+  std::array<int, 7> const data{2, 4, 4, 8, 16, 32, 64};
+  std::array<int, 20> keys{};
+  for(int ix{}; ix != 20; ++ix)
+    keys[static_cast<std::size_t>(ix)] = ix * 4 - 6;
+  std::array<std::size_t, 20> positions{};
+  lb::batch_lower_bound(data.begin(), data.end(), keys, positions.begin());
+  for(std::size_t ix{}; ix != keys.size(); ++ix)
+    if(positions[ix] != static_cast<std::size_t>(std::ranges::lower_bound(data, keys[ix]) - data.begin()))
+      return false;
+  return true;
+  }
+
+static_assert(constexpr_batch());
+  }  // namespace
+
+int main()
+  {
+  "batch_lower_bound_sizes"_test = []
+  {
+    for(uint32_t size{}; size != 70u; ++size)
+      {
+      auto data{random_values(size, 0x1234u + size, 100u)};
+      std::ranges::sort(data);
+      // key counts around group size boundaries
+      for(uint32_t key_count: {0u, 1u, 15u, 16u, 17u, 33u})
+        expect(batch_matches(data, random_values(key_count, 0x77u + key_count, 104u))) << size << key_count;
+      }
+  };
+
+  "batch_lower_bound_large"_test = []
+  {
+    auto data{random_values(200000u, 0x51u, 1u << 28)};
+    std::ranges::sort(data);
+    expect(batch_matches(data, random_values(50000u, 0x52u, 1u << 28)));
+  };
+
+  "batch_lower_bound_compare"_test = []
+  {
+    auto data{random_values(1000u, 0x61u, 300u)};
+    std::ranges::sort(data, std::ranges::greater{});
+    expect(batch_matches(data, random_values(500u, 0x62u, 310u), std::ranges::greater{}));
+  };
+  }
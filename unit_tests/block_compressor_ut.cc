@@ -0,0 +1,182 @@
+#include <small_vectors/algo/block_compressor.h>
+#include <unit_test_core.h>
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace ut = boost::ut;
+using ut::expect;
+using ut::operator""_test;
+using namespace ut::operators::terse;
+using namespace std::string_view_literals;
+namespace bc = small_vectors::algo::block_compressor;
+
+namespace
+  {
+auto random_bytes(std::size_t count, uint64_t seed, uint8_t alphabet) -> small_vectors::vector<uint8_t>
+  {
+  small_vectors::vector<uint8_t> result(static_cast<uint32_t>(count));
+  for(uint8_t & b: result)
+    {
+    seed ^= seed << 13u;
+    seed ^= seed >> 7u;
+    seed ^= seed << 17u;
+    b = static_cast<uint8_t>(seed % alphabet);
+    }
+  return result;
+  }
+
+template<typename byte_range>
+auto round_trip(byte_range const & input, bc::options_t options) -> bool
+  {
+  auto const compressed{bc::compress(input, options)};
+  auto const decompressed{bc::decompress(compressed, options)};
+  return decompressed.has_value()
+         && std::ranges::equal(std::as_bytes(std::span{input}), *decompressed);
+  }
+
+void put_le(small_vectors::vector<uint8_t> & out, uint64_t value, unsigned bytes)
+  {
+  for(unsigned ix{}; ix != bytes; ++ix, value >>= 8u)
+    out.push_back(static_cast<uint8_t>(value & 0xffu));
+  }
+
+///\returns container header followed by \p padding zero bytes
+auto make_header(uint32_t block_size, uint64_t total_size, uint32_t block_count, std::size_t padding)
+  -> small_vectors::vector<uint8_t>
+  {
+  small_vectors::vector<uint8_t> result{'S', 'V', 'B', 'C', 1u};
+  put_le(result, block_size, 4u);
+  put_le(result, total_size, 8u);
+  put_le(result, block_count, 4u);
+  result.resize(static_cast<uint32_t>(result.size() + padding));
+  return result;
+  }
+  }  // namespace
+
+int main()
+  {
+  "block_compressor_bwt_rotations"_test = []
+  {
+    constexpr auto text{"banana"sv};
+    small_vectors::vector<uint8_t> const block(text.begin(), text.end());
+    small_vectors::vector<uint8_t> last_column(block.size());
+    auto const primary{bc::detail::bwt_encode(block, last_column)};
+    expect(std::ranges::equal(last_column, "nnbaaa"sv));
+    expect(primary == 3u);
+
+    std::array<std::byte, 6> decoded;
+    bc::detail::bwt_decode(last_column, primary, decoded);
+    expect(std::ranges::equal(std::as_bytes(std::span{text}), decoded));
+  };
+
+  "block_compressor_round_trip"_test = []
+  {
+    expect(round_trip(""sv, {}));
+    expect(round_trip("a"sv, {}));
+    expect(round_trip("abracadabra abracadabra abracadabra"sv, {.block_size = 8u, .threads = 3u}));
+
+    auto const text{random_bytes(200000u, 0x9e37u, 4u)};
+    expect(round_trip(text, {.block_size = 1u << 14, .threads = 4u}));
+    expect(round_trip(text, {.block_size = 1u << 16, .threads = 1u}));
+
+    auto const noise{random_bytes(70000u, 0x51u, 255u)};
+    expect(round_trip(noise, {.block_size = 1u << 15}));
+
+    small_vectors::vector<uint8_t> zeros(300000u);
+    auto const compressed{bc::compress(zeros, {.block_size = 1u << 17})};
+    expect(compressed.size() < 300u);
+    expect(round_trip(zeros, {.block_size = 1u << 17}));
+  };
+
+  "block_compressor_ratio"_test = []
+  {
+    small_vectors::vector<uint8_t> text;
+    constexpr auto sentence{"the quick brown fox jumps over the lazy dog, "sv};
+    for(uint32_t ix{}; ix != 2000u; ++ix)
+      {
+      text.insert(text.end(), sentence.begin(), sentence.end());
+      text.push_back(static_cast<uint8_t>('0' + ix % 10u));
+      }
+    auto const compressed{bc::compress(text, {.block_size = 1u << 15})};
+    expect(compressed.size() * 10u < text.size());
+    expect(round_trip(text, {.block_size = 1u << 15}));
+  };
+
+  "block_compressor_corruption"_test = []
+  {
+    auto const text{random_bytes(50000u, 0x77u, 16u)};
+    auto compressed{bc::compress(text, {.block_size = 1u << 13})};
+
+    auto const truncated{bc::decompress(std::span{compressed.data(), compressed.size() - 10u})};
+    expect(!truncated.has_value() && truncated.error() == bc::error_e::truncated_input);
+
+    auto bad_magic{compressed};
+    bad_magic[0u] = std::byte{'X'};
+    auto const invalid{bc::decompress(bad_magic)};
+    expect(!invalid.has_value() && invalid.error() == bc::error_e::invalid_header);
+
+    auto flipped{compressed};
+    flipped[flipped.size() / 2u] ^= std::byte{0x5a};
+    auto const corrupted{bc::decompress(flipped)};
+    expect(!corrupted.has_value());
+
+    expect(bc::decompress(compressed).has_value());
+  };
+
+  "block_compressor_malformed_header"_test = []
+  {
+    // size rounding up to block count wraps around
+    auto const wrapped{bc::decompress(make_header(16u, ~uint64_t{} - 1u, 0u, 0u))};
+    expect(!wrapped.has_value() && wrapped.error() == bc::error_e::invalid_header);
+
+    // block count not backed by block headers present in input
+    auto const huge_count{bc::decompress(make_header(1u << 20, uint64_t{0xffff'ffffu} << 20, 0xffff'ffffu, 64u))};
+    expect(!huge_count.has_value() && huge_count.error() == bc::error_e::truncated_input);
+
+    // declared size above limit is rejected before allocation
+    auto const huge_size{bc::decompress(make_header(1u << 20, uint64_t{1} << 40, 1u << 20, 16u << 20))};
+    expect(!huge_size.has_value() && huge_size.error() == bc::error_e::output_too_large);
+
+    auto const text{random_bytes(5000u, 0x99u, 32u)};
+    auto const compressed{bc::compress(text, {.block_size = 1u << 10})};
+    auto const limited{bc::decompress(compressed, {.max_output_size = 4999u})};
+    expect(!limited.has_value() && limited.error() == bc::error_e::output_too_large);
+    expect(bc::decompress(compressed, {.max_output_size = 5000u}).has_value());
+  };
+
+  "block_compressor_malformed_frequencies"_test = []
+  {
+    // valid rans stream for table where symbol 5 has half of scale, table lists it twice so sum matches scale
+    auto const make_block = [](std::array<uint16_t, 4u> const & table) -> small_vectors::vector<uint8_t>
+    {
+      bc::detail::frequency_table freq{};
+      freq[5u] = 1u << 13;
+      bc::detail::u16_vector symbols(16u);
+      std::ranges::fill(symbols, uint16_t{5u});
+      bc::byte_buffer payload;
+      bc::detail::writer_t out{payload};
+      out.put(uint16_t{2u});
+      for(uint16_t v: table)
+        out.put(v);
+      bc::detail::rans_encode(symbols, freq, out);
+
+      auto container{make_header(16u, 16u, 1u, 0u)};
+      put_le(container, 16u, 4u);  // raw size
+      put_le(container, 0u, 4u);   // primary
+      put_le(container, symbols.size(), 4u);
+      put_le(container, payload.size(), 4u);
+      for(std::byte b: payload)
+        container.push_back(static_cast<uint8_t>(b));
+      return container;
+    };
+    auto const duplicate{bc::decompress(make_block({5u, 1u << 13, 5u, 1u << 13}))};
+    expect(!duplicate.has_value() && duplicate.error() == bc::error_e::corrupted_block);
+    auto const descending{bc::decompress(make_block({6u, 1u << 13, 5u, 1u << 13}))};
+    expect(!descending.has_value() && descending.error() == bc::error_e::corrupted_block);
+    auto const zero{bc::decompress(make_block({5u, 0u, 6u, 1u << 14}))};
+    expect(!zero.has_value() && zero.error() == bc::error_e::corrupted_block);
+    // same stream with well formed table decodes
+    expect(bc::decompress(make_block({5u, 1u << 13, 6u, 1u << 13})).has_value());
+  };
+  }
@@ -0,0 +1,252 @@
+#include <unit_test_core.h>
+#include <small_vectors/interprocess/fork.h>
+#include <small_vectors/interprocess/shared_mem_utils.h>
+#include <small_vectors/interprocess/block_pool.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+namespace ut = boost::ut;
+using boost::ut::operator""_test;
+namespace ip = small_vectors::ip;
+namespace bip = boost::interprocess;
+
+namespace
+  {
+constexpr auto shmem_name{"block pool test for " SMALL_VECTORS_COMPILER_INFO};
+
+constexpr ip::block_index block_count{256u};
+constexpr unsigned worker_count{4u};
+constexpr uint32_t iterations{50000u};
+
+using pool_type = ip::block_pool<64u, block_count>;
+using cache_type = ip::block_pool_cache<pool_type, 16u>;
+
+///\brief single producer single consumer mailbox passing block indices
+struct mailbox
+  {
+  static constexpr std::size_t slot_count{64u};
+  std::array<std::atomic<ip::block_index>, slot_count> slots_;
+  std::atomic<uint32_t> done_;
+
+  mailbox() noexcept : done_{}
+    {
+    for(auto & slot: slots_)
+      slot.store(ip::invalid_block_index, std::memory_order_relaxed);
+    }
+  };
+
+using pool_decl = ip::shared_type_decl<pool_type>;
+using mailbox_decl = ip::shared_type_decl<mailbox, pool_decl>;
+
+struct message
+  {
+  uint32_t producer;
+  uint32_t sequence;
+  uint32_t checksum;
+  };
+
+void stamp(std::span<std::byte, 64u> block, uint32_t owner, uint32_t sequence) noexcept
+  {
+  std::array<uint32_t, 16u> pattern;
+  std::ranges::fill(pattern, owner * 0x9e37'79b9u ^ sequence);
+  std::memcpy(block.data(), pattern.data(), block.size());
+  }
+
+auto stamped(std::span<std::byte const, 64u> block, uint32_t owner, uint32_t sequence) noexcept -> bool
+  {
+  std::array<uint32_t, 16u> pattern;
+  std::memcpy(pattern.data(), block.data(), block.size());
+  return std::ranges::all_of(pattern, [value = owner * 0x9e37'79b9u ^ sequence](uint32_t v) { return v == value; });
+  }
+
+///\returns number of free blocks, pool is exhausted afterwards
+auto drain(pool_type & pool) -> std::vector<ip::block_index>
+  {
+  std::vector<ip::block_index> indices;
+  for(auto index{pool.allocate()}; index; index = pool.allocate())
+    indices.push_back(*index);
+  return indices;
+  }
+  }  // namespace
+
+static_assert(sizeof(pool_type::allocation_result) == sizeof(ip::block_index));
+
+int main()
+  {
+  "block_pool_local"_test = []
+  {
+    auto pool{std::make_unique<pool_type>()};
+    auto indices{drain(*pool)};
+    ut::expect(indices.size() == block_count);
+    std::ranges::sort(indices);
+    ut::expect(std::ranges::adjacent_find(indices) == indices.end());
+    ut::expect(!pool->allocate());
+    ut::expect(pool->allocate().error() == ip::pool_error_e::exhausted);
+
+    pool->deallocate(7u);
+    ut::expect(pool->allocate() == 7u);
+    pool->deallocate_chain(std::span{indices}.subspan(10u, 5u));
+    ut::expect(drain(*pool).size() == 5u);
+
+    // batch pop follows free list order and stops at its end
+    pool->deallocate_chain(std::span{indices}.subspan(20u, 6u));
+    std::array<ip::block_index, 4u> batch;
+    ut::expect(pool->allocate_chain(batch) == 4u);
+    ut::expect(std::ranges::equal(batch, std::span{indices}.subspan(20u, 4u)));
+    ut::expect(pool->allocate_chain(batch) == 2u);
+    ut::expect(std::ranges::equal(std::span{batch}.first(2u), std::span{indices}.subspan(24u, 2u)));
+    ut::expect(pool->allocate_chain(batch) == 0u);
+
+    auto block{pool->block(3u)};
+    ut::expect(pool->index_of(block.data()) == 3u);
+    ut::expect(pool->index_of(&block[63]) == 3u);
+    ut::expect(reinterpret_cast<std::uintptr_t>(pool->block(0u).data()) % 64u == 0u);
+  };
+
+  "block_pool_cache"_test = []
+  {
+    auto pool{std::make_unique<pool_type>()};
+      {
+      cache_type cache{*pool};
+      std::vector<ip::block_index> held;
+      for(ip::block_index ix{}; ix != block_count; ++ix)
+        {
+        auto const index{cache.allocate()};
+        ut::expect(static_cast<bool>(index)) >> ut::fatal;
+        held.push_back(*index);
+        }
+      ut::expect(!cache.allocate());
+      for(ip::block_index index: held)
+        cache.deallocate(index);
+      ut::expect(cache.cached() <= 16u);
+      }
+    // destroyed cache returned everything
+    ut::expect(drain(*pool).size() == block_count);
+  };
+
+  "block_pool_fork_stress"_test = []
+  {
+    bip::shared_memory_object::remove(shmem_name);
+    bip::shared_memory_object shm{bip::create_only, shmem_name, bip::read_write};
+    shm.truncate(mailbox_decl::end_offset);
+    bip::mapped_region region{shm, bip::read_write};
+    pool_type & pool{*ip::construct_at<pool_decl>(region)};
+    ip::construct_at<mailbox_decl>(region);
+
+    // workers hammer shared free list through local caches, block owned twice would lose its stamp
+    std::vector<ip::fork_child_t> children;
+    for(uint32_t worker{}; worker != worker_count; ++worker)
+      {
+      auto child = ip::fork(
+        [](std::string_view shared_mem_name, uint32_t owner)
+        {
+          bip::shared_memory_object shm_obj{bip::open_only, shared_mem_name.data(), bip::read_write};
+          bip::mapped_region cregion{shm_obj, bip::read_write};
+          pool_type & cpool{ip::ref<pool_decl>(cregion)};
+          cache_type cache{cpool};
+          std::array<ip::block_index, 8u> held;
+          for(uint32_t sequence{}; sequence != iterations; ++sequence)
+            {
+            std::size_t const count{1u + sequence % held.size()};
+            for(std::size_t ix{}; ix != count; ++ix)
+              {
+              auto const index{cache.allocate()};
+              if(!index)
+                return false;
+              held[ix] = *index;
+              stamp(cpool.block(*index), owner, sequence);
+              }
+            std::this_thread::yield();
+            for(std::size_t ix{}; ix != count; ++ix)
+              {
+              if(!stamped(cpool.block(held[ix]), owner, sequence))
+                return false;
+              cache.deallocate(held[ix]);
+              }
+            }
+          return true;
+        },
+        shmem_name,
+        worker + 1u
+      );
+      ut::expect(static_cast<bool>(child)) >> ut::fatal;
+      children.push_back(*child);
+      }
+
+    // producer passes only block index to parent
+    auto producer = ip::fork(
+      [](std::string_view shared_mem_name)
+      {
+        bip::shared_memory_object shm_obj{bip::open_only, shared_mem_name.data(), bip::read_write};
+        bip::mapped_region cregion{shm_obj, bip::read_write};
+        pool_type & cpool{ip::ref<pool_decl>(cregion)};
+        mailbox & cmailbox{ip::ref<mailbox_decl>(cregion)};
+        cache_type cache{cpool};
+        for(uint32_t sequence{}; sequence != iterations; ++sequence)
+          {
+          auto index{cache.allocate()};
+          while(!index)
+            {
+            std::this_thread::yield();
+            index = cache.allocate();
+            }
+          message const msg{.producer = 0xfeedu, .sequence = sequence, .checksum = sequence * 7u + 1u};
+          std::memcpy(cpool.block(*index).data(), &msg, sizeof(msg));
+          auto & slot{cmailbox.slots_[sequence % mailbox::slot_count]};
+          while(slot.load(std::memory_order_acquire) != ip::invalid_block_index)
+            std::this_thread::yield();
+          slot.store(*index, std::memory_order_release);
+          }
+        cmailbox.done_.store(1u, std::memory_order_release);
+        return true;
+      },
+      shmem_name
+    );
+    ut::expect(static_cast<bool>(producer)) >> ut::fatal;
+
+    mailbox & box{ip::ref<mailbox_decl>(region)};
+    bool messages_valid{true};
+      {
+      cache_type cache{pool};
+      for(uint32_t sequence{}; sequence != iterations; ++sequence)
+        {
+        auto & slot{box.slots_[sequence % mailbox::slot_count]};
+        ip::block_index index{slot.load(std::memory_order_acquire)};
+        while(index == ip::invalid_block_index)
+          {
+          std::this_thread::yield();
+          index = slot.load(std::memory_order_acquire);
+          }
+        message msg;
+        std::memcpy(&msg, pool.block(index).data(), sizeof(msg));
+        messages_valid = messages_valid && msg.producer == 0xfeedu && msg.sequence == sequence
+                         && msg.checksum == sequence * 7u + 1u;
+        slot.store(ip::invalid_block_index, std::memory_order_relaxed);
+        cache.deallocate(index);
+        }
+      }
+    ut::expect(messages_valid);
+    ut::expect(producer->join());
+    ut::expect(box.done_.load() == 1u);
+    for(auto const & child: children)
+      ut::expect(child.join());
+
+    // every block returned exactly once
+    auto indices{drain(pool)};
+    ut::expect(indices.size() == block_count);
+    std::ranges::sort(indices);
+    ut::expect(std::ranges::adjacent_find(indices) == indices.end());
+    bip::shared_memory_object::remove(shmem_name);
+  };
+  }
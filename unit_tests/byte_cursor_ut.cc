@@ -0,0 +1,139 @@
+#include <small_vectors/utils/byte_cursor.h>
+#include <unit_test_core.h>
+#include <array>
+#include <vector>
+
+namespace ut = boost::ut;
+using ut::expect;
+using ut::operator""_test;
+using namespace ut::operators::terse;
+using namespace small_vectors::memutil;
+
+namespace
+  {
+struct header_t
+  {
+  uint32_t magic;
+  uint16_t version;
+  int64_t timestamp;
+  double ratio;
+
+  constexpr auto operator==(header_t const &) const noexcept -> bool = default;
+  };
+
+inline constexpr std::size_t header_size{4u + 2u + 8u + 8u};
+
+template<typename byte_vector>
+constexpr void write_header(byte_writer<byte_vector> & writer, header_t const & header)
+  {
+  writer.require(header_size)
+    .template write<std::endian::big>(header.magic)
+    .template write<std::endian::big>(header.version)
+    .write(header.timestamp)
+    .write(header.ratio);
+  }
+
+constexpr auto read_header(byte_reader & reader) -> cxx23::expected<header_t, cursor_error_e>
+  {
+  return reader.require(header_size)
+    .transform(
+      [](byte_record_reader record)
+      {
+        header_t header{};
+        header.magic = record.read<std::endian::big, uint32_t>();
+        header.version = record.read<std::endian::big, uint16_t>();
+        header.timestamp = record.read<int64_t>();
+        header.ratio = record.read<double>();
+        return header;
+      }
+    );
+  }
+  }  // namespace
+
+static_assert(
+  []
+  {
+    small_vectors::small_vector<std::byte, uint64_t, 64> buffer;
+    byte_writer writer{buffer};
+    header_t const header{0xcafebabeu, 3u, -42, 0.25};
+    write_header(writer, header);
+    byte_reader reader{std::span<std::byte const>{buffer.data(), buffer.size()}};
+    auto const result{read_header(reader)};
+    return result.has_value() && *result == header && reader.at_end() && buffer[0u] == std::byte{0xca};
+  }()
+);
+
+int main()
+  {
+  "byte_cursor_records"_test = []
+  {
+    small_vectors::small_vector<std::byte, uint64_t, 0> buffer;
+    byte_writer writer{buffer};
+    std::vector<header_t> headers;
+    for(int ix{}; ix != 100; ++ix)
+      headers.push_back(header_t{0x11223344u, static_cast<uint16_t>(ix), ix * -1000, ix * 0.5});
+    for(header_t const & header: headers)
+      write_header(writer, header);
+    expect(writer.size() == headers.size() * header_size);
+    expect(buffer[0u] == std::byte{0x11} && buffer[3u] == std::byte{0x44});
+
+    byte_reader reader{std::span<std::byte const>{buffer.data(), buffer.size()}};
+    std::vector<header_t> loaded;
+    while(!reader.at_end())
+      {
+      auto header{read_header(reader)};
+      expect(header.has_value());
+      loaded.push_back(*header);
+      }
+    expect(loaded == headers);
+  };
+
+  "byte_cursor_short_input"_test = []
+  {
+    std::array<std::byte, 10> const data{};
+    byte_reader reader{data};
+    expect(reader.read<uint64_t>().has_value());
+    auto const failed{reader.read<uint32_t>()};
+    expect(!failed.has_value() && failed.error() == cursor_error_e::short_input);
+    // failed read does not consume input
+    expect(reader.position() == 8u && reader.remaining() == 2u);
+    expect(!read_header(reader).has_value() && reader.position() == 8u);
+    expect(reader.read<std::endian::big, uint16_t>() == 0u && reader.at_end());
+    expect(!reader.skip(1u).has_value() && reader.skip(0u).has_value());
+  };
+
+  "byte_cursor_arrays"_test = []
+  {
+    small_vectors::small_vector<std::byte, uint64_t, 0> buffer;
+    byte_writer writer{buffer};
+    std::vector<uint32_t> values(1000u);
+    for(uint32_t ix{}; ix != 1000u; ++ix)
+      values[ix] = ix * 2654435761u;
+    std::array<std::byte, 3> const raw{std::byte{1}, std::byte{2}, std::byte{3}};
+    writer.write<std::endian::big>(static_cast<uint32_t>(values.size())).write_n<std::endian::big>(values).bytes(raw);
+    expect(writer.size() == 4u + 4000u + 3u);
+    // geometric growth, field by field appends reallocate logarithmically often and leave spare capacity
+      {
+      small_vectors::small_vector<std::byte, uint64_t, 0> grown;
+      byte_writer grown_writer{grown};
+      uint32_t reallocations{};
+      for(uint32_t ix{}; ix != 4007u; ++ix)
+        {
+        auto const capacity{grown.capacity()};
+        grown_writer.write(static_cast<uint8_t>(ix));
+        reallocations += grown.capacity() != capacity ? 1u : 0u;
+        }
+      expect(grown.size() == 4007u && reallocations < 32u && grown.capacity() > grown.size());
+      }
+
+    byte_reader reader{std::span<std::byte const>{buffer.data(), buffer.size()}};
+    auto const count{reader.read<std::endian::big, uint32_t>()};
+    expect(count.has_value() && *count == 1000u);
+    std::vector<uint32_t> loaded(*count);
+    expect(reader.read_n<std::endian::big>(loaded).has_value() && loaded == values);
+    auto const tail{reader.bytes(3u)};
+    expect(tail.has_value() && tail->size() == 3u && (*tail)[2] == std::byte{3} && reader.at_end());
+    std::vector<uint32_t> too_many(1u);
+    expect(!reader.read_n(too_many).has_value());
+  };
+  }
@@ -0,0 +1,119 @@
+#include <small_vectors/compact_string.h>
+#include <small_vectors/basic_string.h>
+#include <unit_test_core.h>
+#include <string>
+#include <unordered_set>
+
+namespace ut = boost::ut;
+using ut::expect;
+using ut::operator""_test;
+using namespace ut::operators::terse;
+using small_vectors::compact_string;
+
+static_assert(sizeof(compact_string) == 3u * sizeof(void *));
+static_assert(sizeof(small_vectors::u16compact_string) == 3u * sizeof(void *));
+static_assert(compact_string::inline_capacity() == 3u * sizeof(void *) - 1u);
+static_assert(small_vectors::u32compact_string::inline_capacity() == 3u * sizeof(void *) / 4u - 1u);
+
+int main()
+  {
+  using namespace std::string_view_literals;
+
+  "compact_string_inline"_test = []
+  {
+    compact_string s;
+    expect(s.empty() && s.is_inline() && s.size() == 0u && *s.c_str() == '\0');
+    std::string reference;
+    // every inline size keeps terminator, full buffer terminator is the remaining capacity byte
+    for(std::size_t ix{}; ix != compact_string::inline_capacity(); ++ix)
+      {
+      s.push_back(static_cast<char>('a' + ix));
+      reference.push_back(static_cast<char>('a' + ix));
+      expect(s.is_inline());
+      expect(s == std::string_view{reference});
+      expect(std::string_view{s.c_str()} == reference);
+      }
+    expect(s.capacity() == compact_string::inline_capacity());
+    s.pop_back();
+    expect(s.size() == compact_string::inline_capacity() - 1u && s.back() == reference[reference.size() - 2u]);
+  };
+
+  "compact_string_heap"_test = []
+  {
+    compact_string s{"0123456789"};
+    std::string reference{"0123456789"};
+    for(int round{}; round != 40; ++round)
+      {
+      s.append("abcdefghij"sv);
+      reference.append("abcdefghij");
+      expect(s == std::string_view{reference});
+      expect(std::string_view{s.c_str()} == reference);
+      expect(s.capacity() >= s.size());
+      }
+    expect(!s.is_inline());
+    s.resize(5u);
+    expect(s == "01234"sv && !s.is_inline());
+    s.shrink_to_fit();
+    expect(s == "01234"sv && s.is_inline());
+    s.resize(100u, 'x');
+    expect(s.size() == 100u && s[99u] == 'x' && s[4u] == '4');
+    s.shrink_to_fit();
+    expect(s.capacity() == 100u && s.size() == 100u);
+    s.clear();
+    expect(s.empty() && !s.is_inline());
+  };
+
+  "compact_string_aliasing"_test = []
+  {
+    compact_string s{"abc"};
+    for(int round{}; round != 6; ++round)
+      s.append(s.view());
+    expect(s.size() == 3u * 64u);
+    expect(s.view().substr(0u, 6u) == "abcabc"sv && s.view().substr(s.size() - 3u) == "abc"sv);
+    s.assign(s.view().substr(3u, 30u));
+    expect(s.size() == 30u && s.view().substr(0u, 6u) == "abcabc"sv);
+  };
+
+  "compact_string_copy_move_swap"_test = []
+  {
+    compact_string small{"short"};
+    compact_string large{"a string that is too long to be stored inline"};
+    compact_string copy{large};
+    expect(copy == large && copy.data() != large.data());
+    compact_string moved{std::move(copy)};
+    expect(moved == large && copy.empty() && copy.is_inline());
+    swap(small, moved);
+    expect(small == large && moved == "short"sv);
+    moved = small;
+    expect(moved == large);
+    small = compact_string{"x"};
+    expect(small == "x"sv);
+    small = std::move(moved);
+    expect(small == large);
+    expect(small < compact_string{"b"} && compact_string{"b"} > "a"sv);
+  };
+
+  "compact_string_hash"_test = []
+  {
+    std::unordered_set<compact_string, small_vectors::string_hash, small_vectors::string_equal> set;
+    set.emplace("first");
+    set.emplace("a second key which needs heap storage");
+    expect(set.contains("first"sv));
+    expect(set.contains("a second key which needs heap storage"));
+    expect(!set.contains("third"sv));
+    expect(std::hash<compact_string>{}(compact_string{"first"}) == small_vectors::string_hash{}("first"sv));
+  };
+
+  "compact_string_u16"_test = []
+  {
+    small_vectors::u16compact_string s{u"wide"};
+    std::u16string reference{u"wide"};
+    for(int round{}; round != 10; ++round)
+      {
+      s += u'!';
+      reference += u'!';
+      expect(s == std::u16string_view{reference});
+      }
+    expect(s.find(u"e!!"sv) == 3u);
+  };
+  }
@@ -0,0 +1,74 @@
+#include <small_vectors/concat.h>
+#include <small_vectors/basic_fixed_string.h>
+#include <unit_test_core.h>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace ut = boost::ut;
+using ut::expect;
+using ut::operator""_test;
+using namespace ut::operators::terse;
+using small_vectors::concat;
+using small_vectors::concat_append;
+
+static_assert(
+  []
+  {
+    auto const s{concat("id:", 42, '/', -7, small_vectors::basic_fixed_string{"x"})};
+    return s.view() == "id:42/-7x";
+  }()
+);
+static_assert(concat<small_vectors::static_string<16>>("a", 0u, 'b').view() == "a0b");
+
+int main()
+  {
+  using namespace std::string_view_literals;
+
+  "concat_mixed_arguments"_test = []
+  {
+    small_vectors::string const dir{"/var/log/service"sv};
+    std::string const name{"worker"};
+    constexpr small_vectors::basic_fixed_string ext{".log"};
+    auto const path{concat(dir, '/', name, '-', 17u, ext)};
+    static_assert(std::same_as<decltype(path), small_vectors::string const>);
+    expect(path == "/var/log/service/worker-17.log"sv);
+    expect(concat().empty());
+    expect(concat(""sv, std::string{}) == ""sv);
+  };
+
+  "concat_integers"_test = []
+  {
+    expect(concat(0) == "0"sv);
+    expect(concat(int8_t{-128}, ' ', uint8_t{255}) == "-128 255"sv);
+    expect(concat(std::numeric_limits<int64_t>::min()) == "-9223372036854775808"sv);
+    expect(concat(std::numeric_limits<uint64_t>::max()) == "18446744073709551615"sv);
+    for(int value{-1000}; value <= 1000; value += 7)
+      expect(concat(value).view() == std::to_string(value));
+  };
+
+  "concat_single_allocation"_test = []
+  {
+    std::string const long_part(200u, 'x');
+    auto const s{concat(long_part, long_part, 123456789, long_part)};
+    expect(s.size() == 609u && s.capacity() >= s.size());
+    expect(s.view().substr(400u, 9u) == "123456789"sv);
+    // result is sized exactly from precomputed length, growth happens only once
+    expect(s.capacity() < 2u * s.size());
+  };
+
+  "concat_append"_test = []
+  {
+    small_vectors::string s{"key"sv};
+    concat_append(s, '=', 12, ';');
+    expect(s == "key=12;"sv);
+    // arguments referring to target are read before old buffer is released
+    concat_append(s, s.view(), s.view());
+    expect(s == "key=12;key=12;key=12;"sv);
+    std::string std_target{"std:"};
+    concat_append(std_target, 1, ',', 2);
+    expect(std_target == "std:1,2"sv);
+    small_vectors::u8string u8{concat<small_vectors::u8string>(u8"ż", 5, u8'!')};
+    expect(u8 == u8"ż5!"sv);
+  };
+  }
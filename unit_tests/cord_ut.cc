@@ -0,0 +1,98 @@
+#include <small_vectors/cord.h>
+#include <unit_test_core.h>
+#include <string>
+#include <vector>
+
+namespace ut = boost::ut;
+using ut::expect;
+using ut::operator""_test;
+using namespace ut::operators::terse;
+using small_vectors::cord;
+
+int main()
+  {
+  using namespace std::string_view_literals;
+
+  "cord_append"_test = []
+  {
+    cord c;
+    expect(c.empty() && c.chunk_count() == 0u && c == ""sv);
+    c.append("hello"sv).append(" "sv).append("world"sv);
+    expect(c.size() == 11u && c == "hello world"sv);
+    // short appends are gathered in single tail chunk
+    expect(c.chunk_count() == 1u);
+    small_vectors::string owned{std::string(2000u, 'x')};
+    char const * owned_data{owned.data()};
+    c += std::move(owned);
+    expect(c.chunk_count() == 2u && c.size() == 2011u);
+    // owned buffer is adopted without copy
+    expect((*std::next(c.chunks().begin())).data() == owned_data);
+    c += std::string_view{std::string(1000u, 'y')};
+    expect(c.chunk_count() == 3u && c.size() == 3011u && c[3010u] == 'y' && c[10u] == 'd');
+  };
+
+  "cord_large_build"_test = []
+  {
+    cord c;
+    std::string expected;
+    for(unsigned ix{}; ix != 20000u; ++ix)
+      {
+      std::string const part(ix % 61u + 1u, static_cast<char>('a' + ix % 26u));
+      c += std::string_view{part};
+      expected += part;
+      }
+    expect(c.size() == expected.size() && c == std::string_view{expected});
+    expect(c.chunk_count() < expected.size() / 1024u);
+    auto const flat{c.flatten()};
+    expect(flat.view() == expected);
+    std::size_t total{};
+    for(std::string_view chunk: c.chunks())
+      total += chunk.size();
+    expect(total == expected.size());
+  };
+
+  "cord_substr_shares"_test = []
+  {
+    cord c;
+    std::string expected;
+    for(unsigned ix{}; ix != 8u; ++ix)
+      {
+      small_vectors::string part{std::string(700u + ix, static_cast<char>('a' + ix))};
+      expected += part.view();
+      c += std::move(part);
+      }
+    for(std::size_t pos{}; pos < expected.size(); pos += 333u)
+      for(std::size_t count: {0uz, 1uz, 699uz, 2500uz, std::string::npos})
+        {
+        cord const sub{c.substr(pos, count)};
+        expect(sub == std::string_view{expected}.substr(pos, count));
+        }
+    cord const sub{c.substr(650u, 500u)};
+    expect(sub.chunk_count() == 2u && (*sub.chunks().begin()).data() == (*c.chunks().begin()).data() + 650);
+    expect(c.substr(expected.size()).empty());
+  };
+
+  "cord_sharing"_test = []
+  {
+    cord a{"shared tail"sv};
+    cord b{a};
+    // tail is shared so appends must not modify the other cord
+    a += " of a"sv;
+    b += " of b"sv;
+    expect(a == "shared tail of a"sv && b == "shared tail of b"sv);
+    cord joined;
+    joined += a;
+    joined += b;
+    joined += joined;
+    expect(joined.flatten().view() == "shared tail of ashared tail of bshared tail of ashared tail of b"sv);
+    cord other{"shared tail of ashared tail"sv};
+    other += " of bshared tail of ashared tail of b"sv;
+    expect(joined == other && !(joined == a));
+    // view into own tail buffer must be copied before tail grows
+    cord self{"abc"sv};
+    self += (*self.chunks().begin()).substr(1u);
+    expect(self == "abcbc"sv);
+    joined.clear();
+    expect(joined.empty() && joined.chunk_count() == 0u);
+  };
+  }
@@ -2,6 +2,8 @@
 
 #include <small_vectors/utils/expected.h>
 #include <unit_test_core.h>
+#include <array>
+#include <span>
 
 using metatests::constexpr_test;
 using metatests::run_consteval_test;
@@ -1088,6 +1090,16 @@ static void do_test(test_result & result)
         constexpr_test(std::same_as<decltype(res), expected_type>);
         constexpr_test(res == unexpected{error_type(2)});
         }
+        {
+        auto res{expected_type{in_place}.transform([]() noexcept { return 3; })};
+        constexpr_test(std::same_as<decltype(res), expected<int, error_type>>);
+        constexpr_test(res == 3);
+        }
+        {
+        auto res{expected_type{unexpect, error_type{2}}.transform([]() noexcept { return 3; })};
+        constexpr_test(std::same_as<decltype(res), expected<int, error_type>>);
+        constexpr_test(res == unexpected{error_type(2)});
+        }
       return {};
     };
 
@@ -1151,11 +1163,145 @@ static void do_test(test_result & result)
   }
   }  // namespace expected_test
 
+namespace expected_niche_test
+  {
+enum struct io_error : int16_t
+  {
+  not_found = 2,
+  access_denied = 13,
+  };
+
+enum struct lookup_error : uint8_t
+  {
+  missing
+  };
+
+struct node
+  {
+  int value;
+  };
+  }  // namespace expected_niche_test
+
+template<>
+struct cxx23::expected_niche<int32_t, expected_niche_test::io_error>
+    : cxx23::negative_error_niche<int32_t, expected_niche_test::io_error>
+  {
+  };
+
+template<>
+struct cxx23::expected_niche<expected_niche_test::node const *, expected_niche_test::lookup_error>
+    : cxx23::sentinel_niche<
+        expected_niche_test::node const *,
+        nullptr,
+        expected_niche_test::lookup_error,
+        expected_niche_test::lookup_error::missing>
+  {
+  };
+
+namespace expected_niche_test
+  {
+using fd_result = expected<int32_t, io_error>;
+using lookup_result = expected<node const *, lookup_error>;
+
+static_assert(concepts::niche_expected<int32_t, io_error>);
+static_assert(!concepts::niche_expected<int32_t, test_error>);
+static_assert(sizeof(fd_result) == sizeof(int32_t));
+static_assert(sizeof(lookup_result) == sizeof(node const *));
+static_assert(sizeof(expected<int32_t, test_error>) == 2 * sizeof(int32_t));
+static_assert(std::is_trivially_copyable_v<fd_result> && std::is_trivially_copyable_v<lookup_result>);
+static_assert(std::same_as<decltype(fd_result{}.error()), io_error>);
+static_assert(!concepts::niche_expected<node const *, test_error>);
+// value initialized pointer is sentinel of lookup_result so it has no default value state
+static_assert(std::default_initializable<fd_result> && !std::default_initializable<lookup_result>);
+static_assert(concepts::niche_default_value<int32_t, io_error>);
+static_assert(!concepts::niche_default_value<node const *, lookup_error>);
+
+constexpr auto find_node(std::span<node const> nodes, int value) noexcept -> lookup_result
+  {
+  for(node const & n: nodes)
+    if(n.value == value)
+      return &n;
+  return unexpected{lookup_error::missing};
+  }
+
+static void do_test(test_result & result)
+  {
+  "expected_niche"_test = [&]
+  {
+    auto fn_test = []() -> bool
+    {
+      test_result tr;
+        {
+        fd_result ex;
+        tr |= constexpr_test(ex.has_value() && *ex == 0);
+        ex = 7;
+        tr |= constexpr_test(ex.value() == 7 && ex == 7);
+        ex = unexpected{io_error::access_denied};
+        tr |= constexpr_test(!ex.has_value() && ex.error() == io_error::access_denied);
+        tr |= constexpr_test(ex == unexpected{io_error::access_denied});
+        tr |= constexpr_test(ex.value_or(-1) == -1);
+        ex.emplace(3);
+        tr |= constexpr_test(ex == fd_result{3});
+        }
+        {
+        fd_result l{unexpect, io_error::not_found};
+        fd_result r{5};
+        swap(l, r);
+        tr |= constexpr_test(l == 5 && r.error() == io_error::not_found);
+        auto const twice{l.transform([](int32_t v) noexcept { return v * 2; })};
+        tr |= constexpr_test(twice.has_value() && *twice == 10);
+        auto const fallback{r.or_else([](io_error) noexcept { return fd_result{0}; })};
+        tr |= constexpr_test(fallback == 0);
+        auto const mapped{r.transform_error([](io_error e) noexcept { return static_cast<int>(e); })};
+        tr |= constexpr_test(!mapped.has_value() && mapped.error() == 2);
+        auto const chained{r.and_then([](int32_t v) noexcept { return fd_result{v + 1}; })};
+        tr |= constexpr_test(chained.error() == io_error::not_found);
+        }
+        {
+        std::array<node, 2> const nodes{node{1}, node{2}};
+        auto const found{find_node(nodes, 2)};
+        tr |= constexpr_test(found.has_value() && (*found)->value == 2);
+        auto const missing{find_node(nodes, 3)};
+        tr |= constexpr_test(!missing.has_value() && missing.error() == lookup_error::missing);
+        // conversion to expected without niche keeps state
+        auto const to_test_error = [](lookup_error) noexcept { return test_error::error1; };
+        expected<node const *, test_error> const converted{missing.transform_error(to_test_error)};
+        expected<node const *, test_error> const converted_found{found.transform_error(to_test_error)};
+        tr |= constexpr_test(!converted.has_value() && converted.error() == test_error::error1);
+        tr |= constexpr_test(converted_found.has_value() && *converted_found == *found);
+        expected<int64_t, io_error> const widened{fd_result{unexpect, io_error::access_denied}};
+        expected<int64_t, io_error> const widened_value{fd_result{9}};
+        tr |= constexpr_test(widened.error() == io_error::access_denied && widened_value == 9);
+        }
+      return static_cast<bool>(tr);
+    };
+    result |= run_consteval_test(fn_test);
+    result |= run_constexpr_test(fn_test);
+  };
+
+  "expected_niche_value_throws"_test = []
+  {
+    fd_result const ex{unexpect, io_error::not_found};
+    bool caught{};
+    try
+      {
+      (void)ex.value();
+      }
+    catch(bad_expected_access<io_error> const & e)
+      {
+      caught = e.error() == io_error::not_found;
+      }
+    ut::expect(caught);
+  };
+  }
+  }  // namespace expected_niche_test
+
 int main()
   {
   test_result result;
   unexpected_test::do_test(result);
   expected_test::do_test(result);
+  expected_niche_test::do_test(result);
 
   return result ? EXIT_SUCCESS : EXIT_FAILURE;
   }
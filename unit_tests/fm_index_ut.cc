@@ -0,0 +1,97 @@
+#include <small_vectors/algo/fm_index.h>
+#include <unit_test_core.h>
+#include <string_view>
+
+namespace ut = boost::ut;
+using ut::expect;
+using ut::operator""_test;
+using namespace ut::operators::terse;
+using namespace std::string_view_literals;
+namespace algo = small_vectors::algo;
+
+namespace
+  {
+auto naive_locate(std::string_view text, std::string_view pattern) -> small_vectors::vector<uint32_t>
+  {
+  small_vectors::vector<uint32_t> result;
+  for(auto pos{text.find(pattern)}; pos != std::string_view::npos; pos = text.find(pattern, pos + 1u))
+    result.push_back(static_cast<uint32_t>(pos));
+  return result;
+  }
+
+auto locate_equal(algo::fm_index<char> const & index, std::string_view text, std::string_view pattern) -> bool
+  {
+  auto positions{index.locate(pattern)};
+  std::ranges::sort(positions);
+  return std::ranges::equal(positions, naive_locate(text, pattern));
+  }
+  }  // namespace
+
+int main()
+  {
+  "fm_index_count_locate"_test = []
+  {
+    constexpr auto text{"abracadabra"sv};
+    auto const index{algo::fm_index<char>::build<'$'>(text, 3u)};
+    expect(index.size() == text.size() + 1u);
+    expect(index.count("abra"sv) == 2u);
+    expect(index.count("a"sv) == 5u);
+    expect(index.count("cad"sv) == 1u);
+    expect(index.count("abrax"sv) == 0u);
+    expect(index.count("z"sv) == 0u);
+    expect(index.count(""sv) == index.size());
+    expect(locate_equal(index, text, "abra"sv));
+    expect(locate_equal(index, text, "a"sv));
+    expect(locate_equal(index, text, "ra"sv));
+  };
+
+  "fm_index_from_bwt"_test = []
+  {
+    constexpr auto text{"mississippi"sv};
+    std::array<char, 12> bwt;
+    algo::bwt::encode<'$'>(text, bwt.begin());
+    // suffix array of mississippi$
+    std::array<uint32_t, 12> const suffix_array{11, 10, 7, 4, 1, 0, 9, 8, 6, 3, 5, 2};
+    algo::fm_index<char> const index{bwt, suffix_array, 2u};
+    expect(index.count("ssi"sv) == 2u);
+    expect(index.count("issi"sv) == 2u);
+    expect(index.count("pp"sv) == 1u);
+    expect(locate_equal(index, text, "ssi"sv));
+    expect(locate_equal(index, text, "i"sv));
+  };
+
+  "fm_index_random_text"_test = []
+  {
+    uint64_t state{0x2545'f491'4f6c'dd1du};
+    small_vectors::string text;
+    for(uint32_t ix{}; ix != 5000u; ++ix)
+      {
+      state ^= state << 13;
+      state ^= state >> 7;
+      state ^= state << 17;
+      text.push_back(static_cast<char>('a' + state % 4u));
+      }
+    for(uint32_t rate: {1u, 4u, 32u})
+      {
+      auto const index{algo::fm_index<char>::build<'$'>(text, rate)};
+      bool valid{true};
+      for(uint32_t pos{}; pos < 4900u; pos += 97u)
+        for(uint32_t len: {1u, 3u, 8u, 20u})
+          {
+          auto const pattern{text.view().substr(pos, len)};
+          auto const expected{naive_locate(text.view(), pattern)};
+          valid = valid && index.count(pattern) == expected.size() && locate_equal(index, text, pattern);
+          }
+      expect(valid);
+      }
+  };
+
+  "fm_index_wide_chars"_test = []
+  {
+    constexpr auto text{U"źdźbło źdźbło"sv};
+    auto const index{algo::fm_index<char32_t>::build<'$'>(text, 4u)};
+    expect(index.count(U"źdź"sv) == 2u);
+    auto const positions{index.locate(U"bło"sv)};
+    expect(positions.size() == 2u);
+  };
+  }
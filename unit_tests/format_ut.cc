@@ -0,0 +1,58 @@
+#include <small_vectors/format.h>
+#include <unit_test_core.h>
+#include <string>
+
+namespace ut = boost::ut;
+using ut::expect;
+using ut::operator""_test;
+using namespace ut::operators::terse;
+
+int main()
+  {
+  using namespace std::string_view_literals;
+
+  "format_string"_test = []
+  {
+    auto const s{small_vectors::format("{}:{} {:>4}", "id", 42, 'x')};
+    static_assert(std::same_as<decltype(s), small_vectors::string const>);
+    expect(s == "id:42    x"sv);
+    auto const w{small_vectors::format(L"{}-{}", 1, L"w")};
+    static_assert(std::same_as<decltype(w), small_vectors::wstring const>);
+    expect(w == L"1-w"sv);
+    // output longer than stack buffer is formatted directly into sized result
+    std::string const long_text(1000u, 'z');
+    auto const l{small_vectors::format("[{}]", long_text)};
+    expect(l.size() == 1002u && l.view().substr(1u, 1000u) == long_text && l.view().back() == ']');
+  };
+
+  "format_to_append"_test = []
+  {
+    small_vectors::string s{"previous content"sv};
+    small_vectors::format_to(s, "{}+{}={}", 2, 2, 4);
+    expect(s == "2+2=4"sv);
+    small_vectors::format_append(s, " {}", "ok");
+    expect(s == "2+2=4 ok"sv);
+    std::string const long_text(300u, 'a');
+    small_vectors::format_append(s, "{}{}", long_text, 7);
+    expect(s.size() == 309u && s.view().starts_with("2+2=4 okaaa"sv) && s.view().ends_with("aa7"sv));
+
+    small_vectors::static_string<32> fixed;
+    small_vectors::format_to(fixed, "{:08x}", 0xbeefu);
+    expect(fixed == "0000beef"sv);
+    small_vectors::format_append(fixed, "|{}", -1);
+    expect(fixed == "0000beef|-1"sv);
+    expect(ut::throws([&] { small_vectors::format_append(fixed, "{}", long_text); }));
+  };
+
+  "format_to_n_truncates"_test = []
+  {
+    small_vectors::static_string<16> line;
+    auto length{small_vectors::format_to_n(line, "{} {}", "short", 1)};
+    expect(length == 7u && line == "short 1"sv);
+    length = small_vectors::format_to_n(line, "level={} message={}", 3, "truncated on overflow");
+    expect(length == 37u && line.size() == 15u && line == "level=3 message"sv);
+    small_vectors::string buffered;
+    length = small_vectors::format_to_n(buffered, "{}", std::string(100u, 'b'));
+    expect(length == 100u && buffered.size() == buffered.capacity() && buffered.capacity() < 100u);
+  };
+  }
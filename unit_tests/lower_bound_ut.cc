@@ -0,0 +1,131 @@
+#include <small_vectors/algo/bound_leaning_lower_bound.h>
+#include <small_vectors/algo/branchless_lower_bound.h>
+#include <small_vectors/algo/eytzinger_lower_bound.h>
+#include <small_vectors/algo/static_search_tree.h>
+#include <small_vectors/small_vector.h>
+#include <unit_test_core.h>
+#include <algorithm>
+
+namespace ut = boost::ut;
+using ut::expect;
+using ut::operator""_test;
+using namespace ut::operators::terse;
+namespace lb = small_vectors::algo::lower_bound;
+
+namespace
+  {
+template<typename value_type>
+auto sorted_random(uint32_t count, uint64_t seed, uint64_t modulo) -> small_vectors::vector<value_type>
+  {
+  small_vectors::vector<value_type> result(count);
+  for(value_type & v: result)
+    {
+    seed ^= seed << 13u;
+    seed ^= seed >> 7u;
+    seed ^= seed << 17u;
+    v = static_cast<value_type>(seed % modulo);
+    }
+  std::ranges::sort(result);
+  return result;
+  }
+
+///\brief checks every lower_bound variant against std::lower_bound for all keys in [low, high]
+template<typename value_type>
+auto check_all(small_vectors::vector<value_type> const & data, int64_t low, int64_t high) -> bool
+  {
+  lb::eytzinger_index const eytzinger{data};
+  lb::static_search_tree const tree{data};
+  for(int64_t key{low}; key <= high; ++key)
+    {
+    auto const v{static_cast<value_type>(key)};
+    auto const expected{std::lower_bound(data.begin(), data.end(), v)};
+    if(lb::branchless(data.begin(), data.end(), v) != expected)
+      return false;
+    if(lb::bound_leaning(data.begin(), data.end(), v, std::ranges::less{}) != expected)
+      return false;
+    if(eytzinger(data.begin(), data.end(), v) != expected)
+      return false;
+    if(tree(data.begin(), data.end(), v) != expected)
+      return false;
+    }
+  return true;
+  }
+
+consteval auto constexpr_lower_bound() -> bool
+  {
+  std::array<int, 9> const data{1, 3, 3, 5, 8, 13, 21, 34, 55};
+  for(int v{}; v != 60; ++v)
+    if(lb::branchless(data.begin(), data.end(), v) != std::ranges::lower_bound(data, v))
+      return false;
+  return true;
+  }
+
+static_assert(constexpr_lower_bound());
+  }  // namespace
+
+int main()
+  {
+  "lower_bound_small_sizes"_test = []
+  {
+    for(uint32_t size{}; size != 130u; ++size)
+      {
+      auto const data{sorted_random<int32_t>(size, 0x1234u + size, 200u)};
+      expect(check_all(data, -2, 202)) << size;
+      }
+  };
+
+  "lower_bound_duplicates"_test = []
+  {
+    auto const data{sorted_random<uint32_t>(5000u, 0x77u, 16u)};
+    expect(check_all(data, 0, 17));
+  };
+
+  "lower_bound_unsigned_full_range"_test = []
+  {
+    small_vectors::vector<uint32_t> data{0u, 1u, 0x7fff'ffffu, 0x8000'0000u, 0xffff'fffeu, 0xffff'ffffu, 0xffff'ffffu};
+    expect(check_all(data, 0, 3));
+    expect(check_all(data, 0x7fff'fffe, 0x8000'0001));
+    expect(check_all(data, 0xffff'fffd, 0xffff'ffff));
+  };
+
+  "lower_bound_other_types"_test = []
+  {
+    expect(check_all(sorted_random<int64_t>(3000u, 0x51u, 10000u), -1, 10001));
+    expect(check_all(sorted_random<uint16_t>(3000u, 0x52u, 4000u), 0, 4001));
+    expect(check_all(sorted_random<double>(3000u, 0x53u, 5000u), -1, 5001));
+  };
+
+  "lower_bound_large"_test = []
+  {
+    auto const data{sorted_random<int32_t>(300000u, 0x99u, 1u << 30)};
+    lb::eytzinger_index const eytzinger{data};
+    lb::static_search_tree const tree{data};
+    uint64_t seed{0x4242u};
+    bool all_equal{true};
+    for(uint32_t query{}; query != 100000u; ++query)
+      {
+      seed ^= seed << 13u;
+      seed ^= seed >> 7u;
+      seed ^= seed << 17u;
+      auto const v{static_cast<int32_t>(seed % (1u << 30))};
+      auto const expected{std::ranges::lower_bound(data, v)};
+      all_equal = all_equal && lb::branchless(data.begin(), data.end(), v) == expected
+                  && eytzinger(data.begin(), data.end(), v) == expected
+                  && tree(data.begin(), data.end(), v) == expected;
+      }
+    expect(all_equal);
+  };
+
+  "lower_bound_custom_compare"_test = []
+  {
+    auto data{sorted_random<int32_t>(1000u, 0x31u, 500u)};
+    std::ranges::reverse(data);
+    lb::eytzinger_index<int32_t, std::ranges::greater> const eytzinger{data};
+    for(int32_t v{-1}; v != 501; ++v)
+      {
+      auto const expected{std::lower_bound(data.begin(), data.end(), v, std::ranges::greater{})};
+      expect(lb::branchless(data.begin(), data.end(), v, std::ranges::greater{}) == expected);
+      expect(eytzinger(data.begin(), data.end(), v) == expected);
+      }
+  };
+  }
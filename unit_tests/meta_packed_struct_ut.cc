@@ -1,5 +1,6 @@
 #include <small_vectors/utils/meta_packed_struct.h>
 #include <unit_test_core.h>
+#include <vector>
 
 using namespace small_vectors::utils;
 using boost::ut::operator""_test;
@@ -597,6 +598,178 @@ int main()
     result |= metatests::run_consteval_test(fn_test);
     result |= metatests::run_constexpr_test(fn_test);
   };
+
+  using small_signed_struct = meta_packed_struct<
+    member<int8_t, mbs_fields::field_1, 4>,
+    member<int16_t, mbs_fields::field_2, 9>,
+    member<example_enum_value, mbs_fields::field_3, 2>,
+    member<int8_t, mbs_fields::field_4, 8>>;
+
+  "test_metabitstruct_pack_n_unpack_n"_test = [&result]
+  {
+    auto fn_test = []()
+    {
+      metatests::test_result tr;
+      using enum mbs_fields;
+      using enum example_enum_value;
+        {
+        std::array<small_signed_struct, 5> records;
+        std::array<int8_t, 5> const f1{-8, 7, -1, 0, 3};
+        std::array<int16_t, 5> const f2{-256, 255, -1, 0, -100};
+        std::array<example_enum_value, 5> const f3{value0, value3, value1, value2, value3};
+        std::array<int8_t, 5> const f4{-128, 127, -1, 0, 42};
+        for(std::size_t ix{}; ix != records.size(); ++ix)
+          {
+          get<field_1>(records[ix]) = f1[ix];
+          get<field_2>(records[ix]) = f2[ix];
+          get<field_3>(records[ix]) = f3[ix];
+          get<field_4>(records[ix]) = f4[ix];
+          }
+        std::array<uint32_t, 5> words{};
+        pack_n<uint32_t>(records, words);
+        for(std::size_t ix{}; ix != records.size(); ++ix)
+          tr |= constexpr_test(words[ix] == pack_value<uint32_t>(records[ix]));
+
+        std::array<small_signed_struct, 5> unpacked;
+        unpack_n(words, unpacked);
+        for(std::size_t ix{}; ix != records.size(); ++ix)
+          {
+          tr |= constexpr_test(get<field_1>(unpacked[ix]) == f1[ix]);
+          tr |= constexpr_test(get<field_2>(unpacked[ix]) == f2[ix]);
+          tr |= constexpr_test(get<field_3>(unpacked[ix]) == f3[ix]);
+          tr |= constexpr_test(get<field_4>(unpacked[ix]) == f4[ix]);
+          }
+        }
+        {
+        std::array<mixed_signed_struct, 2> records;
+        get<field_1>(records[0]) = -8;
+        get<field_2>(records[0]) = -0x7FFFF;
+        get<field_3>(records[0]) = 0x7FFFFF;
+        get<field_4>(records[0]) = -32768;
+        get<field_2>(records[1]) = 5;
+        std::array<uint64_t, 2> words{};
+        pack_n<uint64_t>(records, words);
+        std::array<mixed_signed_struct, 2> unpacked;
+        unpack_n(words, unpacked);
+        tr |= constexpr_test(get<field_1>(unpacked[0]) == -8);
+        tr |= constexpr_test(get<field_2>(unpacked[0]) == -0x7FFFF);
+        tr |= constexpr_test(get<field_3>(unpacked[0]) == 0x7FFFFF);
+        tr |= constexpr_test(get<field_4>(unpacked[0]) == -32768);
+        tr |= constexpr_test(get<field_2>(unpacked[1]) == 5);
+        }
+      return true;
+    };
+    result |= metatests::run_consteval_test(fn_test);
+    result |= metatests::run_constexpr_test(fn_test);
+  };
+
+  "test_metabitstruct_pack_n_exhaustive"_test = [&result]
+  {
+    using enum mbs_fields;
+    // every 23 bit pattern round trips through word kernel same as through scalar unpack_value
+    std::vector<uint32_t> words(1u << 23u);
+    for(uint32_t ix{}; ix != words.size(); ++ix)
+      words[ix] = ix;
+    std::vector<small_signed_struct> records(words.size());
+    unpack_n(words, records);
+    bool unpack_matches{true};
+    for(uint32_t ix{}; ix < words.size(); ix += 997u)
+      {
+      auto const expected{unpack_value<small_signed_struct>(words[ix])};
+      unpack_matches = unpack_matches && get<field_1>(records[ix]) == get<field_1>(expected)
+                       && get<field_2>(records[ix]) == get<field_2>(expected)
+                       && get<field_3>(records[ix]) == get<field_3>(expected)
+                       && get<field_4>(records[ix]) == get<field_4>(expected);
+      }
+    std::vector<uint32_t> repacked(words.size());
+    pack_n<uint32_t>(records, repacked);
+    boost::ut::expect(unpack_matches);
+    boost::ut::expect(repacked == words);
+  };
+
+  "test_metabitstruct_packed_array"_test = [&result]
+  {
+    auto fn_test = []()
+    {
+      metatests::test_result tr;
+      using enum mbs_fields;
+      using enum example_enum_value;
+      using array_type = packed_array<small_signed_struct, 4>;
+      static_assert(std::same_as<array_type::pack_type, uint32_t>);
+      static_assert(std::same_as<packed_array<mixed_small_struct, 4>::pack_type, uint8_t>);
+      static_assert(sizeof(array_type) == 4 * sizeof(uint32_t));
+
+      array_type arr;
+      small_signed_struct value;
+      get<field_1>(value) = -3;
+      get<field_2>(value) = 200;
+      get<field_3>(value) = value2;
+      get<field_4>(value) = -90;
+      arr.set(2, value);
+      tr |= constexpr_test(arr.get<field_1>(2) == -3);
+      tr |= constexpr_test(arr.get<field_2>(2) == 200);
+      tr |= constexpr_test(arr.get<field_3>(2) == value2);
+      tr |= constexpr_test(arr.get<field_4>(2) == -90);
+      tr |= constexpr_test(arr.get<field_2>(0) == 0);
+      tr |= constexpr_test(arr.words()[2] == pack_value<uint32_t>(value));
+
+      std::array<small_signed_struct, 2> values;
+      get<field_2>(values[0]) = -1;
+      get<field_4>(values[1]) = 1;
+      arr.assign(values);
+      tr |= constexpr_test(arr.get<field_2>(0) == -1);
+      tr |= constexpr_test(arr.get<field_4>(1) == 1);
+      tr |= constexpr_test(get<field_1>(arr[2]) == -3);
+
+      std::array<small_signed_struct, 3> out;
+      arr.unpack(out);
+      tr |= constexpr_test(get<field_2>(out[0]) == -1);
+      tr |= constexpr_test(get<field_4>(out[1]) == 1);
+      tr |= constexpr_test(get<field_4>(out[2]) == -90);
+
+      array_type copy{arr};
+      tr |= constexpr_test(copy == arr);
+      copy.set(3, value);
+      tr |= constexpr_test(copy != arr);
+      return true;
+    };
+    result |= metatests::run_consteval_test(fn_test);
+    result |= metatests::run_constexpr_test(fn_test);
+  };
+
+  "test_metabitstruct_packed_array_wide_members"_test = [&result]
+  {
+    auto fn_test = []()
+    {
+      metatests::test_result tr;
+      using enum mbs_fields;
+      // member types wider than word chosen from total bit width, 8 byte struct also takes word path at runtime
+      using wide_struct = meta_packed_struct<member<uint32_t, field_1, 3>, member<int16_t, field_2, 4>>;
+      using array_type = packed_array<wide_struct, 3>;
+      static_assert(std::same_as<array_type::pack_type, uint8_t>);
+
+      array_type arr;
+      wide_struct value;
+      get<field_1>(value) = 5u;
+      get<field_2>(value) = -6;
+      arr.set(1, value);
+      tr |= constexpr_test(arr.get<field_1>(1) == 5u);
+      tr |= constexpr_test(arr.get<field_2>(1) == -6);
+      tr |= constexpr_test(arr.words()[1] == pack_value<uint8_t>(value));
+
+      std::array<wide_struct, 3> values{value, wide_struct{}, value};
+      get<field_1>(values[1]) = 7u;
+      get<field_2>(values[1]) = 7;
+      arr.assign(values);
+      std::array<wide_struct, 3> out;
+      arr.unpack(out);
+      tr |= constexpr_test(get<field_1>(out[1]) == 7u && get<field_2>(out[1]) == 7);
+      tr |= constexpr_test(get<field_2>(out[2]) == -6);
+      return true;
+    };
+    result |= metatests::run_consteval_test(fn_test);
+    result |= metatests::run_constexpr_test(fn_test);
+  };
   return result ? EXIT_SUCCESS : EXIT_FAILURE;
   }
 
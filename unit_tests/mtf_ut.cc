@@ -0,0 +1,90 @@
+#include <small_vectors/algo/mtf.h>
+#include <small_vectors/small_vector.h>
+#include <unit_test_core.h>
+#include <string_view>
+
+namespace ut = boost::ut;
+using ut::expect;
+using ut::operator""_test;
+using namespace ut::operators::terse;
+using namespace std::string_view_literals;
+namespace mtf = small_vectors::algo::mtf;
+
+namespace
+  {
+auto naive_encode(std::span<uint8_t const> data) -> small_vectors::vector<uint8_t>
+  {
+  small_vectors::vector<uint8_t> table(256u);
+  std::iota(table.begin(), table.end(), uint8_t{});
+  small_vectors::vector<uint8_t> result;
+  for(uint8_t c: data)
+    {
+    auto const it{std::ranges::find(table, c)};
+    result.push_back(static_cast<uint8_t>(it - table.begin()));
+    std::ranges::rotate(table.begin(), it, std::ranges::next(it));
+    }
+  return result;
+  }
+
+auto random_bytes(uint32_t count, uint64_t seed, uint32_t alphabet) -> small_vectors::vector<uint8_t>
+  {
+  small_vectors::vector<uint8_t> result(count);
+  for(uint8_t & b: result)
+    {
+    seed ^= seed << 13u;
+    seed ^= seed >> 7u;
+    seed ^= seed << 17u;
+    b = static_cast<uint8_t>(seed % alphabet);
+    }
+  return result;
+  }
+
+consteval auto constexpr_round_trip() -> bool
+  {
+  constexpr auto text{"bananaaa"sv};
+  std::array<uint8_t, 8> encoded{};
+  mtf::encode(text, encoded.begin());
+  std::array<uint8_t, 8> const expected{98, 98, 110, 1, 1, 1, 0, 0};
+  std::array<uint8_t, 8> decoded{};
+  mtf::decode(encoded, decoded.begin());
+  return encoded == expected && std::ranges::equal(decoded, text, {}, {}, [](char c) { return uint8_t(c); });
+  }
+
+static_assert(constexpr_round_trip());
+  }  // namespace
+
+int main()
+  {
+  "mtf_encode_decode"_test = []
+  {
+    // every alphabet size covers different table depths, beyond first vector register too
+    for(uint32_t alphabet: {2u, 16u, 31u, 33u, 200u, 256u})
+      {
+      auto const data{random_bytes(20000u, 0x1234u + alphabet, alphabet)};
+      small_vectors::vector<uint8_t> encoded(data.size());
+      expect(mtf::encode(data, encoded.begin()) == encoded.end());
+      expect(std::ranges::equal(encoded, naive_encode(data))) << alphabet;
+
+      small_vectors::vector<uint8_t> decoded(data.size());
+      mtf::decode(encoded, decoded.begin());
+      expect(std::ranges::equal(decoded, data)) << alphabet;
+      }
+  };
+
+  "mtf_in_place"_test = []
+  {
+    auto data{random_bytes(5000u, 0x99u, 64u)};
+    auto const original{data};
+    mtf::encode(data, data.begin());
+    mtf::decode(data, data.begin());
+    expect(std::ranges::equal(data, original));
+  };
+
+  "mtf_std_byte"_test = []
+  {
+    std::array<std::byte, 4> const data{std::byte{7}, std::byte{7}, std::byte{255}, std::byte{7}};
+    std::array<uint8_t, 4> encoded{};
+    mtf::encode(data, encoded.begin());
+    expect(encoded == std::array<uint8_t, 4>{7, 0, 255, 1});
+  };
+  }
@@ -0,0 +1,152 @@
+#include <small_vectors/packed_vector.h>
+#include <unit_test_core.h>
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace ut = boost::ut;
+using ut::expect;
+using ut::operator""_test;
+using small_vectors::packed_vector;
+
+namespace
+  {
+constexpr auto next_random(uint64_t & state) noexcept -> uint64_t
+  {
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+  }
+
+template<typename vector_type>
+auto random_values(std::size_t count, uint64_t seed) -> std::vector<typename vector_type::value_type>
+  {
+  using value_type = typename vector_type::value_type;
+  std::vector<value_type> result(count);
+  for(auto & value: result)
+    {
+    auto const raw{next_random(seed) & vector_type::value_mask};
+    if constexpr(vector_type::is_signed)
+      value = small_vectors::utils::detail::uncompress_value<vector_type::bit_width, value_type>(raw);
+    else
+      value = static_cast<value_type>(raw);
+    }
+  return result;
+  }
+
+template<typename vector_type>
+auto round_trip(std::size_t count, uint64_t seed) -> bool
+  {
+  auto const values{random_values<vector_type>(count, seed)};
+  vector_type packed;
+  for(auto value: values)
+    packed.push_back(value);
+  if(packed.size() != count || !std::ranges::equal(packed.values(), values))
+    return false;
+  // bulk unpack from every offset modulo simd group
+  for(typename vector_type::size_type first{}; first != std::min<std::size_t>(count, 9u); ++first)
+    {
+    std::vector<typename vector_type::value_type> out(count - first);
+    packed.unpack(first, out);
+    if(!std::ranges::equal(out, std::span{values}.subspan(first)))
+      return false;
+    }
+  return true;
+  }
+  }  // namespace
+
+static_assert(std::same_as<packed_vector<5>::value_type, uint32_t>);
+static_assert(std::same_as<packed_vector<20, true>::value_type, int32_t>);
+static_assert(std::same_as<packed_vector<40>::value_type, uint64_t>);
+
+static_assert(
+  []
+  {
+    packed_vector<12, true> v{-2048, 2047, -1, 0, 1000};
+    if(v.size() != 5u || v[0] != -2048 || v[1] != 2047 || v[2] != -1 || v[3] != 0 || v[4] != 1000)
+      return false;
+    v.set(2, 5);
+    v.pop_back();
+    v.push_back(-7);
+    std::array<int32_t, 4> out{};
+    v.unpack(1, out);
+    return v[2] == 5 && out == std::array<int32_t, 4>{2047, 5, 0, -7};
+  }()
+);
+
+static_assert(
+  []
+  {
+    // values straddling word boundary
+    packed_vector<57> v(3u, 0x1ff'ffff'ffff'ffffull);
+    v.set(1, 0x123'4567'89ab'cdefull);
+    return v[0] == 0x1ff'ffff'ffff'ffffull && v[1] == 0x123'4567'89ab'cdefull && v[2] == 0x1ff'ffff'ffff'ffffull;
+  }()
+);
+
+int main()
+  {
+  "packed_vector_round_trip"_test = []
+  {
+    for(std::size_t count: {0u, 1u, 7u, 8u, 9u, 63u, 64u, 65u, 1000u, 4099u})
+      {
+      expect(round_trip<packed_vector<1>>(count, 0x11u + count)) << count;
+      expect(round_trip<packed_vector<5>>(count, 0x21u + count)) << count;
+      expect(round_trip<packed_vector<12>>(count, 0x31u + count)) << count;
+      expect(round_trip<packed_vector<12, true>>(count, 0x41u + count)) << count;
+      expect(round_trip<packed_vector<20>>(count, 0x51u + count)) << count;
+      expect(round_trip<packed_vector<20, true>>(count, 0x61u + count)) << count;
+      expect(round_trip<packed_vector<25, true>>(count, 0x71u + count)) << count;
+      expect(round_trip<packed_vector<31>>(count, 0x81u + count)) << count;
+      expect(round_trip<packed_vector<32, true>>(count, 0x91u + count)) << count;
+      expect(round_trip<packed_vector<47, true>>(count, 0xa1u + count)) << count;
+      expect(round_trip<packed_vector<57>>(count, 0xb1u + count)) << count;
+      }
+  };
+
+  "packed_vector_set"_test = []
+  {
+    auto values{random_values<packed_vector<20, true>>(1000u, 0x99u)};
+    packed_vector<20, true> packed(1000u);
+    for(uint32_t ix{}; ix != values.size(); ++ix)
+      packed.set(ix, values[ix]);
+    // overwriting must not disturb neighbours
+    for(uint32_t ix{}; ix < values.size(); ix += 3u)
+      {
+      values[ix] = -values[ix] / 2;
+      packed.set(ix, values[ix]);
+      }
+    expect(std::ranges::equal(packed.values(), values));
+    packed.set(10u, 1 << 20);
+    expect(packed[10u] == 0);
+  };
+
+  "packed_vector_memory"_test = []
+  {
+    packed_vector<5> inline_vector{1u, 2u, 3u};
+    expect(inline_vector.memory_size() <= 2u * sizeof(uint64_t));
+
+    packed_vector<12> packed;
+    for(uint32_t ix{}; ix != 100000u; ++ix)
+      packed.push_back(ix & 0xfffu);
+    // 12 bits per value plus geometric growth slack
+    expect(packed.memory_size() < 100000u * 12u / 8u * 2u);
+    expect(packed.back() == (99999u & 0xfffu));
+  };
+
+  "packed_vector_resize"_test = []
+  {
+    packed_vector<12, true> packed(10u, -5);
+    expect(packed.size() == 10u && packed[9u] == -5);
+    packed.resize(3u);
+    expect(packed.size() == 3u);
+    packed.resize(6u, 7);
+    expect(packed[2u] == -5 && packed[3u] == 7 && packed[5u] == 7);
+    // bits past size are cleared so equal content compares equal
+    packed_vector<12, true> const expected{-5, -5, -5, 7, 7, 7};
+    expect(packed == expected);
+    packed.clear();
+    expect(packed.empty() && packed.words().empty());
+  };
+  }
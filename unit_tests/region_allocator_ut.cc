@@ -0,0 +1,219 @@
+#include <unit_test_core.h>
+#include <small_vectors/interprocess/fork.h>
+#include <small_vectors/interprocess/shared_mem_utils.h>
+#include <small_vectors/interprocess/offset_ptr.h>
+#include <small_vectors/interprocess/region_allocator.h>
+#include <small_vectors/interprocess/offset_vector.h>
+#include <small_vectors/static_vector.h>
+#include <small_vectors/basic_string.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+namespace ut = boost::ut;
+using boost::ut::operator""_test;
+namespace ip = small_vectors::ip;
+namespace bip = boost::interprocess;
+using namespace std::string_view_literals;
+
+namespace
+  {
+constexpr auto shmem_name{"region allocator test for " SMALL_VECTORS_COMPILER_INFO};
+constexpr std::size_t shmem_size{1u << 20u};
+
+using name_type = small_vectors::static_string<24>;
+
+struct record
+  {
+  uint32_t id;
+  name_type name;
+  };
+
+using record_vector = ip::offset_vector<record>;
+using index_vector = ip::offset_vector<ip::offset_vector<uint32_t>>;
+
+// memory offset table, arena takes rest of region
+using records_decl = ip::shared_type_decl<record_vector>;
+using index_decl = ip::shared_type_decl<index_vector, records_decl>;
+using head_decl = ip::shared_type_decl<ip::offset_ptr<record>, index_decl>;
+using padding_decl = ip::shared_type_decl<std::array<std::byte, 8>, head_decl>;
+using arena_decl = ip::shared_type_decl<ip::region_arena, padding_decl>;
+
+auto construct_shared(bip::mapped_region & region) -> record_vector &
+  {
+  auto & arena{*ip::construct_at<arena_decl>(region, region.get_size() - arena_decl::offset)};
+  auto & records{*ip::construct_at<records_decl>(region, arena)};
+  ip::construct_at<index_decl>(region, arena);
+  ip::construct_at<head_decl>(region);
+  return records;
+  }
+
+auto check_records(record_vector const & records, uint32_t count) -> bool
+  {
+  if(records.size() != count)
+    return false;
+  for(uint32_t ix{}; ix != count; ++ix)
+    if(records[ix].id != ix || records[ix].name.view() != "record"sv)
+      return false;
+  return true;
+  }
+  }  // namespace
+
+int main()
+  {
+  "offset_ptr"_test = []
+  {
+    std::array<uint32_t, 4> values{1u, 2u, 3u, 4u};
+    ip::offset_ptr<uint32_t> ptr;
+    ut::expect(!ptr);
+    ut::expect(ptr == nullptr);
+    ptr = values.data();
+    ut::expect(ptr.get() == values.data());
+    ut::expect(ptr[2] == 3u);
+    ++ptr;
+    ut::expect(*ptr == 2u);
+    ip::offset_ptr<uint32_t> const copy{ptr + 2};
+    ut::expect(*copy == 4u);
+    ut::expect(copy - ptr == 2);
+    ut::expect(ptr < copy);
+    ip::offset_ptr<uint32_t const> const converted{copy};
+    ut::expect(converted.get() == &values[3]);
+    // copy at other address keeps pointee
+    std::array<ip::offset_ptr<uint32_t>, 3> table{ptr, ptr, copy};
+    ut::expect(table[0].offset() != table[1].offset());
+    ut::expect(table[0] == table[1] && *table[2] == 4u);
+  };
+
+  "region_arena_reuse"_test = []
+  {
+    alignas(ip::region_arena) std::array<std::byte, 4096> buffer;
+    auto & arena{*std::construct_at(reinterpret_cast<ip::region_arena *>(buffer.data()), buffer.size())};
+    auto const unused{arena.unused()};
+    void * first{arena.allocate(20)};
+    ut::expect(first != nullptr && arena.contains(first));
+    ut::expect(reinterpret_cast<std::uintptr_t>(first) % ip::region_arena::block_alignment == 0u);
+    ut::expect(arena.unused() == unused - 32u);
+    void * second{arena.allocate(32)};
+    arena.deallocate(first, 20);
+    // same size class is reused
+    ut::expect(arena.allocate(17) == first);
+    ut::expect(arena.allocate(8192) == nullptr);
+    ut::expect(arena.allocate(8, 64) == nullptr);
+    arena.deallocate(second, 32);
+    ut::expect(arena.unused() == unused - 64u);
+  };
+
+  "offset_vector_local"_test = []
+  {
+    alignas(ip::region_arena) std::array<std::byte, 16384> buffer;
+    auto & arena{*std::construct_at(reinterpret_cast<ip::region_arena *>(buffer.data()), buffer.size())};
+    ip::offset_vector<uint32_t> values{arena};
+    for(uint32_t ix{}; ix != 1000u; ++ix)
+      values.push_back(ix);
+    ut::expect(values.size() == 1000u);
+    ut::expect(values.capacity() == 1024u);
+    ut::expect(values.front() == 0u && values.back() == 999u);
+    ut::expect(std::ranges::equal(values, std::views::iota(0u, 1000u)));
+    values.resize(10u);
+    ip::offset_vector<uint32_t> copy{values};
+    ut::expect(copy == values);
+    values.push_back(values.front());
+    ut::expect(values.back() == 0u);
+    ip::offset_vector<uint32_t> moved{std::move(copy)};
+    ut::expect(copy.empty() && moved.size() == 10u);
+    values.clear();
+    values = moved;
+    ut::expect(values == moved);
+
+    bool thrown{};
+    try
+      {
+      values.reserve(100000u);
+      }
+    catch(std::bad_alloc const &)
+      {
+      thrown = true;
+      }
+    ut::expect(thrown);
+    ut::expect(values.size() == 10u);
+  };
+
+  "offset_vector_mapped_twice"_test = []
+  {
+    bip::shared_memory_object::remove(shmem_name);
+    bip::shared_memory_object shm{bip::create_only, shmem_name, bip::read_write};
+    shm.truncate(shmem_size);
+    bip::mapped_region region{shm, bip::read_write};
+    record_vector & records{construct_shared(region)};
+    for(uint32_t ix{}; ix != 100u; ++ix)
+      records.push_back(record{.id = ix, .name = name_type{"record"sv}});
+    ip::ref<head_decl>(region) = &records[42];
+
+    // second mapping of same memory lives at other address
+    bip::mapped_region alias{shm, bip::read_write};
+    ut::expect(alias.get_address() != region.get_address()) >> ut::fatal;
+    record_vector & alias_records{ip::ref<records_decl>(alias)};
+    ut::expect(check_records(alias_records, 100u));
+    ut::expect(alias_records.data() != records.data());
+    ut::expect(ip::ref<head_decl>(alias)->id == 42u);
+    ut::expect(ip::ref<head_decl>(alias).get() == &alias_records[42]);
+
+    // growth through alias is visible through first mapping
+    alias_records.push_back(record{.id = 100u, .name = name_type{"record"sv}});
+    ut::expect(check_records(records, 101u));
+    bip::shared_memory_object::remove(shmem_name);
+  };
+
+  "offset_vector_fork"_test = []
+  {
+    bip::shared_memory_object::remove(shmem_name);
+    bip::shared_memory_object shm{bip::create_only, shmem_name, bip::read_write};
+    shm.truncate(shmem_size);
+    bip::mapped_region region{shm, bip::read_write};
+    record_vector & records{construct_shared(region)};
+    index_vector & index{ip::ref<index_decl>(region)};
+    records.push_back(record{.id = 0u, .name = name_type{"record"sv}});
+
+    auto child = ip::fork(
+      [](std::string_view shared_mem_name)
+      {
+        bip::shared_memory_object shm_obj{bip::open_only, shared_mem_name.data(), bip::read_write};
+        // inherited parent mapping still occupies its address so region is mapped elsewhere
+        bip::mapped_region cregion{shm_obj, bip::read_write};
+        record_vector & crecords{ip::ref<records_decl>(cregion)};
+        index_vector & cindex{ip::ref<index_decl>(cregion)};
+        if(!check_records(crecords, 1u))
+          return false;
+        auto & arena{crecords.get_allocator().arena()};
+        for(uint32_t ix{1u}; ix != 500u; ++ix)
+          crecords.push_back(record{.id = ix, .name = name_type{"record"sv}});
+        for(uint32_t ix{}; ix != 16u; ++ix)
+          {
+          auto & bucket{cindex.emplace_back(arena)};
+          for(uint32_t jx{}; jx != ix * 10u; ++jx)
+            bucket.push_back(ix * 1000u + jx);
+          }
+        return true;
+      },
+      shmem_name
+    );
+    ut::expect(static_cast<bool>(child)) >> ut::fatal;
+    ut::expect(child->join()) >> ut::fatal;
+
+    ut::expect(check_records(records, 500u));
+    ut::expect(index.size() == 16u) >> ut::fatal;
+    for(uint32_t ix{}; ix != 16u; ++ix)
+      {
+      ut::expect(index[ix].size() == ix * 10u);
+      ut::expect(index[ix].empty() || index[ix].back() == ix * 1000u + ix * 10u - 1u);
+      }
+    while(index.size() != 4u)
+      index.pop_back();
+    ut::expect(index.back().size() == 30u);
+    bip::shared_memory_object::remove(shmem_name);
+  };
+  }
@@ -0,0 +1,107 @@
+#include <small_vectors/algo/rle.h>
+#include <small_vectors/small_vector.h>
+#include <unit_test_core.h>
+#include <array>
+
+namespace ut = boost::ut;
+using ut::expect;
+using ut::operator""_test;
+using namespace ut::operators::terse;
+namespace rle = small_vectors::algo::rle;
+
+namespace
+  {
+auto encode(std::span<uint8_t const> data) -> small_vectors::vector<uint16_t>
+  {
+  small_vectors::vector<uint16_t> symbols;
+  rle::encode(data, std::back_inserter(symbols));
+  return symbols;
+  }
+
+consteval auto constexpr_round_trip() -> bool
+  {
+  std::array<uint8_t, 10> const data{0, 0, 0, 5, 0, 0, 0, 0, 0, 0};
+  std::array<uint16_t, 5> symbols{};
+  // 3 zeros = run_a run_a, 5 -> 6, 6 zeros = run_b run_b
+  auto const end{rle::encode(data, symbols.begin())};
+  std::array<uint8_t, 10> decoded{};
+  auto const count{rle::decode(symbols, decoded)};
+  return end == symbols.end() && symbols == std::array<uint16_t, 5>{0, 0, 6, 1, 1} && count.has_value()
+         && *count == data.size() && decoded == data;
+  }
+
+static_assert(constexpr_round_trip());
+  }  // namespace
+
+int main()
+  {
+  "rle_zero_runs"_test = []
+  {
+    for(uint32_t run{1u}; run != 600u; ++run)
+      {
+      small_vectors::vector<uint8_t> data(run + 2u);
+      data.front() = 1u;
+      data.back() = 2u;
+      auto const symbols{encode(data)};
+      expect(symbols.size() == 2u + static_cast<uint32_t>(std::bit_width(run + 1u) - 1)) << run;
+
+      small_vectors::vector<uint8_t> decoded(data.size());
+      auto const count{rle::decode(symbols, decoded)};
+      expect(count.has_value() && *count == data.size()) << run;
+      expect(std::ranges::equal(decoded, data)) << run;
+      }
+  };
+
+  "rle_mixed"_test = []
+  {
+    small_vectors::vector<uint8_t> data(5000u);
+    uint64_t seed{0x51u};
+    for(uint8_t & b: data)
+      {
+      seed ^= seed << 13u;
+      seed ^= seed >> 7u;
+      seed ^= seed << 17u;
+      // mostly zeros with runs of varying length
+      b = seed % 5u == 0u ? static_cast<uint8_t>(seed >> 32u) : uint8_t{};
+      }
+    auto const symbols{encode(data)};
+    expect(symbols.size() < data.size());
+    expect(std::ranges::all_of(symbols, [](uint16_t s) { return s < rle::alphabet_size; }));
+
+    small_vectors::vector<uint8_t> decoded(data.size());
+    auto const count{rle::decode(symbols, decoded)};
+    expect(count.has_value() && *count == data.size());
+    expect(std::ranges::equal(decoded, data));
+  };
+
+  "rle_overflow"_test = []
+  {
+    small_vectors::vector<uint8_t> data(100u);
+    data[50u] = 3u;
+    auto const symbols{encode(data)};
+    small_vectors::vector<uint8_t> small(99u);
+    auto const count{rle::decode(symbols, small)};
+    expect(!count.has_value() && count.error() == rle::decode_error_e::output_overflow);
+
+    small_vectors::vector<uint8_t> large(200u);
+    auto const partial{rle::decode(symbols, large)};
+    expect(partial.has_value() && *partial == 100u);
+  };
+
+  "rle_corrupted"_test = []
+  {
+    small_vectors::vector<uint8_t> out(16u);
+    std::array<uint16_t, 3u> const symbols{2u, rle::alphabet_size, 3u};
+    auto const count{rle::decode(symbols, out)};
+    expect(!count.has_value() && count.error() == rle::decode_error_e::corrupted);
+    std::array<uint16_t, 2u> const last_valid{256u, 0xffffu};
+    auto const truncated{rle::decode(last_valid, out)};
+    expect(!truncated.has_value() && truncated.error() == rle::decode_error_e::corrupted);
+    // wider symbols are not truncated into alphabet
+    std::array<uint32_t, 1u> const wide{0x1'0002u};
+    auto const wide_count{rle::decode(wide, out)};
+    expect(!wide_count.has_value() && wide_count.error() == rle::decode_error_e::corrupted);
+    auto const valid{rle::decode(std::array<uint16_t, 1u>{256u}, out)};
+    expect(valid.has_value() && *valid == 1u && out[0u] == 255u);
+  };
+  }
@@ -0,0 +1,157 @@
+#include <unit_test_core.h>
+#include <small_vectors/interprocess/fork.h>
+#include <small_vectors/interprocess/shared_mem_utils.h>
+#include <small_vectors/interprocess/seqlock.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+namespace ut = boost::ut;
+using boost::ut::operator""_test;
+namespace ip = small_vectors::ip;
+namespace bip = boost::interprocess;
+
+namespace
+  {
+constexpr auto shmem_name{"seqlock test for " SMALL_VECTORS_COMPILER_INFO};
+
+constexpr unsigned reader_count{8u};
+constexpr uint64_t write_count{200000u};
+
+///\brief every field derives from version so torn copy is detected
+struct quote
+  {
+  uint64_t version;
+  std::array<uint64_t, 13> levels;
+  uint32_t checksum;
+  uint16_t flags;
+
+  [[nodiscard]]
+  static constexpr auto make(uint64_t version) noexcept -> quote
+    {
+    quote result{.version = version, .levels = {}, .checksum = static_cast<uint32_t>(version * 31u), .flags = 0x5a5au};
+    for(std::size_t ix{}; ix != result.levels.size(); ++ix)
+      result.levels[ix] = version * (ix + 1u);
+    return result;
+    }
+
+  [[nodiscard]]
+  constexpr auto consistent() const noexcept -> bool
+    {
+    return *this == make(version);
+    }
+
+  constexpr auto operator==(quote const &) const noexcept -> bool = default;
+  };
+
+using seqlock_type = ip::seqlock<quote>;
+using seqlock_decl = ip::shared_type_decl<seqlock_type>;
+using readers_ready_decl = ip::shared_type_decl<std::atomic<uint32_t>, seqlock_decl>;
+  }  // namespace
+
+int main()
+  {
+  "seqlock_basic"_test = []
+  {
+    seqlock_type lock{quote::make(1u)};
+    ut::expect(lock.version() == 0u);
+    ut::expect(lock.load() == quote::make(1u));
+    lock.store(quote::make(2u));
+    ut::expect(lock.version() == 1u);
+    auto const value{lock.try_load()};
+    ut::expect(value.has_value() && *value == quote::make(2u));
+    lock.modify([](quote & q) noexcept { q = quote::make(q.version + 5u); });
+    ut::expect(lock.load() == quote::make(7u));
+    ut::expect(lock.version() == 2u);
+  };
+
+  "seqlock_threads"_test = []
+  {
+    seqlock_type lock{quote::make(0u)};
+    std::atomic<bool> stop{};
+    std::atomic<uint32_t> torn{};
+    std::vector<std::jthread> readers;
+    for(unsigned ix{}; ix != 4u; ++ix)
+      readers.emplace_back(
+        [&]
+        {
+          uint64_t last{};
+          while(!stop.load(std::memory_order_relaxed))
+            {
+            quote const value{lock.load()};
+            if(!value.consistent() || value.version < last)
+              torn.fetch_add(1u);
+            last = value.version;
+            }
+        }
+      );
+    // two writers serialize on sequence
+    std::jthread second_writer{[&]
+                               {
+                                 for(uint64_t ix{}; ix != 20000u; ++ix)
+                                   lock.modify([](quote & q) noexcept { q = quote::make(q.version + 1u); });
+                               }};
+    for(uint64_t ix{}; ix != 20000u; ++ix)
+      lock.modify([](quote & q) noexcept { q = quote::make(q.version + 1u); });
+    second_writer.join();
+    stop.store(true);
+    readers.clear();
+    ut::expect(torn.load() == 0u);
+    ut::expect(lock.load() == quote::make(40000u));
+    ut::expect(lock.version() == 40000u);
+  };
+
+  "seqlock_fork_stress"_test = []
+  {
+    bip::shared_memory_object::remove(shmem_name);
+    bip::shared_memory_object shm{bip::create_only, shmem_name, bip::read_write};
+    shm.truncate(readers_ready_decl::end_offset);
+    bip::mapped_region region{shm, bip::read_write};
+    seqlock_type & lock{*ip::construct_at<seqlock_decl>(region, quote::make(0u))};
+    std::atomic<uint32_t> & readers_ready{*ip::construct_at<readers_ready_decl>(region, 0u)};
+
+    // readers poll snapshot until last version, every copy must be consistent and versions never go back
+    std::vector<ip::fork_child_t> readers;
+    for(unsigned ix{}; ix != reader_count; ++ix)
+      {
+      auto child = ip::fork(
+        [](std::string_view shared_mem_name)
+        {
+          bip::shared_memory_object shm_obj{bip::open_only, shared_mem_name.data(), bip::read_write};
+          bip::mapped_region cregion{shm_obj, bip::read_write};
+          seqlock_type const & clock{ip::ref<seqlock_decl>(cregion)};
+          ip::ref<readers_ready_decl>(cregion).fetch_add(1u, std::memory_order_release);
+          uint64_t last{};
+          while(last != write_count)
+            {
+            quote const value{clock.load()};
+            if(!value.consistent() || value.version < last)
+              return false;
+            last = value.version;
+            }
+          return true;
+        },
+        shmem_name
+      );
+      ut::expect(static_cast<bool>(child)) >> ut::fatal;
+      readers.push_back(*child);
+      }
+
+    while(readers_ready.load(std::memory_order_acquire) != reader_count)
+      std::this_thread::yield();
+    for(uint64_t version{1u}; version <= write_count; ++version)
+      lock.store(quote::make(version));
+
+    for(auto const & reader: readers)
+      ut::expect(reader.join());
+    ut::expect(lock.version() == write_count);
+    bip::shared_memory_object::remove(shmem_name);
+  };
+  }
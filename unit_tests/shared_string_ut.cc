@@ -0,0 +1,120 @@
+#include <small_vectors/shared_string.h>
+#include <unit_test_core.h>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace ut = boost::ut;
+using ut::expect;
+using ut::operator""_test;
+using namespace ut::operators::terse;
+using small_vectors::shared_string;
+
+int main()
+  {
+  using namespace std::string_view_literals;
+  constexpr auto long_text{"a label that is long enough to require a shared heap block"sv};
+
+  "shared_string_buffered"_test = []
+  {
+    shared_string const empty;
+    expect(empty.empty() && empty.is_buffered() && *empty.c_str() == '\0' && empty.use_count() == 0u);
+    shared_string const s{"short label"sv};
+    expect(s.is_buffered() && s == "short label"sv && std::string_view{s.c_str()} == "short label"sv);
+    shared_string const copy{s};
+    expect(copy == s && copy.data() != s.data() && copy.use_count() == 0u);
+    shared_string const full{std::string(shared_string::buffered_capacity(), 'x')};
+    expect(full.is_buffered() && full.size() == shared_string::buffered_capacity());
+    shared_string const over{std::string(shared_string::buffered_capacity() + 1u, 'x')};
+    expect(!over.is_buffered() && over.use_count() == 1u);
+  };
+
+  "shared_string_heap_sharing"_test = [&]
+  {
+    shared_string const s{long_text};
+    expect(!s.is_buffered() && s == long_text && std::string_view{s.c_str()} == long_text);
+      {
+      shared_string const copy{s};
+      expect(copy.data() == s.data() && s.use_count() == 2u && copy == s);
+      shared_string assigned;
+      assigned = copy;
+      expect(s.use_count() == 3u);
+      shared_string moved{std::move(assigned)};
+      expect(s.use_count() == 3u && assigned.empty() && moved == long_text);
+      }
+    expect(s.use_count() == 1u);
+  };
+
+  "shared_string_swap_assign"_test = [&]
+  {
+    shared_string a{"inline"sv};
+    shared_string b{long_text};
+    swap(a, b);
+    expect(a == long_text && b == "inline"sv && a.use_count() == 1u);
+    swap(a, b);
+    expect(b == long_text && a == "inline"sv);
+    shared_string c{long_text.substr(1u)};
+    swap(b, c);
+    expect(c == long_text && b == long_text.substr(1u));
+    a = b;
+    expect(a.data() == b.data() && b.use_count() == 2u);
+    a = shared_string{"x"sv};
+    expect(a == "x"sv && b.use_count() == 1u);
+    a = std::move(c);
+    expect(a == long_text && c.empty());
+  };
+
+  "shared_string_interop"_test = [&]
+  {
+    small_vectors::string const source{long_text};
+    shared_string const s{source};
+    auto const mutable_copy{s.to_string()};
+    static_assert(std::same_as<decltype(mutable_copy), small_vectors::string const>);
+    expect(mutable_copy == source.view());
+    small_vectors::string const direct{s.view()};
+    expect(direct == long_text);
+    expect(s.find("long"sv) == 16u && s.contains("heap"sv) && s.starts_with("a label"sv) && s.ends_with("block"sv));
+    expect(s.substr(2u, 5u) == "label"sv);
+    expect(s.substr(s.size()).empty() && s.substr(s.size() + 1u).empty() && s.substr(shared_string::npos, 3u).empty());
+    expect(s < shared_string{"b"sv} && s > "a"sv);
+
+    std::unordered_set<shared_string, small_vectors::string_hash, small_vectors::string_equal> set;
+    set.insert(s);
+    expect(set.contains(long_text) && !set.contains("other"sv));
+    expect(std::hash<shared_string>{}(s) == small_vectors::string_hash{}(long_text));
+  };
+
+  "shared_string_length_limit"_test = [&]
+  {
+    if constexpr(sizeof(std::size_t) > sizeof(shared_string::size_type))
+      {
+      // characters are never read, length is checked before allocation
+      std::string_view const too_long{long_text.data(), std::size_t{shared_string::max_size()} + 1u};
+      expect(ut::throws<std::length_error>([&] { shared_string const s{too_long}; }));
+      }
+  };
+
+  "shared_string_threads"_test = [&]
+  {
+    shared_string const s{long_text};
+      {
+      std::vector<std::jthread> threads;
+      for(int t{}; t != 4; ++t)
+        threads.emplace_back(
+          [&s]
+          {
+            std::vector<shared_string> copies;
+            for(int round{}; round != 200; ++round)
+              {
+              for(int ix{}; ix != 64; ++ix)
+                copies.push_back(s);
+              copies.clear();
+              }
+          }
+        );
+      }
+    expect(s.use_count() == 1u && s == long_text);
+  };
+  }
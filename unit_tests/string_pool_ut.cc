@@ -0,0 +1,111 @@
+#include <small_vectors/string_pool.h>
+#include <small_vectors/basic_string.h>
+#include <unit_test_core.h>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace ut = boost::ut;
+using ut::expect;
+using ut::operator""_test;
+using namespace ut::operators::terse;
+using small_vectors::interned;
+using small_vectors::interned_string;
+
+static_assert(sizeof(interned_string) == sizeof(void *));
+// compile time handles are constants with O(1) equality
+static_assert(interned<"GET"> == interned<"GET">);
+static_assert(interned<"GET">.size() == 3u && interned<"GET">.view() == "GET");
+static_assert(interned<"GET">.hash() == small_vectors::string_hash{}("GET"));
+
+int main()
+  {
+  using namespace std::string_view_literals;
+
+  "string_pool_intern"_test = []
+  {
+    small_vectors::string_pool pool;
+    auto const a{pool.intern("alpha"sv)};
+    small_vectors::string const source{"alpha"};
+    auto const b{pool.intern(source)};
+    auto const c{pool.intern("beta"sv)};
+    expect(a == b && a != c);
+    expect(a.data() == b.data() && a.view() == "alpha"sv && std::string_view{a.c_str()} == "alpha"sv);
+    expect(a.hash() == small_vectors::string_hash{}("alpha"sv));
+    expect(pool.size() == 2u);
+    expect(pool.find("beta"sv) == c && !pool.find("gamma"sv).has_value());
+    auto const empty{pool.intern(""sv)};
+    expect(empty.empty() && empty.view().empty() && pool.size() == 3u);
+    expect(interned_string{}.empty() && interned_string{}.view().empty());
+  };
+
+  "string_pool_many"_test = []
+  {
+    small_vectors::string_pool pool;
+    std::vector<interned_string> handles;
+    for(int ix{}; ix != 20000; ++ix)
+      handles.push_back(pool.intern(std::to_string(ix)));
+    // large strings use dedicated chunks
+    std::string const large(100000u, 'x');
+    auto const large_handle{pool.intern(large)};
+    expect(pool.size() == 20001u && large_handle.view() == large);
+    bool all_equal{true};
+    for(int ix{}; ix != 20000; ++ix)
+      {
+      auto const text{std::to_string(ix)};
+      all_equal = all_equal && pool.intern(text) == handles[static_cast<std::size_t>(ix)]
+                  && handles[static_cast<std::size_t>(ix)].view() == text;
+      }
+    expect(all_equal && pool.size() == 20001u);
+
+    std::unordered_map<interned_string, int> by_handle;
+    by_handle[handles[7u]] = 7;
+    expect(by_handle.at(pool.intern("7"sv)) == 7);
+  };
+
+  "string_pool_seeded"_test = []
+  {
+    small_vectors::string_pool pool{interned<"GET">, interned<"POST">, interned<"a key longer than usual">};
+    expect(pool.size() == 3u);
+    expect(pool.intern("GET"sv) == interned<"GET">);
+    expect(pool.intern(std::string{"POST"}) == interned<"POST">);
+    expect(pool.find("a key longer than usual"sv) == interned<"a key longer than usual">);
+    expect(pool.intern("PUT"sv) != interned<"PUT">);
+    expect(interned<"POST">.view() == "POST"sv && std::string_view{interned<"POST">.c_str()} == "POST"sv);
+    expect(pool.seed(interned<"GET">) == interned<"GET"> && pool.size() == 4u);
+    expect(small_vectors::interned<u8"utf8">.view() == u8"utf8"sv);
+  };
+
+  "string_pool_concurrent"_test = []
+  {
+    small_vectors::concurrent_string_pool pool{interned<"0">};
+    constexpr int thread_count{4};
+    constexpr int key_count{5000};
+    std::vector<std::vector<interned_string>> results(thread_count);
+      {
+      std::vector<std::jthread> threads;
+      for(int t{}; t != thread_count; ++t)
+        threads.emplace_back(
+          [&pool, &results, t]
+          {
+            auto & out{results[static_cast<std::size_t>(t)]};
+            // every thread interns the same keys in different order
+            for(int ix{}; ix != key_count; ++ix)
+              out.push_back(pool.intern(std::to_string((ix * (t + 1)) % key_count)));
+          }
+        );
+      }
+    expect(pool.size() == static_cast<std::size_t>(key_count));
+    expect(pool.intern("0"sv) == interned<"0">);
+    bool all_equal{true};
+    for(int t{}; t != thread_count; ++t)
+      for(int ix{}; ix != key_count; ++ix)
+        {
+        auto const handle{results[static_cast<std::size_t>(t)][static_cast<std::size_t>(ix)]};
+        auto const text{std::to_string((ix * (t + 1)) % key_count)};
+        all_equal = all_equal && handle == pool.find(text) && handle.view() == text;
+        }
+    expect(all_equal);
+  };
+  }
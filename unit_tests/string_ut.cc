@@ -1,4 +1,6 @@
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <small_vectors/basic_fixed_string.h>
 #include <small_vectors/basic_string.h>
 #include <small_vectors/stream/basic_string.h>
@@ -96,6 +98,20 @@ consteval bool verify_basic_string()
     auto s{cast_fixed_string<uchar>("12")};
     tr |= constexpr_test(s[0u] == uchar('1') and s[1u] == uchar('2'));
     }
+    {
+    basic_fixed_string s{"Hello World, hello small vectors"};
+    tr |= constexpr_test(s.find('o') == 4u);
+    tr |= constexpr_test(s.find('o', 5u) == 7u);
+    tr |= constexpr_test(s.find("hello"sv) == 13u);
+    tr |= constexpr_test(s.find("Hello"sv, 1u) == std::string_view::npos);
+    tr |= constexpr_test(s.find_icase("HELLO"sv, 1u) == 13u);
+    tr |= constexpr_test(s.find_icase("WORLD,"sv) == 6u);
+    tr |= constexpr_test(s.find_first_of(",z"sv) == 11u);
+    tr |= constexpr_test(s.find_first_of("xyz"sv) == std::string_view::npos);
+    tr |= constexpr_test(s.contains('W') && !s.contains('X'));
+    tr |= constexpr_test(s.contains("small"sv) && !s.contains("Small"sv));
+    tr |= constexpr_test(s.contains_icase("Small VECTORS"sv) && !s.contains_icase("vectors!"sv));
+    }
   return static_cast<bool>(tr);
   }
 
@@ -1403,6 +1419,168 @@ int main()
     result |= run_constexpr_test<string_type_list>(fn_tmpl);
   };
 
+  "basic_string_find_and_replace_single_pass"_test = [&]
+  {
+    auto fn_tmpl = []<typename string_type>(string_type const *) -> metatests::test_result
+    {
+      using st = string_type;
+      using char_type = typename string_type::char_type;
+        {
+        // growing replacement of many matches
+        st vs{cast_fixed_string<char_type>("a-b-c-d-e-f-g-h-i-j-k-l-m-n-o-p-q-r-s-t-u-v-w-x-y-z")};
+        constexpr auto what{cast_fixed_string<char_type>("-")};
+        constexpr auto with{cast_fixed_string<char_type>("<=>")};
+        constexpr_test(vs.find_and_replace(what, with) == 25u);
+        constexpr auto expected{cast_fixed_string<char_type>(
+          "a<=>b<=>c<=>d<=>e<=>f<=>g<=>h<=>i<=>j<=>k<=>l<=>m<=>n<=>o<=>p<=>q<=>r<=>s<=>t<=>u<=>v<=>w<=>x<=>y<=>z"
+        )};
+        constexpr_test(vs == expected.view());
+        }
+        {
+        // overlapping candidates are matched left to right without overlap
+        st vs{cast_fixed_string<char_type>("aaaaa")};
+        constexpr_test(
+          vs.find_and_replace(cast_fixed_string<char_type>("aa"), cast_fixed_string<char_type>("b")) == 2u
+        );
+        constexpr_test(vs == cast_fixed_string<char_type>("bba").view());
+        constexpr_test(
+          vs.find_and_replace(cast_fixed_string<char_type>("b"), cast_fixed_string<char_type>("aab")) == 2u
+        );
+        constexpr_test(vs == cast_fixed_string<char_type>("aabaaba").view());
+        constexpr_test(vs.find_and_replace(cast_fixed_string<char_type>("x"), cast_fixed_string<char_type>("y")) == 0u);
+        constexpr_test(vs == cast_fixed_string<char_type>("aabaaba").view());
+        constexpr_test(vs.find_and_replace(cast_fixed_string<char_type>("a"), cast_fixed_string<char_type>("")) == 5u);
+        constexpr_test(vs == cast_fixed_string<char_type>("bb").view());
+        constexpr_test(vs.find_and_replace(cast_fixed_string<char_type>("bb"), cast_fixed_string<char_type>("")) == 1u);
+        constexpr_test(vs.empty());
+        }
+        {
+        // multiple patterns, earliest match wins then pattern order, growth and shrink mixed
+        using view_type = typename st::view_type;
+        constexpr auto text{cast_fixed_string<char_type>("Hello {name}, you are {age}. {name}{x}{{}")};
+        st vs{text};
+        constexpr auto name_key{cast_fixed_string<char_type>("{name}")};
+        constexpr auto name_val{cast_fixed_string<char_type>("Alexander the Great")};
+        constexpr auto age_key{cast_fixed_string<char_type>("{age}")};
+        constexpr auto age_val{cast_fixed_string<char_type>("7")};
+        constexpr auto brace_key{cast_fixed_string<char_type>("{")};
+        constexpr auto brace_val{cast_fixed_string<char_type>("(")};
+        auto const count{vs.find_and_replace(
+          {std::pair{view_type{name_key}, view_type{name_val}},
+           std::pair{view_type{age_key}, view_type{age_val}},
+           std::pair{view_type{}, view_type{age_val}},
+           std::pair{view_type{brace_key}, view_type{brace_val}}}
+        )};
+        constexpr_test(count == 6u);
+        constexpr auto expected{
+          cast_fixed_string<char_type>("Hello Alexander the Great, you are 7. Alexander the Great(x}((}")
+        };
+        constexpr_test(vs == expected.view());
+        }
+        {
+        // patterns viewing rewritten string itself
+        st vs{cast_fixed_string<char_type>("ab-ab-ab")};
+        constexpr_test(vs.find_and_replace(vs.view().substr(0u, 2u), vs.view().substr(2u, 4u)) == 3u);
+        constexpr_test(vs == cast_fixed_string<char_type>("-ab---ab---ab-").view());
+        constexpr_test(vs.find_and_replace(vs.view().substr(1u, 2u), vs.view().substr(0u, 1u)) == 3u);
+        constexpr_test(vs == cast_fixed_string<char_type>("-----------").view());
+        st ws{cast_fixed_string<char_type>("xy.yx")};
+        auto const count{ws.find_and_replace(
+          {std::pair{ws.view().substr(0u, 1u), ws.view().substr(1u, 1u)},
+           std::pair{ws.view().substr(1u, 1u), ws.view().substr(2u, 3u)}}
+        )};
+        constexpr_test(count == 4u);
+        constexpr_test(ws == cast_fixed_string<char_type>("y.yx..yxy").view());
+        }
+      return {};
+    };
+    result |= run_consteval_test<string_type_list>(fn_tmpl);
+    result |= run_constexpr_test<string_type_list>(fn_tmpl);
+  };
+
+  "basic_string_simd_search"_test = []
+  {
+    // compares vectorized search against std::basic_string_view for all alignments and vector tails
+    auto check = []<typename char_type>(char_type const *) -> bool
+    {
+      using view_type = std::basic_string_view<char_type>;
+      uint64_t seed{0x5eedu};
+      auto next = [&seed](uint32_t modulo) -> uint32_t
+      {
+        seed ^= seed << 13u;
+        seed ^= seed >> 7u;
+        seed ^= seed << 17u;
+        return static_cast<uint32_t>(seed % modulo);
+      };
+      // npos of view and of string differ in width
+      auto same = [](std::size_t expected, auto result) noexcept -> bool
+      { return static_cast<decltype(result)>(expected) == result; };
+      bool all_equal{true};
+      for(uint32_t length{}; length != 140u; ++length)
+        {
+        small_vectors::basic_string<char_type> text;
+        // mix of few letters in both cases and high bytes to exercise case folding and signed compares
+        for(uint32_t ix{}; ix != length; ++ix)
+          {
+          constexpr std::array<char_type, 8> alphabet{
+            char_type('a'), char_type('b'), char_type('A'), char_type('B'), char_type('['), char_type('@'),
+            static_cast<char_type>(0xc1u), static_cast<char_type>(0xe1u)
+          };
+          text.push_back(alphabet[next(8u)]);
+          }
+        view_type const tv{text.view()};
+        for(uint32_t trial{}; trial != 20u; ++trial)
+          {
+          small_vectors::basic_string<char_type> needle{tv.substr(next(length + 1u), next(6u))};
+          if(next(2u) == 0u)
+            needle.push_back(char_type('b'));
+          view_type const nv{needle.view()};
+          auto const pos{static_cast<uint32_t>(next(length + 2u))};
+          all_equal = all_equal && same(tv.find(nv, pos), text.find(nv, pos)) && same(tv.find(nv), text.find(nv))
+                      && same(tv.find_first_of(nv, pos), text.find_first_of(nv, pos))
+                      && (nv.empty() || same(tv.find(nv.front(), pos), text.find(nv.front(), pos)));
+
+          // case insensitive reference with explicit folding of both sides
+          auto fold = [](char_type c) noexcept -> char_type
+          { return c >= char_type('A') && c <= char_type('Z') ? static_cast<char_type>(c + 32) : c; };
+          small_vectors::basic_string<char_type> folded_text{tv};
+          std::ranges::transform(folded_text, folded_text.begin(), fold);
+          small_vectors::basic_string<char_type> folded_needle{nv};
+          std::ranges::transform(folded_needle, folded_needle.begin(), fold);
+          auto const expected{folded_text.view().find(folded_needle.view(), pos)};
+          all_equal = all_equal && same(expected, text.find_icase(nv, pos));
+          }
+        }
+      return all_equal;
+    };
+    ut::expect(check(static_cast<char const *>(nullptr)));
+    ut::expect(check(static_cast<char8_t const *>(nullptr)));
+    ut::expect(check(static_cast<char16_t const *>(nullptr)));
+
+    // start past end must not reach vector loop with wrapped bounds
+    using namespace std::string_view_literals;
+    constexpr auto npos{std::string_view::npos};
+    basic_fixed_string const fixed{"Hello World, hello small vectors and some more text"};
+    for(std::size_t pos: {npos, fixed.size() + 1u, npos - 8u})
+      {
+      ut::expect(fixed.find('o', pos) == npos);
+      ut::expect(fixed.find("ll"sv, pos) == npos);
+      ut::expect(fixed.find("o"sv, pos) == npos);
+      ut::expect(fixed.find_icase("LL"sv, pos) == npos);
+      ut::expect(fixed.find_first_of("ox"sv, pos) == npos);
+      }
+    ut::expect(fixed.find(""sv, fixed.size()) == fixed.size());
+    ut::expect(fixed.find(""sv, fixed.size() + 1u) == npos);
+    small_vectors::string const text{fixed.view()};
+    using size_type = small_vectors::string::size_type;
+    for(size_type pos: {small_vectors::string::npos, static_cast<size_type>(text.size() + 1u)})
+      {
+      ut::expect(text.find('o', pos) == small_vectors::string::npos);
+      ut::expect(text.find("ll"sv, pos) == small_vectors::string::npos);
+      ut::expect(text.find_first_of("ox"sv, pos) == small_vectors::string::npos);
+      }
+  };
+
   "basic_string_pop_contains"_test = [&]
   {
     auto fn_tmpl = []<typename string_type>(string_type const *) -> metatests::test_result
@@ -1592,6 +1770,44 @@ int main()
     result |= run_constexpr_test<string_type_list>(fn_tmpl);
   };
 
+  "basic_string_hash_distribution"_test = []
+  {
+    // every prefix length goes through different read path, all prefixes and single byte flips must differ
+    std::array<char, 200> buffer{};
+    std::ranges::fill(buffer, 'x');
+    std::unordered_set<std::size_t> seen;
+    for(std::size_t length{}; length != buffer.size(); ++length)
+      {
+      std::string_view const prefix{buffer.data(), length};
+      seen.insert(small_vectors::string_hash{}(prefix));
+      for(std::size_t ix{}; ix != length; ++ix)
+        {
+        buffer[ix] = 'y';
+        seen.insert(small_vectors::string_hash{}(prefix));
+        buffer[ix] = 'x';
+        }
+      }
+    ut::expect(seen.size() == buffer.size() + buffer.size() * (buffer.size() - 1u) / 2u);
+  };
+
+  "basic_string_transparent_lookup"_test = []
+  {
+    using namespace std::string_view_literals;
+    std::unordered_map<small_vectors::string, int, small_vectors::string_hash, small_vectors::string_equal> map;
+    map.emplace(small_vectors::string{"alpha"}, 1);
+    map.emplace(small_vectors::string{"a somewhat longer key exceeding sixteen bytes"}, 2);
+    ut::expect(map.find("alpha"sv) != map.end());
+    ut::expect(map.find("alpha") != map.end() && map.find("alpha")->second == 1);
+    ut::expect(map.contains("a somewhat longer key exceeding sixteen bytes"));
+    ut::expect(!map.contains("beta"sv));
+    ut::expect(map.find(small_vectors::basic_fixed_string{"alpha"}) != map.end());
+
+    std::unordered_set<small_vectors::basic_fixed_string<char, 3>> fixed{
+      small_vectors::basic_fixed_string{"abc"}, small_vectors::basic_fixed_string{"abd"}
+    };
+    ut::expect(fixed.contains(small_vectors::basic_fixed_string{"abd"}));
+  };
+
   "basic_string_hash"_test = [&]
   {
     auto fn_tmpl = []<typename string_type>(string_type const *) -> metatests::test_result
@@ -1599,13 +1815,22 @@ int main()
       using st = string_type;
       using char_type = typename string_type::char_type;
       constexpr auto text{cast_fixed_string<char_type>("Lorem ipsum dolor sit amet")};
-      constexpr std::hash<std::basic_string_view<char_type>> stl_hash{};
+      constexpr auto long_text{cast_fixed_string<char_type>(
+        "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore"
+      )};
+      // value computed at compile time must match run time hashing
+      constexpr std::size_t text_hash{std::hash<std::remove_cvref_t<decltype(text)>>{}(text)};
+      constexpr std::size_t long_text_hash{small_vectors::basic_string_hash<char_type>{}(long_text.view())};
 
       st str{text};
-      if(std::is_constant_evaluated())
-        constexpr_test(small_vectors::hash(str) != 0u);
-      else
-        constexpr_test(small_vectors::hash(str) == stl_hash(str.view()));
+      constexpr_test(small_vectors::hash(str) == text_hash);
+      constexpr_test(std::hash<st>{}(str) == text_hash);
+      constexpr_test(small_vectors::basic_string_hash<char_type>{}(str) == text_hash);
+      st long_str{long_text};
+      constexpr_test(small_vectors::hash(long_str) == long_text_hash);
+      constexpr_test(long_text_hash != text_hash);
+      str.pop_back();
+      constexpr_test(small_vectors::hash(str) != text_hash);
       return {};
     };
     result |= run_consteval_test<string_type_list>(fn_tmpl);
@@ -0,0 +1,141 @@
+#include <small_vectors/algo/rank_select_bit_vector.h>
+#include <small_vectors/algo/wavelet_tree.h>
+// same gcc can fail building consteval complicated code
+#if defined(__GNUC__) && !defined(__clang__)
+#define DISABLE_CONSTEVAL_TESTING
+#endif
+#include <unit_test_core.h>
+#include <array>
+
+using metatests::constexpr_test;
+using metatests::test_result;
+
+namespace ut = boost::ut;
+using ut::operator""_test;
+using namespace ut::operators::terse;
+using ut::expect;
+namespace succinct = small_vectors::algo::succinct;
+
+namespace
+  {
+constexpr auto next_random(uint64_t & state) noexcept -> uint64_t
+  {
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+  }
+
+constexpr auto make_bits(uint32_t count, uint32_t density_shift, uint64_t seed) -> small_vectors::vector<bool>
+  {
+  small_vectors::vector<bool> bits(count);
+  for(auto & bit: bits)
+    bit = (next_random(seed) >> (64 - density_shift)) == 0u;
+  return bits;
+  }
+
+constexpr auto verify_rank_select(small_vectors::vector<bool> const & bits) -> bool
+  {
+  succinct::rank_select_bit_vector const bv{bits};
+  if(bv.size() != bits.size())
+    return false;
+  uint32_t ones{};
+  uint32_t zeros{};
+  for(uint32_t pos{}; pos != bits.size(); ++pos)
+    {
+    if(bv.rank1(pos) != ones || bv.rank0(pos) != zeros || bv[pos] != bits[pos])
+      return false;
+    if(bits[pos])
+      {
+      if(bv.select1(ones) != pos)
+        return false;
+      ++ones;
+      }
+    else
+      {
+      if(bv.select0(zeros) != pos)
+        return false;
+      ++zeros;
+      }
+    }
+  return bv.rank1(bv.size()) == ones && bv.count_ones() == ones && bv.select1(ones) == bv.npos
+         && bv.select0(zeros) == bv.npos;
+  }
+
+constexpr auto small_rank_select_cases() -> bool
+  {
+  return verify_rank_select(make_bits(1100u, 1u, 0x1234'5678u)) && verify_rank_select(make_bits(512u, 2u, 77u))
+         && verify_rank_select({});
+  }
+
+#ifndef DISABLE_CONSTEVAL_TESTING
+static_assert(small_rank_select_cases());
+#endif
+
+constexpr auto small_wavelet_tree_case() -> bool
+  {
+  std::array<uint8_t, 11> const text{'a', 'b', 'r', 'a', 'c', 'a', 'd', 'a', 'b', 'r', 'a'};
+  succinct::wavelet_tree const wt{text};
+  return wt.size() == 11u && wt.access(2u) == 'r' && wt.rank('a', 11u) == 5u && wt.rank('a', 4u) == 2u
+         && wt.select('a', 4u) == 10u && wt.select('c', 0u) == 4u && wt.select('z', 0u) == wt.npos
+         && wt.rank(0x1ffu, 11u) == 0u;
+  }
+
+#ifndef DISABLE_CONSTEVAL_TESTING
+static_assert(small_wavelet_tree_case());
+#endif
+  }  // namespace
+
+int main()
+  {
+  "rank_select_bit_vector"_test = []
+  {
+    for(uint32_t density: {1u, 2u, 5u})
+      for(uint32_t count: {0u, 1u, 63u, 64u, 511u, 512u, 513u, 4096u, 70'000u})
+        expect(verify_rank_select(make_bits(count, density, 0x9e37'79b9'7f4a'7c15u + count)));
+
+    small_vectors::vector<bool> bits(20'000u);
+    expect(verify_rank_select(bits));
+    std::ranges::fill(bits, true);
+    expect(verify_rank_select(bits));
+  };
+
+  "rank_select_bit_vector_words"_test = []
+  {
+    std::array<uint64_t, 3> const words{0xffff'ffff'ffff'ffffu, 0x8000'0000'0000'0001u, 0xffffu};
+    succinct::rank_select_bit_vector const bv{words, 130u};
+    expect(bv.size() == 130u);
+    expect(bv.count_ones() == 68u);
+    expect(bv.select1(64u) == 64u);
+    expect(bv.select1(65u) == 127u);
+    expect(bv.select1(66u) == 128u);
+    expect(bv.select1(68u) == bv.npos);
+    expect(bv.select0(0u) == 65u);
+  };
+
+  "wavelet_tree"_test = []
+  {
+    expect(small_wavelet_tree_case());
+    expect(small_rank_select_cases());
+
+    uint64_t seed{0xdead'beefu};
+    small_vectors::vector<uint16_t> symbols(30'000u);
+    for(auto & s: symbols)
+      s = static_cast<uint16_t>(next_random(seed) % 1000u);
+    succinct::wavelet_tree const wt{symbols};
+    expect(wt.level_count() == 10u);
+
+    std::array<uint32_t, 1000> counts{};
+    bool valid{true};
+    for(uint32_t pos{}; pos != symbols.size(); ++pos)
+      {
+      uint16_t const s{symbols[pos]};
+      valid = valid && wt.access(pos) == s && wt.rank(s, pos) == counts[s] && wt.select(s, counts[s]) == pos;
+      ++counts[s];
+      }
+    expect(valid);
+    for(uint32_t s{}; s != counts.size(); ++s)
+      valid = valid && wt.rank(s, wt.size()) == counts[s] && wt.select(s, counts[s]) == wt.npos;
+    expect(valid);
+  };
+  }
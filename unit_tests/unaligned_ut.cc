@@ -1,7 +1,9 @@
 #include <unit_test_core.h>
 
 #include <small_vectors/utils/unaligned.h>
+#include <array>
 #include <cmath>
+#include <vector>
 
 using traits_list = metatests::type_list<uint8_t, std::byte>;
 using namespace metatests;
@@ -94,6 +96,75 @@ int main()
     result |= run_constexpr_test<traits_list>(fn_tmpl);
     result |= run_consteval_test<traits_list>(fn_tmpl);
   };
+  "test unaligned_load_n"_test = [&]
+  {
+    auto fn_tmpl = []<typename value_type>(value_type const *) -> metatests::test_result
+    {
+      value_type store[128]{};
+      for(unsigned ix{}; ix != 128u; ++ix)
+        store[ix] = static_cast<value_type>(ix);
+      std::array<uint32_t, 5> big;
+      auto next = unaligned_load_n<std::endian::big>(&store[1], big);
+      constexpr_test(next == &store[21]);
+      constexpr_test(big[0] == 0x01020304u && big[4] == 0x11121314u);
+      std::array<uint16_t, 3> little;
+      unaligned_load_n<std::endian::little>(&store[3], little);
+      constexpr_test(little[0] == 0x0403u && little[2] == 0x0807u);
+      std::array<uint64_t, 1> wide;
+      unaligned_load_n<std::endian::big>(&store[8], wide);
+      constexpr_test(wide[0] == 0x08090a0b0c0d0e0full);
+      return {};
+    };
+    result |= run_constexpr_test<traits_list>(fn_tmpl);
+    result |= run_consteval_test<traits_list>(fn_tmpl);
+  };
+
+  "test unaligned_store_n"_test = [&]
+  {
+    auto fn_tmpl = []<typename value_type>(value_type const *) -> metatests::test_result
+    {
+      value_type store[128]{};
+      std::array<int32_t, 2> const values{0x01020304, -2};
+      auto next = unaligned_store_n<std::endian::big>(&store[1], values);
+      constexpr_test(next == &store[9]);
+      constexpr_test(store[1] == value_type{1} && store[4] == value_type{4} && store[8] == value_type{0xfe});
+      std::array<double, 3> const doubles{0.5, -1.25, 1e300};
+      unaligned_store_n<std::endian::big>(&store[11], doubles);
+      std::array<double, 3> loaded{};
+      unaligned_load_n<std::endian::big>(&store[11], loaded);
+      constexpr_test(loaded == doubles);
+      return {};
+    };
+    result |= run_constexpr_test<traits_list>(fn_tmpl);
+    result |= run_consteval_test<traits_list>(fn_tmpl);
+  };
+
+  "test unaligned_n large spans"_test = []
+  {
+    // lengths around register sizes exercise vector body and scalar tail
+    for(std::size_t count: {0u, 1u, 3u, 4u, 7u, 8u, 9u, 15u, 33u, 1000u})
+      {
+      std::vector<uint32_t> values(count);
+      for(std::size_t ix{}; ix != count; ++ix)
+        values[ix] = static_cast<uint32_t>(ix * 0x01010101u + 0x00010203u);
+      std::vector<uint8_t> wire(count * sizeof(uint32_t) + 1u);
+      unaligned_store_n<std::endian::big>(wire.data() + 1, values);
+      bool bytes_ok{true};
+      for(std::size_t ix{}; ix != count; ++ix)
+        bytes_ok = bytes_ok && wire[1u + ix * 4u] == static_cast<uint8_t>(values[ix] >> 24u)
+                   && wire[4u + ix * 4u] == static_cast<uint8_t>(values[ix]);
+      expect(bytes_ok);
+      std::vector<uint32_t> loaded(count);
+      unaligned_load_n<std::endian::big>(wire.data() + 1, loaded);
+      expect(loaded == values);
+      std::vector<uint16_t> halves(count * 2u);
+      unaligned_load_n<std::endian::big>(wire.data() + 1, halves);
+      bool halves_ok{true};
+      for(std::size_t ix{}; ix != count; ++ix)
+        halves_ok = halves_ok && halves[ix * 2u] == static_cast<uint16_t>(values[ix] >> 16u);
+      expect(halves_ok);
+      }
+  };
   }
 
 small_vectors_clang_unsafe_buffer_usage_end  //
@@ -0,0 +1,137 @@
+#include <small_vectors/utils/varint.h>
+#include <small_vectors/small_vector.h>
+#include <small_vectors/static_vector.h>
+#include <unit_test_core.h>
+#include <array>
+#include <limits>
+#include <vector>
+
+namespace ut = boost::ut;
+using ut::expect;
+using ut::operator""_test;
+using namespace ut::operators::terse;
+namespace varint = small_vectors::utils::varint;
+namespace stream_vbyte = small_vectors::utils::stream_vbyte;
+
+static_assert(varint::zigzag_encode(0) == 0u && varint::zigzag_encode(-1) == 1u && varint::zigzag_encode(1) == 2u);
+static_assert(varint::zigzag_encode(std::numeric_limits<int32_t>::min()) == 0xffff'ffffu);
+static_assert(varint::zigzag_decode(varint::zigzag_encode(int64_t{-123456789})) == -123456789);
+static_assert(varint::max_size_v<uint32_t> == 5u && varint::max_size_v<uint64_t> == 10u);
+
+static_assert(
+  []
+  {
+    std::array<uint8_t, 10> buffer{};
+    auto end{varint::encode(300u, buffer.begin())};
+    if(end - buffer.begin() != 2 || buffer[0] != 0xac || buffer[1] != 0x02)
+      return false;
+    auto it{buffer.cbegin()};
+    auto const value{varint::decode_fwd<uint32_t>(it, buffer.cend())};
+    return value.has_value() && *value == 300u && it == buffer.cbegin() + 2;
+  }()
+);
+
+static_assert(
+  []
+  {
+    std::array<uint32_t, 6> const values{0u, 255u, 256u, 70000u, 0x0100'0000u, 0xffff'ffffu};
+    std::array<std::byte, stream_vbyte::max_encoded_size(6u)> buffer{};
+    std::size_t const size{stream_vbyte::encode(values, buffer)};
+    std::array<uint32_t, 6> decoded{};
+    auto const consumed{stream_vbyte::decode(std::span{buffer}.first(size), decoded)};
+    return size == 2u + 1u + 1u + 2u + 3u + 4u + 4u && consumed == size && decoded == values;
+  }()
+);
+
+int main()
+  {
+  "varint_round_trip"_test = []
+  {
+    small_vectors::vector<uint8_t> buffer;
+    std::vector<int64_t> values;
+    for(int shift{}; shift != 63; ++shift)
+      for(int64_t delta: {-1, 0, 1})
+        {
+        values.push_back((int64_t{1} << shift) + delta);
+        values.push_back(-(int64_t{1} << shift) + delta);
+        }
+    values.push_back(std::numeric_limits<int64_t>::min());
+    values.push_back(std::numeric_limits<int64_t>::max());
+    std::size_t expected_size{};
+    for(int64_t value: values)
+      {
+      varint::encode(value, std::back_inserter(buffer));
+      expected_size += varint::encoded_size(value);
+      }
+    expect(buffer.size() == expected_size);
+    auto it{buffer.cbegin()};
+    bool all_equal{true};
+    for(int64_t value: values)
+      {
+      auto const decoded{varint::decode_fwd<int64_t>(it, buffer.cend())};
+      all_equal = all_equal && decoded.has_value() && *decoded == value;
+      }
+    expect(all_equal && it == buffer.cend());
+  };
+
+  "varint_errors"_test = []
+  {
+    std::array<std::byte, 3> const truncated{std::byte{0x80}, std::byte{0x80}, std::byte{0x80}};
+    auto it{truncated.begin()};
+    auto const short_result{varint::decode_fwd<uint32_t>(it, truncated.end())};
+    expect(!short_result.has_value() && short_result.error() == varint::error_e::truncated_input);
+    expect(it == truncated.begin());
+
+    std::array<uint8_t, 10> buffer{};
+    auto const end{varint::encode(uint64_t{1} << 32u, buffer.begin())};
+    auto pos{buffer.cbegin()};
+    auto const overflow{varint::decode_fwd<uint32_t>(pos, end)};
+    expect(!overflow.has_value() && overflow.error() == varint::error_e::overflow);
+    pos = buffer.cbegin();
+    expect(varint::decode_fwd<uint64_t>(pos, end) == uint64_t{1} << 32u);
+    std::array<uint8_t, 2> const small_overflow{0x80, 0x02};
+    auto small_it{small_overflow.begin()};
+    expect(!varint::decode_fwd<uint8_t>(small_it, small_overflow.end()).has_value());
+  };
+
+  "stream_vbyte_round_trip"_test = []
+  {
+    uint64_t state{0x9e37'79b9'7f4a'7c15ull};
+    for(std::size_t count: {0u, 1u, 3u, 4u, 5u, 8u, 9u, 31u, 64u, 1001u, 10000u})
+      {
+      small_vectors::vector<uint32_t> values(static_cast<uint32_t>(count));
+      for(uint32_t & value: values)
+        {
+        state ^= state << 13u;
+        state ^= state >> 7u;
+        state ^= state << 17u;
+        // mix of all lengths
+        value = static_cast<uint32_t>(state) >> (8u * (state >> 62u));
+        }
+      small_vectors::small_vector<std::byte, uint64_t, 0> encoded;
+      stream_vbyte::encode_append(values, encoded);
+      expect(encoded.size() <= stream_vbyte::max_encoded_size(count));
+      small_vectors::vector<uint32_t> decoded;
+      auto const consumed{stream_vbyte::decode_append(encoded, count, decoded)};
+      expect(consumed.has_value() && *consumed == encoded.size());
+      expect(decoded.size() == count && std::ranges::equal(decoded, values));
+      if(count != 0u)
+        {
+        auto const truncated{
+          stream_vbyte::decode_append(std::span<std::byte const>{encoded}.first(encoded.size() - 1u), count, decoded)
+        };
+        expect(!truncated.has_value() && decoded.size() == count);
+        }
+      }
+  };
+
+  "stream_vbyte_static_vector"_test = []
+  {
+    std::array<uint32_t, 5> const values{1u, 1000u, 100000u, 10000000u, 7u};
+    std::array<std::byte, stream_vbyte::max_encoded_size(5u)> buffer;
+    std::size_t const size{stream_vbyte::encode(values, buffer)};
+    small_vectors::static_vector<uint32_t, 8> decoded;
+    auto const consumed{stream_vbyte::decode_append(std::span{buffer}.first(size), values.size(), decoded)};
+    expect(consumed == size && std::ranges::equal(decoded, values));
+  };
+  }